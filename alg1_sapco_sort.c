@@ -1,5 +1,6 @@
 #include "aux.c"
 #include "graph.c"
+#include "coo_graph.c"
 #include "trans.c"
 #include "relabel.c"
 
@@ -19,16 +20,34 @@ int main(int argc, char** args)
 			// Reading the textual graph that does not require omp 
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
-			// Reading a WebGraph using ParaGrapher library
+		{
+			// Reading a WebGraph using ParaGrapher library, directly into /dev/shm if it should be stored there
+			if(LL_STORE_INPUT_GRAPH_IN_SHM)
+				read_flags |= 2U;
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo"))
+			// Reading a SNAP edge list or a Matrix Market file, removing self-edges and duplicate edges
+			graph = get_ll_400_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400"))
+		{
+			// Mapping a graph stored in the binary format, with NUMA-interleaved pages
+			unsigned long properties = 0;
+			read_flags |= 1U;
+			graph = get_ll_400_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			if(properties & LL_GRAPH_PROPERTY_SYMMETRIC)
+				LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
 		assert(graph != NULL);
 		
 	// Initializing omp
 		struct par_env* pe= initialize_omp_par_env();
 
 	// Store graph in shm
-		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 3U<<30) == 0)
 			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+		if(LL_STORE_INPUT_GRAPH_AS_BIN != NULL && (read_flags & 1U<<30) == 0)
+			store_ll_400_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, graph, LL_INPUT_GRAPH_IS_SYMMETRIC ? LL_GRAPH_PROPERTY_SYMMETRIC : 0);
 	
 	// Exec info	
 		unsigned long* exec_info = calloc(sizeof(unsigned long), 20);
@@ -72,6 +91,10 @@ int main(int argc, char** args)
 				if(exec_info)
 					for(unsigned int i=0; i<pe->hw_events_count; i++)
 						fprintf(out, " %-8s;", pe->hw_events_names[i]);
+				#ifdef _ENERGY_MEASUREMENT
+					fprintf(out, " %-10s; %-10s; %-10s;", "PkgEng(J)", "RAMEng(J)", "nJ/Edge");
+				#endif
+				fprintf(out, " %-11s; %-11s;", "PeakMem(MB)", "PeakRSS(MB)");
 				fprintf(out, "\n");
 			}
 
@@ -90,6 +113,11 @@ int main(int argc, char** args)
 			if(exec_info)
 				for(unsigned int i=0; i<pe->hw_events_count; i++)					
 					fprintf(out, " %'8s;", ul2s(exec_info[i + 1], temp1));
+			#ifdef _ENERGY_MEASUREMENT
+				fprintf(out, " %'10.2f; %'10.2f; %'10.3f;", exec_info[18] / 1e6, exec_info[19] / 1e6, 
+					1e3 * (exec_info[18] + exec_info[19]) / csc_graph->edges_count);
+			#endif
+			fprintf(out, " %'11.1f; %'11.1f;", exec_info[16] / 1e6, get_peak_rss() / 1e6);
 			fprintf(out, "\n");
 
 			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
@@ -107,10 +135,7 @@ int main(int argc, char** args)
 		release_numa_interleaved_ll_400_graph(csc_graph);
 		csc_graph = NULL;
 
-		if(read_flags & 1U<<31)
-			release_shm_ll_400_graph(csr_graph);
-		else
-			release_numa_interleaved_ll_400_graph(csr_graph);
+		release_ll_400_graph(csr_graph, read_flags);
 		csr_graph = NULL;
 		graph = NULL;
 
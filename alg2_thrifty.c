@@ -1,7 +1,10 @@
 #include "aux.c"
 #include "graph.c"
+#include "coo_graph.c"
 #include "trans.c"
 #include "cc.c"
+#include "stream.c"
+#include "graph_cache.c"
 
 /*
 	Thrifty Label Propagation Connected Components
@@ -38,19 +41,37 @@ int main(int argc, char** args)
 			// Reading the textual graph that do not require omp 
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
-			// Reading a WebGraph using ParaGrapher library
+		{
+			// Reading a WebGraph using ParaGrapher library, directly into /dev/shm if it should be stored there
+			if(LL_STORE_INPUT_GRAPH_IN_SHM)
+				read_flags |= 2U;
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo"))
+			// Reading a SNAP edge list or a Matrix Market file, removing self-edges and duplicate edges
+			graph = get_ll_400_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400"))
+		{
+			// Mapping a graph stored in the binary format, with NUMA-interleaved pages
+			unsigned long properties = 0;
+			read_flags |= 1U;
+			graph = get_ll_400_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			if(properties & LL_GRAPH_PROPERTY_SYMMETRIC)
+				LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
 		assert(graph != NULL);
 
 	// Initializing omp
 		struct par_env* pe= initialize_omp_par_env();
 
 	// Store graph in shm
-		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 3U<<30) == 0)
 			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+		if(LL_STORE_INPUT_GRAPH_AS_BIN != NULL && (read_flags & 1U<<30) == 0)
+			store_ll_400_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, graph, LL_INPUT_GRAPH_IS_SYMMETRIC ? LL_GRAPH_PROPERTY_SYMMETRIC : 0);
 		
 	// Exec info
-		unsigned long* exec_info = calloc(sizeof(unsigned long), 20);
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 40);
 		assert(exec_info != NULL);
 
 	// Symmetrizing the graph
@@ -58,30 +79,69 @@ int main(int argc, char** args)
 		
 		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
 		{
-			struct ll_400_graph* sym_graph = symmetrize_graph(pe, graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+			// sort neighbour-lists and remove self-edges, reusing the symmetrized graph from LL_GRAPH_CACHE if present
+			unsigned int sym_flags = 0;
+			struct ll_400_graph* sym_graph = symmetrize_graph_cached(pe, graph,  2U + 4U, &sym_flags); 
 
 			// Releasing the input graph
-				if(read_flags & 1U<<31)
-					release_shm_ll_400_graph(graph);
-				else
-					release_numa_interleaved_ll_400_graph(graph);
+				release_ll_400_graph(graph, read_flags);
 				graph = sym_graph;
 				sym_graph = NULL;
+				read_flags = sym_flags;
 		}
 		
 		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
 
+		unsigned long vertices_count = graph->vertices_count;
+		unsigned long edges_count = graph->edges_count;
+
+	// Compressing the graph, the CSR graph is released to keep only the compressed graph in memory
+		struct ll_400_cgraph* cgraph = NULL;
+		if(LL_COMPRESSED_GRAPH)
+		{
+			cgraph = compress_ll_400_graph(pe, graph, 0);
+
+			release_ll_400_graph(graph, read_flags);
+			graph = NULL;
+		}
+
+	// Creating the graph with 4 Bytes offsets
+		struct ll_400_c32_graph* c32_graph = NULL;
+		if(LL_COMPACT_OFFSETS && graph != NULL)
+			c32_graph = copy_ll_400_to_400_c32_graph(pe, graph, NULL);
+
 	// CC
 		unsigned int flags = 1U;  // 1U print stats
 		unsigned int ccs_p = 0;
-		unsigned int* cc_p = cc_pull(pe, graph, flags, exec_info, &ccs_p);
 		unsigned int ccs_t = 0;
-		unsigned int* cc_t = cc_thrifty_400(pe, graph, flags, &exec_info[10], &ccs_t);
+		unsigned int* cc_p = NULL;
+		unsigned int* cc_t = NULL;
+		if(cgraph != NULL)
+		{
+			cc_p = cc_pull_cg(pe, cgraph, flags, exec_info, &ccs_p);
+			cc_t = cc_thrifty_400_cg(pe, cgraph, flags, &exec_info[20], &ccs_t);
+
+			release_numa_interleaved_ll_400_cgraph(cgraph);
+			cgraph = NULL;
+		}
+		else if(c32_graph != NULL)
+		{
+			cc_p = cc_pull(pe, c32_graph, flags | (LL_HUGE_PAGES << 4) | (LL_EDGE_TILES << 7), exec_info, &ccs_p);
+			cc_t = cc_thrifty(pe, c32_graph, flags | (LL_NUMA_PLACEMENT << 2) | (LL_HUGE_PAGES << 4) | (LL_STEAL_ORDER << 6) | (LL_EDGE_TILES << 7), &exec_info[20], &ccs_t);
+
+			release_numa_interleaved_ll_400_c32_graph(c32_graph);
+			c32_graph = NULL;
+		}
+		else
+		{
+			cc_p = cc_pull(pe, graph, flags | (LL_HUGE_PAGES << 4) | (LL_EDGE_TILES << 7), exec_info, &ccs_p);
+			cc_t = cc_thrifty(pe, graph, flags | (LL_NUMA_PLACEMENT << 2) | (LL_HUGE_PAGES << 4) | (LL_STEAL_ORDER << 6) | (LL_EDGE_TILES << 7), &exec_info[20], &ccs_t);
+		}
 		
 	// Validating
 		// (1) If two vertices are on the same componenet (i.e., they have the same cc_p), they should have the same cc_t
 		#pragma omp parallel for
-		for(unsigned v = 0; v < graph->vertices_count; v++)
+		for(unsigned v = 0; v < vertices_count; v++)
 			assert(cc_t[v] == cc_t[cc_p[v]]);
 		
 		/* (2) It is also required to check if two vertices are on different components (i.e., having the same cc_p), 
@@ -98,6 +158,29 @@ int main(int argc, char** args)
 
 		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
 
+	// Streaming CC and degree histogram, overlapped with decompression of the WebGraph (LL_STREAM_VALIDATION)
+		// The graph is decompressed again, so it is a validation of the streaming consumers, not a part of the measurement
+		if(LL_STREAM_VALIDATION && (!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP")))
+		{
+			struct ll_stream_degrees* sd = stream_degrees_initialize();
+			struct ll_stream_cc* scc = stream_cc_initialize();
+			struct ll_stream_consumer* consumers[] = {&sd->consumer, &scc->consumer};
+			stream_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, consumers, 2, 0);
+			stream_degrees_print(sd);
+
+			// The weakly connected components of the input graph are the components of the symmetric graph
+			#pragma omp parallel for
+			for(unsigned v = 0; v < vertices_count; v++)
+				assert(scc->cc[v] == cc_p[v]);
+			assert(scc->ccs == ccs_p);
+			printf("Validation (streaming):\t\033[1;33mCorrect\033[0;37m\n");
+
+			stream_degrees_release(sd);
+			sd = NULL;
+			stream_cc_release(scc);
+			scc = NULL;
+		}
+
 	// Writing to the report
 		if(LL_OUTPUT_REPORT_PATH != NULL)
 		{
@@ -110,6 +193,10 @@ int main(int argc, char** args)
 				if(exec_info)
 					for(unsigned int i=0; i<pe->hw_events_count; i++)
 						fprintf(out, " %-8s;", pe->hw_events_names[i]);
+				#ifdef _ENERGY_MEASUREMENT
+					fprintf(out, " %-10s; %-10s; %-10s;", "PkgEng(J)", "RAMEng(J)", "nJ/Edge");
+				#endif
+				fprintf(out, " %-11s; %-11s;", "PeakMem(MB)", "PeakRSS(MB)");
 				fprintf(out, "\n");
 			}
 
@@ -124,10 +211,15 @@ int main(int argc, char** args)
 				name = strndup(name, strrchr(name, '.') - name);
 			
 			fprintf(out, "%-20s; %'8s; %'8s; %'13.1f;", 
-				name, ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), exec_info[0] / 1e6);
+				name, ul2s(vertices_count, temp1), ul2s(edges_count, temp2), exec_info[0] / 1e6);
 			if(exec_info)
 				for(unsigned int i=0; i<pe->hw_events_count; i++)					
 					fprintf(out, " %'8s;", ul2s(exec_info[i + 1], temp1));
+			#ifdef _ENERGY_MEASUREMENT
+				fprintf(out, " %'10.2f; %'10.2f; %'10.3f;", exec_info[18] / 1e6, exec_info[19] / 1e6, 
+					1e3 * (exec_info[18] + exec_info[19]) / edges_count);
+			#endif
+			fprintf(out, " %'11.1f; %'11.1f;", exec_info[16] / 1e6, get_peak_rss() / 1e6);
 			fprintf(out, "\n");
 
 			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
@@ -139,20 +231,13 @@ int main(int argc, char** args)
 		}
 
 	// Releasing memory
-		cc_release(graph, cc_t);
+		numa_free(cc_t, sizeof(unsigned int) * vertices_count);
 		cc_t = NULL;
-		cc_release(graph, cc_p);
+		numa_free(cc_p, sizeof(unsigned int) * vertices_count);
 		cc_p = NULL;
 		
-		if(LL_INPUT_GRAPH_IS_SYMMETRIC)
-		{
-			if(read_flags & 1U<<31)
-				release_shm_ll_400_graph(graph);
-			else
-				release_numa_interleaved_ll_400_graph(graph);
-		}
-		else
-			release_numa_interleaved_ll_400_graph(graph);
+		if(graph != NULL)
+			release_ll_400_graph(graph, read_flags);
 		graph = NULL;
 
 	printf("\n\n");
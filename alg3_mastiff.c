@@ -1,7 +1,9 @@
 #include "aux.c"
 #include "graph.c"
+#include "coo_graph.c"
 #include "trans.c"
 #include "msf.c"
+#include "graph_cache.c"
 
 /*
 	
@@ -37,85 +39,161 @@ int main(int argc, char** args)
 		struct ll_400_graph* csr_graph = NULL;
 		struct ll_400_graph* sym_graph = NULL;
 		struct ll_404_graph* wgraph = NULL;
+		struct ll_404_soa_graph* swgraph = NULL;
 		int read_flags = 0;
+		unsigned int sym_flags = 0;
+		unsigned int w_flags = 0;
 		
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
 			// Reading the textual graph that do not require omp 
 			csr_graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
-			// Reading a WebGraph using ParaGrapher library
+		{
+			// Reading a WebGraph using ParaGrapher library, directly into /dev/shm if it should be stored there
+			if(LL_STORE_INPUT_GRAPH_IN_SHM)
+				read_flags |= 2U;
 			csr_graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		}
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_404_AP"))	
-			wgraph = get_ll_404_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
-		assert(csr_graph != NULL || wgraph != NULL);
+		{
+			if(LL_WEIGHTED_GRAPH_SOA)
+				// Reading the WebGraph directly in the structure-of-arrays layout (without /dev/shm)
+				swgraph = get_ll_404_soa_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+			else
+			{
+				if(LL_STORE_INPUT_GRAPH_IN_SHM)
+					read_flags |= 2U;
+				wgraph = get_ll_404_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+			}
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text_404"))
+			// Reading a weighted textual graph
+			wgraph = get_ll_404_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo"))
+			// Reading a SNAP edge list or a Matrix Market file, removing self-edges and duplicate edges
+			csr_graph = get_ll_400_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo_404"))
+		{
+			// Reading a weighted SNAP edge list or Matrix Market file, symmetrized as MASTIFF requires
+			wgraph = get_ll_404_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U + 8U, &read_flags);
+			LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400") || !strcmp(LL_INPUT_GRAPH_TYPE,"binary_404"))
+		{
+			// Mapping a graph stored in the binary format, with NUMA-interleaved pages
+			unsigned long properties = 0;
+			read_flags |= 1U;
+			if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400"))
+				csr_graph = get_ll_400_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			else
+				wgraph = get_ll_404_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			if(properties & LL_GRAPH_PROPERTY_SYMMETRIC)
+				LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
+		assert(csr_graph != NULL || wgraph != NULL || swgraph != NULL);
 		
 	// Initializing omp
 		struct par_env* pe= initialize_omp_par_env();
 
 	// Store input graph in shm
-		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 3U<<30) == 0)
 		{
 			if(csr_graph != NULL)
 				store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 0);
-			else
+			else if(wgraph != NULL)
 				store_shm_ll_404_graph(pe, LL_INPUT_GRAPH_PATH, wgraph, 0);
 		}
+
+	// Store input graph in the binary format
+		if(LL_STORE_INPUT_GRAPH_AS_BIN != NULL && (read_flags & 1U<<30) == 0)
+		{
+			unsigned long properties = LL_INPUT_GRAPH_IS_SYMMETRIC ? LL_GRAPH_PROPERTY_SYMMETRIC : 0;
+			if(csr_graph != NULL)
+				store_ll_400_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, csr_graph, properties);
+			else if(wgraph != NULL)
+				store_ll_404_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, wgraph, properties);
+		}
 		
 	// Initializing exec info
 		unsigned long* exec_info = calloc(sizeof(unsigned long), 20);
 		assert(exec_info != NULL);
 
 	// Symmetrizing and adding weights to the graph if it is not weighted
-		if(wgraph == NULL)
+		if(wgraph == NULL && swgraph == NULL)
 		{
 			printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csr_graph->vertices_count,csr_graph->edges_count);
 			
 			if(LL_INPUT_GRAPH_IS_SYMMETRIC == 0)
 			{
-				sym_graph = symmetrize_graph(pe, csr_graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+				// sort neighbour-lists and remove self-edges, reusing the symmetrized graph from LL_GRAPH_CACHE if present
+				sym_graph = symmetrize_graph_cached(pe, csr_graph,  2U + 4U, &sym_flags);
 				printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,sym_graph->vertices_count,sym_graph->edges_count);
 
-				if(read_flags & 1U<<31)
-					release_shm_ll_400_graph(csr_graph);
-				else
-					release_numa_interleaved_ll_400_graph(csr_graph);
+				release_ll_400_graph(csr_graph, read_flags);
 			}
 			else
+			{
 				sym_graph = csr_graph;
+				sym_flags = read_flags;
+			}
 
 			csr_graph = NULL;
 
-			wgraph = add_4B_weight_to_ll_400_graph(pe, sym_graph, 1024*100, 0); // 1U: validate
-			printf("Weighted: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,wgraph->vertices_count,wgraph->edges_count);
+			if(LL_WEIGHTED_GRAPH_SOA)
+				swgraph = add_4B_weight_to_ll_400_graph_soa(pe, sym_graph, 1024*100, 0); // 1U: validate
+			else
+				wgraph = add_4B_weight_to_ll_400_graph_cached(pe, sym_graph, 1024*100, 0, &w_flags); // 1U: validate
+			printf("Weighted: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,sym_graph->vertices_count,sym_graph->edges_count);
 		}
 		else
 		{
+			w_flags = read_flags;
 			if(LL_INPUT_GRAPH_IS_SYMMETRIC == 0)
 			{
 				printf("To do: symmetrizing weighted graphs ... \n");
 				exit(-1);
 			}
 
+			// Converting the layout
+			if(LL_WEIGHTED_GRAPH_SOA && swgraph == NULL)
+			{
+				swgraph = copy_ll_404_to_404_soa_graph(pe, wgraph, NULL);
+				release_ll_404_graph(wgraph, read_flags);
+				wgraph = NULL;
+			}
+
 			// Is needed for validation, `msf_validate()`. Can be skipped.
 			#ifndef NDEBUG 
-				sym_graph = copy_ll_404_to_400_graph(pe, wgraph, NULL);
+				if(swgraph != NULL)
+					sym_graph = copy_ll_404_soa_to_400_graph(pe, swgraph, NULL);
+				else
+					sym_graph = copy_ll_404_to_400_graph(pe, wgraph, NULL);
 				assert(sym_graph != NULL);
 			#endif
 		}
+		unsigned long vertices_count = swgraph != NULL ? swgraph->vertices_count : wgraph->vertices_count;
+		unsigned long edges_count = swgraph != NULL ? swgraph->edges_count : wgraph->edges_count;
 
 	// Running MSF
 		// MASTIFF
 		struct msf* res_mastiff = NULL;
 		
-		res_mastiff = msf_mastiff(pe, wgraph, exec_info, 1U);
+		if(swgraph != NULL)
+			res_mastiff = msf_mastiff_soa(pe, swgraph, exec_info, 1U);
+		else
+			res_mastiff = msf_mastiff(pe, wgraph, exec_info, 1U);
 
 		assert(1 == msf_validate(pe, sym_graph, res_mastiff, 0));
 		
 		struct msf* res_prim = NULL;
-		if(wgraph->vertices_count < 1024)
+		if(vertices_count < 1024)
 		{
 			// the implementation of prim changes the topology
-			struct ll_404_graph* cwg = copy_ll_404_graph(pe, wgraph, NULL); 
+			struct ll_404_graph* cwg = NULL;
+			if(swgraph != NULL)
+				cwg = copy_ll_404_soa_to_404_graph(pe, swgraph, NULL);
+			else
+				cwg = copy_ll_404_graph(pe, wgraph, NULL); 
 			
 			res_prim = msf_prim_serial(pe, cwg, 0);
 
@@ -140,6 +218,10 @@ int main(int argc, char** args)
 				if(exec_info)
 					for(unsigned int i=0; i<pe->hw_events_count; i++)
 						fprintf(out, " %-8s;", pe->hw_events_names[i]);
+				#ifdef _ENERGY_MEASUREMENT
+					fprintf(out, " %-10s; %-10s; %-10s;", "PkgEng(J)", "RAMEng(J)", "nJ/Edge");
+				#endif
+				fprintf(out, " %-11s; %-11s;", "PeakMem(MB)", "PeakRSS(MB)");
 				fprintf(out, "\n");
 			}
 
@@ -154,10 +236,15 @@ int main(int argc, char** args)
 				name = strndup(name, strrchr(name, '.') - name);
 			
 			fprintf(out, "%-20s; %'8s; %'8s; %'13.1f;", 
-				name, ul2s(wgraph->vertices_count, temp1), ul2s(wgraph->edges_count, temp2), exec_info[0] / 1e6);
+				name, ul2s(vertices_count, temp1), ul2s(edges_count, temp2), exec_info[0] / 1e6);
 			if(exec_info)
 				for(unsigned int i=0; i<pe->hw_events_count; i++)					
 					fprintf(out, " %'8s;", ul2s(exec_info[i + 1], temp1));
+			#ifdef _ENERGY_MEASUREMENT
+				fprintf(out, " %'10.2f; %'10.2f; %'10.3f;", exec_info[18] / 1e6, exec_info[19] / 1e6, 
+					1e3 * (exec_info[18] + exec_info[19]) / edges_count);
+			#endif
+			fprintf(out, " %'11.1f; %'11.1f;", exec_info[16] / 1e6, get_peak_rss() / 1e6);
 			fprintf(out, "\n");
 
 			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
@@ -182,20 +269,17 @@ int main(int argc, char** args)
 
 		if(sym_graph != NULL)
 		{
-			if(
-				(strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") == 0 || strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP") == 0) 
-				&& LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31) == 1
-			)
-				release_shm_ll_400_graph(sym_graph);
-			else
-				release_numa_interleaved_ll_400_graph(sym_graph);
+			release_ll_400_graph(sym_graph, sym_flags);
 			sym_graph = NULL;
 		}
 
-		if(strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_404_AP") == 0 && (read_flags & 1U<<31) == 1)
-			release_shm_ll_404_graph(wgraph);
+		if(swgraph != NULL)
+		{
+			release_numa_interleaved_ll_404_soa_graph(swgraph);
+			swgraph = NULL;
+		}
 		else
-			release_numa_interleaved_ll_404_graph(wgraph);
+			release_ll_404_graph(wgraph, w_flags);
 			
 		wgraph = NULL;
 
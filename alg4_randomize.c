@@ -1,5 +1,6 @@
 #include "aux.c"
 #include "graph.c"
+#include "coo_graph.c"
 #include "trans.c"
 #include "relabel.c"
 
@@ -205,8 +206,24 @@ int main(int argc, char** args)
 			// Reading the textual graph that does not require omp 
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
-			// Reading a WebGraph using ParaGrapher library
+		{
+			// Reading a WebGraph using ParaGrapher library, directly into /dev/shm if it should be stored there
+			if(LL_STORE_INPUT_GRAPH_IN_SHM)
+				read_flags |= 2U;
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo"))
+			// Reading a SNAP edge list or a Matrix Market file, removing self-edges and duplicate edges
+			graph = get_ll_400_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400"))
+		{
+			// Mapping a graph stored in the binary format, with NUMA-interleaved pages
+			unsigned long properties = 0;
+			read_flags |= 1U;
+			graph = get_ll_400_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			if(properties & LL_GRAPH_PROPERTY_SYMMETRIC)
+				LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
 		assert(graph != NULL);
 		load_time += get_nano_time();
 		
@@ -214,8 +231,10 @@ int main(int argc, char** args)
 		pe = initialize_omp_par_env();
 
 	// Store graph in shm
-		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 3U<<30) == 0)
 			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+		if(LL_STORE_INPUT_GRAPH_AS_BIN != NULL && (read_flags & 1U<<30) == 0)
+			store_ll_400_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, graph, LL_INPUT_GRAPH_IS_SYMMETRIC ? LL_GRAPH_PROPERTY_SYMMETRIC : 0);
 	
 		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,graph->vertices_count,graph->edges_count);
 
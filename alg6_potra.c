@@ -1,5 +1,6 @@
 #include "aux.c"
 #include "graph.c"
+#include "coo_graph.c"
 #include "trans.c"
 
 int main(int argc, char** args)
@@ -29,8 +30,24 @@ int main(int argc, char** args)
 			// Reading the textual graph that does not require omp 
 			csr_graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
-			// Reading a WebGraph using ParaGrapher library
+		{
+			// Reading a WebGraph using ParaGrapher library, directly into /dev/shm if it should be stored there
+			if(LL_STORE_INPUT_GRAPH_IN_SHM)
+				read_flags |= 2U;
 			csr_graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		}
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"coo"))
+			// Reading a SNAP edge list or a Matrix Market file, removing self-edges and duplicate edges
+			csr_graph = get_ll_400_coo_graph(LL_INPUT_GRAPH_PATH, 1U + 2U, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"binary_400"))
+		{
+			// Mapping a graph stored in the binary format, with NUMA-interleaved pages
+			unsigned long properties = 0;
+			read_flags |= 1U;
+			csr_graph = get_ll_400_bin_graph(LL_INPUT_GRAPH_PATH, &read_flags, &properties);
+			if(properties & LL_GRAPH_PROPERTY_SYMMETRIC)
+				LL_INPUT_GRAPH_IS_SYMMETRIC = 1;
+		}
 		assert(csr_graph != NULL);
 		load_time += get_nano_time();
 
@@ -43,9 +60,11 @@ int main(int argc, char** args)
 		struct par_env* pe = initialize_omp_par_env();
 
 	// Store graph in shm
-		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 3U<<30) == 0)
 			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 0);
-		if(read_flags & (1U << 31))
+		if(LL_STORE_INPUT_GRAPH_AS_BIN != NULL && (read_flags & 1U<<30) == 0)
+			store_ll_400_bin_graph(pe, LL_STORE_INPUT_GRAPH_AS_BIN, csr_graph, LL_INPUT_GRAPH_IS_SYMMETRIC ? LL_GRAPH_PROPERTY_SYMMETRIC : 0);
+		if(read_flags & (3U << 30))
 		{
 			unsigned long mt = - get_nano_time();
 			struct ll_400_graph* temp = copy_ll_400_graph(pe, csr_graph, NULL);
@@ -109,8 +128,27 @@ int main(int argc, char** args)
 			unsigned int flags = 0;
 			if(graph->edges_count < 3e9)
 				flags |= 3U; // 1U: Validation + 2U: Sort
+			flags |= LL_NUMA_PLACEMENT << 6;
+			flags |= LL_HUGE_PAGES << 8;
+			flags |= LL_STEAL_ORDER << 10;
 
-			struct ll_400_graph* out_graph = potra(pe, graph, flags, exec_info + 40 * m);
+			struct ll_400_graph* out_graph = NULL;
+			struct ll_400_c32_graph* c32_graph = NULL;
+			if(LL_COMPACT_OFFSETS)
+				c32_graph = copy_ll_400_to_400_c32_graph(pe, graph, NULL);
+			if(c32_graph != NULL)
+			{
+				// Transposing with 4 Bytes offsets and converting the result back for the next modes
+				struct ll_400_c32_graph* c32_out_graph = potra(pe, c32_graph, flags, exec_info + 40 * m);
+				out_graph = copy_ll_400_c32_to_400_graph(pe, c32_out_graph, NULL);
+
+				release_numa_interleaved_ll_400_c32_graph(c32_out_graph);
+				c32_out_graph = NULL;
+				release_numa_interleaved_ll_400_c32_graph(c32_graph);
+				c32_graph = NULL;
+			}
+			else
+				out_graph = potra(pe, graph, flags, exec_info + 40 * m);
 			
 		// Releasing mem
 			if(m == 0)
@@ -170,6 +208,7 @@ int main(int argc, char** args)
 			fprintf(out, "%-10s; ","RAMEng(kJ)");
 			fprintf(out, "%-10s; ","Avg Dif(M)");
 			fprintf(out, "%-10s; ","AD/k|V|");
+			fprintf(out, "%-11s; ","PeakMem(MB)");
 			fprintf(out, "\n");
 		}
 
@@ -208,10 +247,11 @@ int main(int argc, char** args)
 			fprintf(out, "%'20.2f; ", ei[37]/1e9);
 			fprintf(out, "%8d; ", (int)ei[38]);
 			fprintf(out, "%'8.1f; ", load_time / 1e9);
-			fprintf(out, "%'10.1f; ", ei[18]/1e3);
-			fprintf(out, "%'10.1f; ", ei[19]/1e3);
+			fprintf(out, "%'10.1f; ", ei[18]/1e9);
+			fprintf(out, "%'10.1f; ", ei[19]/1e9);
 			fprintf(out, "%'10.1f; ", ei[28]/1e6);
 			fprintf(out, "%'10.3f; ", 1000.0 * ei[28]/csr_vertices_count);
+			fprintf(out, "%'11.1f; ", ei[16]/1e6);
 			
 			fprintf(out, "\n");
 		}
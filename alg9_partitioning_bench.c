@@ -0,0 +1,61 @@
+#include "aux.c"
+#include "graph.c"
+#include "benchmarks/partitioning_bench.c"
+
+int main(int argc, char** args)
+{	
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+
+		struct par_env* pe = initialize_omp_par_env();
+		
+	// Measuring claims
+		double res[20] = {0.0};
+		char* names [] = {"previous (CAS)", "current (fetch_add)"};
+		unsigned int works [] = {0, 200};
+		unsigned int partitions_per_thread = 256;
+		unsigned int rounds = 100;
+
+		for(int w = 0; w < sizeof(works)/sizeof(unsigned int); w++)
+			for(int k = 0; k < sizeof(names)/sizeof(char*); k++)
+			{
+				printf("-------------------------------------------------------------------\n");
+				printf("\033[1;33m%s\033[0;37m, work: %u\n\n", names[k], works[w]);
+
+				int ret = test_dynamic_partitioning(pe, k + 1, partitions_per_thread, works[w], rounds, res + 10 * w + 5 * k);
+				assert(ret == 0);
+				printf("----------------------------------------\n");
+			}
+		printf("\n\n\n\n");
+
+	// Printing results
+		printf("Dispenser           ; Work; Claims (M/s); P50 (ns); P99 (ns); P99.9 (ns); Max (ns);\n");
+		for(int w = 0; w < sizeof(works)/sizeof(unsigned int); w++)
+			for(int k = 0; k < sizeof(names)/sizeof(char*); k++)
+			{
+				double* r = res + 10 * w + 5 * k;
+				printf("%-20s; %4u; %'12.2f; %'8.0f; %'8.0f; %'10.0f; %'8.0f;\n", names[k], works[w], r[0], r[1], r[2], r[3], r[4]);
+			}
+
+	// Measuring the overhead of steps
+		double step_res[2] = {0.0};
+		char* step_names [] = {"parallel region per step", "persistent workers"};
+		for(int k = 0; k < 2; k++)
+		{
+			printf("-------------------------------------------------------------------\n");
+			printf("\033[1;33m%s\033[0;37m\n\n", step_names[k]);
+
+			int ret = test_phase_overhead(pe, k + 1, 4, 10000, step_res + k);
+			assert(ret == 0);
+			printf("----------------------------------------\n");
+		}
+		printf("\n\n");
+		printf("Steps                     ; Time per step (us);\n");
+		for(int k = 0; k < 2; k++)
+			printf("%-26s; %'18.2f;\n", step_names[k], step_res[k] / 1e3);
+
+	return 0;
+}
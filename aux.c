@@ -49,8 +49,29 @@ char LL_INPUT_GRAPH_BASE_NAME [256] = {0};
 unsigned int LL_INPUT_GRAPH_BATCH_ORDER = 0;
 unsigned int LL_INPUT_GRAPH_IS_SYMMETRIC = 0;
 unsigned int LL_STORE_INPUT_GRAPH_IN_SHM = 0;
+char* LL_STORE_INPUT_GRAPH_AS_BIN = NULL;
 char* LL_OUTPUT_REPORT_PATH = NULL;
+char* LL_TRACE_PATH = NULL;    // the trace file of steps (trace.c)
+char* LL_TRACE_FORMAT = NULL;  // json (default), csv, or chrome
 char* LL_GRAPH_RA_BIN_FOLDER = "data/RA_bin_arrays";
+unsigned int LL_NUMA_PLACEMENT = 0;  // 0: interleave, 1: owner-local, 2: hybrid (LL_NUMA_* in omp.c)
+unsigned int LL_HUGE_PAGES = 0;      // 0: 4KB, 1: THP, 2: 2MB, 3: 1GB (LL_HUGE_PAGES_* in omp.c)
+unsigned int LL_STEAL_ORDER = 0;     // 0: numa, 1: hierarchical (LL_STEAL_ORDER_* in omp.c)
+unsigned int LL_PARTITIONS_PLANNER = 0;  // 0: fixed partitions per thread, 1: partitions_plan_decide() in partitioning.c
+unsigned int LL_RUNTIME_SPINS = 1U << 14;  // spins before parking in par_runtime_barrier() in runtime.c, -1: never parks
+unsigned int LL_STEP_HW_EVENTS = 0;  // 1: reading the hw events of threads in each step (step_hw_events_collect() in omp.c)
+unsigned int LL_MEM_TRACKER = 0;     // 1: printing the memory high-water mark of each step and the tags at exit (mem_tracker.c)
+char* LL_HW_EVENTS_BACKEND = NULL;   // papi (default if built with PAPI) or perf (perf_events.c)
+unsigned int LL_PARTITIONS_CACHE = 1;  // 1: reusing the partitions of a graph (partitions_cache_get() in partitioning.c)
+unsigned int LL_EDGE_TILES = 0;      // 0: vertex partitions, 1: edge tiles splitting hubs (parallel_edge_tiling() in partitioning.tpl.c)
+unsigned int LL_IO_QUEUE_DEPTH = 32; // inflight reads of par_read_file() in omp.c, 0: blocking reads
+unsigned int LL_WEIGHTED_GRAPH_SOA = 0;  // 0: ll_404_graph, 1: ll_404_soa_graph
+unsigned int LL_COMPACT_OFFSETS = 0;     // 1: 4 Bytes offsets (ll_400_c32_graph) for graphs with |E| < 2^32
+unsigned int LL_COMPRESSED_GRAPH = 0;    // 1: alg2_thrifty processes the compressed graph (ll_400_cgraph in compressed_graph.c)
+unsigned int LL_STREAM_VALIDATION = 0;   // 1: alg2_thrifty validates the streaming consumers (stream.c) on WebGraphs
+unsigned int LL_GRAPH_CACHE = 0;         // cache of derived graphs (graph_cache.c), bit 0: /dev/shm, bit 1: disk
+char* LL_GRAPH_CACHE_FOLDER = "data/graph_cache";
+unsigned long LL_GRAPH_CACHE_BUDGET_GB = 64;  // per store
 
 void read_env_vars()
 {
@@ -67,7 +88,7 @@ void read_env_vars()
 		temp = calloc(len + 64, 1);
 		assert(temp != NULL);
 
-		if(strcmp(LL_INPUT_GRAPH_TYPE, "text") == 0)
+		if(strcmp(LL_INPUT_GRAPH_TYPE, "text") == 0 || strcmp(LL_INPUT_GRAPH_TYPE, "text_404") == 0)
 		{
 			sprintf(temp, "%s", LL_INPUT_GRAPH_PATH);
 			char* bn = basename(temp);
@@ -75,6 +96,15 @@ void read_env_vars()
 			bn_len = min(bn_len - strlen(".txt"), 256);
 			sprintf(LL_INPUT_GRAPH_BASE_NAME, "%.*s", bn_len, bn);
 		}
+		else if(strcmp(LL_INPUT_GRAPH_TYPE, "binary_400") == 0 || strcmp(LL_INPUT_GRAPH_TYPE, "binary_404") == 0)
+		{
+			sprintf(temp, "%s", LL_INPUT_GRAPH_PATH);
+			char* bn = basename(temp);
+			int bn_len = strlen(bn);
+			if(bn_len > strlen(".llg") && strcmp(bn + bn_len - strlen(".llg"), ".llg") == 0)
+				bn_len -= strlen(".llg");
+			sprintf(LL_INPUT_GRAPH_BASE_NAME, "%.*s", min(bn_len, 256), bn);
+		}
 		else if( strcmp(LL_INPUT_GRAPH_TYPE, "PARAGRAPHER_CSX_WG_400_AP") == 0 ||
 			strcmp(LL_INPUT_GRAPH_TYPE, "PARAGRAPHER_CSX_WG_404_AP") == 0 ||
 		 	strcmp(LL_INPUT_GRAPH_TYPE, "PARAGRAPHER_CSX_WG_800_AP") == 0
@@ -103,14 +133,139 @@ void read_env_vars()
 	if(temp != NULL && strcmp(temp, "1") == 0)
 		LL_STORE_INPUT_GRAPH_IN_SHM = 1;
 
+	temp = getenv("LL_STORE_INPUT_GRAPH_AS_BIN");
+	if(temp != NULL && strlen(temp) > 0)
+		LL_STORE_INPUT_GRAPH_AS_BIN = strdup(temp);
+
 	temp = getenv("LL_OUTPUT_REPORT_PATH");
 	if(temp != NULL && strlen(temp) > 0)
 		LL_OUTPUT_REPORT_PATH = strdup(temp);
 
+	temp = getenv("LL_TRACE_PATH");
+	if(temp != NULL && strlen(temp) > 0)
+		LL_TRACE_PATH = strdup(temp);
+
+	temp = getenv("LL_TRACE_FORMAT");
+	if(temp != NULL && strlen(temp) > 0)
+	{
+		if(strcmp(temp, "json") == 0 || strcmp(temp, "csv") == 0 || strcmp(temp, "chrome") == 0)
+			LL_TRACE_FORMAT = strdup(temp);
+		else
+			printf("Unknown LL_TRACE_FORMAT: %s, using json.\n", temp);
+	}
+
 	temp = getenv("LL_GRAPH_RA_BIN_FOLDER");
 	if(temp != NULL)
 		LL_GRAPH_RA_BIN_FOLDER = strdup(temp);
 
+	temp = getenv("LL_NUMA_PLACEMENT");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "owner-local") == 0)
+			LL_NUMA_PLACEMENT = 1;
+		else if(strcmp(temp, "hybrid") == 0)
+			LL_NUMA_PLACEMENT = 2;
+		else if(strlen(temp) > 0 && strcmp(temp, "interleave") != 0)
+			printf("Unknown LL_NUMA_PLACEMENT: %s, using interleave.\n", temp);
+	}
+
+	temp = getenv("LL_HUGE_PAGES");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "thp") == 0)
+			LL_HUGE_PAGES = 1;
+		else if(strcmp(temp, "2m") == 0)
+			LL_HUGE_PAGES = 2;
+		else if(strcmp(temp, "1g") == 0)
+			LL_HUGE_PAGES = 3;
+		else if(strlen(temp) > 0 && strcmp(temp, "none") != 0)
+			printf("Unknown LL_HUGE_PAGES: %s, using 4KB pages.\n", temp);
+	}
+
+	temp = getenv("LL_STEAL_ORDER");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "hierarchical") == 0)
+			LL_STEAL_ORDER = 1;
+		else if(strlen(temp) > 0 && strcmp(temp, "numa") != 0)
+			printf("Unknown LL_STEAL_ORDER: %s, using numa.\n", temp);
+	}
+
+	temp = getenv("LL_PARTITIONS_PLANNER");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "auto") == 0)
+			LL_PARTITIONS_PLANNER = 1;
+		else if(strlen(temp) > 0 && strcmp(temp, "fixed") != 0)
+			printf("Unknown LL_PARTITIONS_PLANNER: %s, using fixed.\n", temp);
+	}
+
+	temp = getenv("LL_RUNTIME_SPINS");
+	if(temp != NULL)
+		LL_RUNTIME_SPINS = (unsigned int)atol(temp);
+
+	temp = getenv("LL_STEP_HW_EVENTS");
+	if(temp != NULL)
+		LL_STEP_HW_EVENTS = atoi(temp);
+
+	temp = getenv("LL_MEM_TRACKER");
+	if(temp != NULL)
+		LL_MEM_TRACKER = atoi(temp);
+
+	temp = getenv("LL_HW_EVENTS_BACKEND");
+	if(temp != NULL && strlen(temp) > 0)
+		LL_HW_EVENTS_BACKEND = strdup(temp);
+
+	temp = getenv("LL_PARTITIONS_CACHE");
+	if(temp != NULL)
+		LL_PARTITIONS_CACHE = atoi(temp);
+
+	temp = getenv("LL_EDGE_TILES");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "1") == 0 || strcmp(temp, "tiles") == 0)
+			LL_EDGE_TILES = 1;
+		else if(strlen(temp) > 0 && strcmp(temp, "0") != 0 && strcmp(temp, "vertex") != 0)
+			printf("Unknown LL_EDGE_TILES: %s, using vertex partitions.\n", temp);
+	}
+
+	temp = getenv("LL_IO_QUEUE_DEPTH");
+	if(temp != NULL)
+		LL_IO_QUEUE_DEPTH = atoi(temp);
+
+	temp = getenv("LL_WEIGHTED_GRAPH_LAYOUT");
+	if(temp != NULL)
+	{
+		if(strcmp(temp, "soa") == 0)
+			LL_WEIGHTED_GRAPH_SOA = 1;
+		else if(strlen(temp) > 0 && strcmp(temp, "aos") != 0)
+			printf("Unknown LL_WEIGHTED_GRAPH_LAYOUT: %s, using aos.\n", temp);
+	}
+
+	temp = getenv("LL_COMPACT_OFFSETS");
+	if(temp != NULL)
+		LL_COMPACT_OFFSETS = atoi(temp);
+
+	temp = getenv("LL_COMPRESSED_GRAPH");
+	if(temp != NULL)
+		LL_COMPRESSED_GRAPH = atoi(temp);
+
+	temp = getenv("LL_STREAM_VALIDATION");
+	if(temp != NULL)
+		LL_STREAM_VALIDATION = atoi(temp);
+
+	temp = getenv("LL_GRAPH_CACHE");
+	if(temp != NULL)
+		LL_GRAPH_CACHE = atoi(temp);
+
+	temp = getenv("LL_GRAPH_CACHE_FOLDER");
+	if(temp != NULL && strlen(temp) > 0)
+		LL_GRAPH_CACHE_FOLDER = strdup(temp);
+
+	temp = getenv("LL_GRAPH_CACHE_BUDGET_GB");
+	if(temp != NULL)
+		LL_GRAPH_CACHE_BUDGET_GB = atol(temp);
+
 	printf("\n\033[2;32mEnv Vars:\033[0;37m\n");
 	printf("    LL_INPUT_GRAPH_PATH:         %s\n", LL_INPUT_GRAPH_PATH);
 	printf("    LL_INPUT_GRAPH_BASE_NAME:    %s\n", LL_INPUT_GRAPH_BASE_NAME);
@@ -118,8 +273,29 @@ void read_env_vars()
 	printf("    LL_INPUT_GRAPH_BATCH_ORDER:  %u\n", LL_INPUT_GRAPH_BATCH_ORDER);
 	printf("    LL_INPUT_GRAPH_IS_SYMMETRIC: %u\n", LL_INPUT_GRAPH_IS_SYMMETRIC);
 	printf("    LL_STORE_INPUT_GRAPH_IN_SHM: %u\n", LL_STORE_INPUT_GRAPH_IN_SHM);
+	printf("    LL_STORE_INPUT_GRAPH_AS_BIN: %s\n", LL_STORE_INPUT_GRAPH_AS_BIN);
 	printf("    LL_OUTPUT_REPORT_PATH:       %s\n", LL_OUTPUT_REPORT_PATH);
+	printf("    LL_TRACE_PATH:               %s\n", LL_TRACE_PATH);
+	printf("    LL_TRACE_FORMAT:             %s\n", LL_TRACE_FORMAT == NULL ? "json" : LL_TRACE_FORMAT);
 	printf("    LL_GRAPH_RA_BIN_FOLDER:      %s\n", LL_GRAPH_RA_BIN_FOLDER);
+	printf("    LL_NUMA_PLACEMENT:           %u\n", LL_NUMA_PLACEMENT);
+	printf("    LL_HUGE_PAGES:               %u\n", LL_HUGE_PAGES);
+	printf("    LL_STEAL_ORDER:              %u\n", LL_STEAL_ORDER);
+	printf("    LL_PARTITIONS_PLANNER:       %s\n", LL_PARTITIONS_PLANNER ? "auto" : "fixed");
+	printf("    LL_RUNTIME_SPINS:            %d\n", (int)LL_RUNTIME_SPINS);
+	printf("    LL_STEP_HW_EVENTS:           %u\n", LL_STEP_HW_EVENTS);
+	printf("    LL_MEM_TRACKER:              %u\n", LL_MEM_TRACKER);
+	printf("    LL_HW_EVENTS_BACKEND:        %s\n", LL_HW_EVENTS_BACKEND);
+	printf("    LL_PARTITIONS_CACHE:         %u\n", LL_PARTITIONS_CACHE);
+	printf("    LL_EDGE_TILES:               %u\n", LL_EDGE_TILES);
+	printf("    LL_IO_QUEUE_DEPTH:           %u\n", LL_IO_QUEUE_DEPTH);
+	printf("    LL_WEIGHTED_GRAPH_LAYOUT:    %s\n", LL_WEIGHTED_GRAPH_SOA ? "soa" : "aos");
+	printf("    LL_COMPACT_OFFSETS:          %u\n", LL_COMPACT_OFFSETS);
+	printf("    LL_COMPRESSED_GRAPH:         %u\n", LL_COMPRESSED_GRAPH);
+	printf("    LL_STREAM_VALIDATION:        %u\n", LL_STREAM_VALIDATION);
+	printf("    LL_GRAPH_CACHE:              %u\n", LL_GRAPH_CACHE);
+	printf("    LL_GRAPH_CACHE_FOLDER:       %s\n", LL_GRAPH_CACHE_FOLDER);
+	printf("    LL_GRAPH_CACHE_BUDGET_GB:    %'lu\n", LL_GRAPH_CACHE_BUDGET_GB);
 	
 	return;
 }
@@ -275,6 +451,71 @@ void quick_sort_ushort(unsigned short* bucket, unsigned long start, unsigned lon
 	return;
 }
 
+void quick_sort_ulong(unsigned long* bucket, unsigned long start, unsigned long end)
+{
+	if(end - start < 16)
+	{
+		do{
+			unsigned long new_end = start;
+
+			for(unsigned long i=start+1; i<=end; i++)	
+				if(bucket[i-1] > bucket[i])
+				{
+					unsigned long t=bucket[i];
+					bucket[i]=bucket[i-1];
+					bucket[i-1]=t;
+
+					new_end = i;
+				}
+
+			end = new_end;
+		}
+		while(end > start);
+
+		return;
+	}
+
+	// moving the middle index to the end to suffle for semi-sorted arrays
+	unsigned long t=bucket[(end+start)/2];
+	bucket[(end+start)/2] = bucket[end];
+	bucket[end] = t;
+
+	unsigned long pivot_index=end;
+	unsigned long front_index=start;
+
+	unsigned long bp;
+	unsigned long p=bucket[pivot_index];
+	unsigned long f;
+
+	while(pivot_index > front_index)
+	{
+		//printf("%2d %2d ** \t",pivot_index, front_index);
+		if(bucket[front_index] >= p)
+		{
+			bp=bucket[pivot_index-1];
+			f=bucket[front_index];
+
+			bucket[pivot_index]=f;
+			bucket[front_index]=bp;
+
+			pivot_index--;
+			
+		}
+		else
+			front_index++;
+	}
+
+	bucket[pivot_index]=p;
+
+	if(pivot_index > start + 1)
+		quick_sort_ulong(bucket, start, pivot_index-1);
+
+	if(pivot_index < end - 1)
+		quick_sort_ulong(bucket, pivot_index+1, end);
+
+	return;
+}
+
 char* get_date_time(char* in)
 {
 	time_t t0 = time(NULL);
@@ -396,6 +637,54 @@ unsigned long uint_binary_search(unsigned int* vals, unsigned long in_start, uns
 	return -1UL;
 }
 
+// Binary Search for `val` in [`start`, `end`) of `vals` as a sorted array  
+// returns -1UL if it cannot find
+// otherwise, returns index of the element that is equal to val
+unsigned long ulong_binary_search(unsigned long* vals, unsigned long in_start, unsigned long in_end, unsigned long val)
+{
+	unsigned long end = in_end;
+	unsigned long start = in_start;
+	assert(start <= end);
+	if(start == end)
+		return -1UL;
+
+	if(vals[start] > val) 
+		return -1UL;
+
+	if(vals[end - 1] < val)
+		return -1UL; 
+
+	unsigned long m = (start + end)/2;
+	unsigned int r = 0;
+	unsigned int r_max = 1 + log2(end + 1 - start);
+	while(1)
+	{
+		unsigned long m_val = vals[m];
+		if( m_val == val )
+			return m;
+
+		if(m + 1 < in_end)
+		{
+			if(vals[m+1] == val)
+				return m+1;
+
+			if(m_val < val && vals[m + 1] > val)
+				return -1UL;
+		}
+
+		if(m_val > val)
+			end = m;
+		if(m_val < val)
+			start = m;
+		m = (start + end)/2;
+
+		assert(r++ <= r_max);
+	}
+
+	assert("Don't reach here.");
+	return -1UL;
+}
+
 void flush_os_cache()
 {
 	char* ts = calloc(1024 + get_nprocs()/4, 1);
@@ -446,6 +735,11 @@ void* create_shm(char* shm_file_name, unsigned long length)
 	close(shm_fd);
 	shm_fd = -1;
 
+	// Asking for huge pages of tmpfs, effective if /dev/shm is mounted with `huge=advise` or 
+	// /sys/kernel/mm/transparent_hugepage/shmem_enabled is `advise`
+	if(LL_HUGE_PAGES)
+		madvise(mem, length, MADV_HUGEPAGE);
+
 	return mem;
 }
 
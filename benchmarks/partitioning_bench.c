@@ -0,0 +1,459 @@
+#ifndef __PARTITIONING_BENCH
+#define __PARTITIONING_BENCH
+
+#include "../aux.c"
+#include "../graph.c"
+#include "../partitioning.c"
+#include "../runtime.c"
+
+/*
+	Microbenchmark of the dynamic partitioning in partitioning.c.
+	
+	It compares `dynamic_partitioning_get_next_partition()` against its previous implementation
+	(`cas_dynamic_partitioning_get_next_partition()` in the following), that decrements the shared 
+	counters of the remaining partitions by CAS loops and claims each partition by a CAS on a byte-per-partition
+	status array.
+*/
+
+struct cas_dynamic_partitioning
+{
+	struct par_env* pe;
+
+	unsigned int partitions_count;
+	unsigned int partitions_remained;
+	unsigned int threads_count;
+
+	unsigned int* threads_partitions_start;
+	unsigned int* threads_partitions_end;
+	unsigned int* threads_partitions_remained;
+
+	unsigned int* threads_last_steal_offset;
+	
+	unsigned char* partitions_status;
+};
+
+struct cas_dynamic_partitioning* cas_dynamic_partitioning_initialize(struct par_env* pe, unsigned int partitions_count)
+{
+	assert(partitions_count > 0 && pe != NULL);
+	
+	struct cas_dynamic_partitioning* dp = calloc(sizeof(struct cas_dynamic_partitioning), 1);
+	assert(dp != NULL);
+	dp->partitions_count = partitions_count;
+	dp->pe = pe;
+	dp->threads_count = pe->threads_count;
+
+	dp->threads_partitions_start = calloc(pe->threads_count ,sizeof(unsigned int));
+	dp->threads_partitions_end = calloc(pe->threads_count ,sizeof(unsigned int));
+	dp->threads_partitions_remained = calloc(pe->threads_count,sizeof(unsigned int));
+	assert(dp->threads_partitions_start != NULL && dp->threads_partitions_end != NULL && dp->threads_partitions_remained != NULL);
+
+	dp->threads_last_steal_offset = calloc(pe->threads_count ,sizeof(unsigned int));
+	assert(dp->threads_last_steal_offset != NULL);
+
+	dp->partitions_status = calloc(dp->partitions_count, sizeof(unsigned char));
+	assert(dp->partitions_status != NULL);
+
+	dp->partitions_remained = partitions_count;
+
+	// Partitioning for nodes and threads
+	unsigned int remained_threads = pe->threads_count;
+	unsigned int remained_partitions = dp->partitions_count;
+	unsigned int offset = 0;
+
+	for(int t=0; t<pe->threads_count; t++)
+	{	
+		dp->threads_partitions_start[t] = offset;
+		unsigned int quota = remained_partitions/remained_threads;
+		offset += quota;
+		dp->threads_partitions_end[t] = offset;
+		dp->threads_partitions_remained[t] = quota;
+
+		remained_threads--;
+		remained_partitions -= quota;
+
+		dp->threads_last_steal_offset[t] = 0;
+
+		// printf("\t\tPartitions for thread %u: %'u - %'u\n",t, dp->threads_partitions_start[t], dp->threads_partitions_end[t]);
+	}
+
+	return dp;
+}
+
+void cas_dynamic_partitioning_release(struct cas_dynamic_partitioning* dp)
+{
+	assert(dp != NULL);
+	dp->pe = NULL;
+
+	free(dp->threads_partitions_start);
+	dp->threads_partitions_start = NULL;
+
+	free(dp->threads_partitions_end);
+	dp->threads_partitions_end = NULL;
+
+	free(dp->threads_partitions_remained);
+	dp->threads_partitions_remained = NULL;
+
+	free(dp->partitions_status);
+	dp->partitions_status = NULL;
+
+	free(dp->threads_last_steal_offset);
+	dp->threads_last_steal_offset = NULL;
+
+	free(dp);
+
+	return;
+}
+
+void cas_dynamic_partitioning_reset(struct cas_dynamic_partitioning* dp)
+{
+	assert(dp->partitions_remained == 0);
+	dp->partitions_remained =  dp->partitions_count;
+	
+	#pragma omp parallel for
+	for(unsigned int i=0; i<dp->partitions_count; i++)
+	{
+		assert(dp->partitions_status[i] == 1);
+		dp->partitions_status[i] = 0;
+	}
+
+	for(unsigned int t=0; t<dp->threads_count; t++)
+	{
+		assert(dp->threads_partitions_remained[t] == 0);
+		dp->threads_partitions_remained[t] =  dp->threads_partitions_end[t] - dp->threads_partitions_start[t];
+		dp->threads_last_steal_offset[t] = 0;
+	}
+
+	return;
+}
+
+
+unsigned int cas_dynamic_partitioning_get_next_partition(struct cas_dynamic_partitioning* dp, unsigned int thread_id, unsigned int prev_partition)
+{
+	#define CAS_CHECK_AND_GET_PARTITION(__p, __thread_id) \
+		if(__sync_bool_compare_and_swap(&dp->partitions_status[__p], 0, 1))	\
+		{ \
+			while(1) \
+			{ \
+				unsigned int temp = __atomic_load_n(&dp->partitions_remained, __ATOMIC_SEQ_CST); \
+				if(__sync_bool_compare_and_swap(&dp->partitions_remained, temp, temp-1)) \
+					break; \
+			} \
+			while(1) \
+			{ \
+				unsigned int temp = __atomic_load_n(&dp->threads_partitions_remained[__thread_id], __ATOMIC_SEQ_CST); \
+				if(__sync_bool_compare_and_swap(&dp->threads_partitions_remained[__thread_id], temp, temp-1)) \
+					break; \
+			} \
+			return p; \
+		}
+
+	if( __atomic_load_n(&dp->partitions_remained, __ATOMIC_SEQ_CST) == 0)
+		return -1U;
+
+	unsigned int start_partition = prev_partition + 1;
+	if(prev_partition == -1U)
+	{
+		start_partition = dp->threads_partitions_start[thread_id];
+		dp->threads_last_steal_offset[thread_id] = 0;
+	}
+
+	while(dp->threads_last_steal_offset[thread_id] < dp->threads_count)
+	{
+		unsigned int target_thread_id = dp->pe->threads_next_threads[thread_id][dp->threads_last_steal_offset[thread_id]];
+
+		if( __atomic_load_n(&dp->threads_partitions_remained[target_thread_id], __ATOMIC_SEQ_CST) == 0)
+		{
+			dp->threads_last_steal_offset[thread_id]++;
+			continue;
+		}
+
+		if(target_thread_id == thread_id)
+		{
+			// We are processing our partitions therefore go in the ascending order
+			for(unsigned int p=start_partition; p<dp->threads_partitions_end[target_thread_id]; p++)
+				CAS_CHECK_AND_GET_PARTITION(p, target_thread_id);
+		}
+		else
+		{
+			start_partition = prev_partition - 1;
+			// We are processing partitions of other threads, so we start from the last partition of each victim thread
+			// To prevent interrupting normal order of the victim
+
+			if(start_partition >= dp->threads_partitions_end[target_thread_id] || start_partition < dp->threads_partitions_start[target_thread_id])
+				start_partition = dp->threads_partitions_end[target_thread_id] - 1;
+
+			for(unsigned int p=start_partition; p>=dp->threads_partitions_start[target_thread_id] && p != -1U; p--)
+				CAS_CHECK_AND_GET_PARTITION(p, target_thread_id);
+		}
+
+		dp->threads_last_steal_offset[thread_id]++;
+	}	
+	
+	return -1U;
+}
+
+/*
+	`type`: 
+		1: the previous (CAS-based) dynamic partitioning, 
+		2: the current dynamic partitioning, dynamic_partitioning_get_next_partition()
+
+	`work`: the number of iterations of a random number generator for processing each partition.
+	The first 1/8 of the partitions are 16 times heavier to create stealing.
+
+	The results are written to `res`:
+		res[0]: million claims per second (including the time of `work`),
+		res[1-4]: the 50th, 99th, 99.9th percentiles and the max latency of claims in ns
+
+	Returns 0 if each partition has been claimed exactly once in each round.
+*/
+int test_dynamic_partitioning(struct par_env* pe, const int type, unsigned int partitions_per_thread, unsigned int work, unsigned int rounds, double* res)
+{
+	// Initial checks
+		if(partitions_per_thread == 0)
+			partitions_per_thread = 256;
+		if(rounds == 0)
+			rounds = 100;
+		printf("\033[3;31mtest_dynamic_partitioning\033[0;37m, type: %u, partitions_per_thread: %'u, work: %'u, rounds: %'u\n", 
+			type, partitions_per_thread, work, rounds);
+		assert(pe != NULL && (type == 1 || type == 2) && res != NULL);
+		res[0] = res[1] = res[2] = res[3] = res[4] = 0.0;
+
+		const unsigned int partitions_count = partitions_per_thread * pe->threads_count;
+		const unsigned int buckets_count = 10000;  // 10 ns buckets 
+		const unsigned int bucket_ns = 10;
+
+	// Allocating memory
+		struct cas_dynamic_partitioning* cdp = NULL;
+		struct dynamic_partitioning* dp = NULL;
+		if(type == 1)
+			cdp = cas_dynamic_partitioning_initialize(pe, partitions_count);
+		else
+			dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+		unsigned int* claims = numa_alloc_interleaved(sizeof(unsigned int) * partitions_count);
+		assert(claims != NULL);
+		
+		unsigned long* histograms = numa_alloc_interleaved(sizeof(unsigned long) * buckets_count * pe->threads_count);
+		assert(histograms != NULL);
+		unsigned long* threads_max_latency = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(threads_max_latency != NULL);
+
+		#pragma omp parallel for 
+		for(unsigned int p = 0; p < partitions_count; p++)
+			claims[p] = 0;
+		
+		#pragma omp parallel for 
+		for(unsigned long i = 0; i < (unsigned long)buckets_count * pe->threads_count; i++)
+			histograms[i] = 0;
+
+	// Running
+		unsigned long sum_rand = 0;
+		unsigned long mt = 0;
+		for(unsigned int r = 0; r < rounds; r++)
+		{
+			mt -= get_nano_time();
+			#pragma omp parallel reduction(+:sum_rand)
+			{
+				unsigned tid = omp_get_thread_num();
+				unsigned long* histogram = histograms + (unsigned long)tid * buckets_count;
+				unsigned long rand_state[4] = {tid + 1, r + 1, 3, 4};
+				unsigned int partition = -1U;
+				
+				while(1)
+				{
+					unsigned long t0 = get_nano_time();
+					if(type == 1)
+						partition = cas_dynamic_partitioning_get_next_partition(cdp, tid, partition);
+					else
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					t0 = get_nano_time() - t0;
+
+					histogram[min(t0 / bucket_ns, buckets_count - 1)]++;
+					if(t0 > threads_max_latency[tid])
+						threads_max_latency[tid] = t0;
+					
+					if(partition == -1U)
+						break;
+
+					claims[partition]++;
+					unsigned int iterations = work;
+					if(partition < partitions_count / 8)
+						iterations *= 16;
+					for(unsigned int i = 0; i < iterations; i++)
+						sum_rand += rand_xoshiro256(rand_state);
+				}
+			}
+			mt += get_nano_time();
+
+			if(type == 1)
+				cas_dynamic_partitioning_reset(cdp);
+			else
+				dynamic_partitioning_reset(dp);
+		}
+
+	// Validating
+		int ret = 0;
+		for(unsigned int p = 0; p < partitions_count; p++)
+			if(claims[p] != rounds)
+			{
+				printf("Partition %'u has been claimed %'u times.\n", p, claims[p]);
+				ret = -1;
+				break;
+			}
+
+	// Calculating results
+		unsigned long total_claims = 0;
+		unsigned long max_latency = 0;
+		for(unsigned int t = 0; t < pe->threads_count; t++)
+		{
+			for(unsigned int b = 0; b < buckets_count; b++)
+				total_claims += histograms[(unsigned long)t * buckets_count + b];
+			max_latency = max(max_latency, threads_max_latency[t]);
+		}
+
+		double percentiles[3] = {0.5, 0.99, 0.999};
+		unsigned long seen_claims = 0;
+		unsigned int pi = 0;
+		for(unsigned int b = 0; b < buckets_count && pi < 3; b++)
+		{
+			for(unsigned int t = 0; t < pe->threads_count; t++)
+				seen_claims += histograms[(unsigned long)t * buckets_count + b];
+			while(pi < 3 && seen_claims >= percentiles[pi] * total_claims)
+				res[1 + pi++] = (b + 1) * bucket_ns;
+		}
+
+		res[0] = 1e3 * partitions_count * rounds / mt;
+		res[4] = max_latency;
+
+		printf("Time: %'.1f (ms), claims: %'lu, (%lu)\n", mt / 1e6, total_claims, sum_rand % 2);
+
+	// Releasing memory
+		if(type == 1)
+			cas_dynamic_partitioning_release(cdp);
+		else
+			dynamic_partitioning_release(dp);
+		cdp = NULL;
+		dp = NULL;
+
+		numa_free(claims, sizeof(unsigned int) * partitions_count);
+		claims = NULL;
+
+		numa_free(histograms, sizeof(unsigned long) * buckets_count * pe->threads_count);
+		histograms = NULL;
+
+		free(threads_max_latency);
+		threads_max_latency = NULL;
+
+	return ret;
+}
+
+/*
+	Measures the overhead of a step of an algorithm with few partitions, i.e., starting the threads, 
+	draining the partitions of `dp` (without work), and the serial reset of `dp`, for `steps` steps.
+
+	`type`: 
+		1: a parallel region per step and dynamic_partitioning_reset() after the region, 
+		2: the persistent workers of the runtime (runtime.c) with a phase barrier per step and 
+		dynamic_partitioning_reset() in the serial part of the barrier
+
+	The average time of a step in ns is written to `res[0]`.
+
+	Returns 0 if each partition has been claimed exactly once in each step.
+*/
+int test_phase_overhead(struct par_env* pe, const int type, unsigned int partitions_per_thread, unsigned int steps, double* res)
+{
+	// Initial checks
+		if(partitions_per_thread == 0)
+			partitions_per_thread = 4;
+		if(steps == 0)
+			steps = 10000;
+		printf("\033[3;31mtest_phase_overhead\033[0;37m, type: %u, partitions_per_thread: %'u, steps: %'u\n", type, partitions_per_thread, steps);
+		assert(pe != NULL && (type == 1 || type == 2) && res != NULL);
+		res[0] = 0.0;
+
+		const unsigned int partitions_count = partitions_per_thread * pe->threads_count;
+
+	// Allocating memory
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+		struct par_runtime* rt = par_runtime_get(pe);
+		par_runtime_reset_stats(rt);
+
+		unsigned int* claims = calloc(sizeof(unsigned int), partitions_count);
+		assert(claims != NULL);
+
+	// Running
+		unsigned long mt = - get_nano_time();
+		if(type == 1)
+		{
+			for(unsigned int s = 0; s < steps; s++)
+			{
+				#pragma omp parallel
+				{
+					unsigned tid = omp_get_thread_num();
+					unsigned int partition = -1U;
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+						claims[partition]++;
+					}
+				}
+				dynamic_partitioning_reset(dp);
+			}
+		}
+		else
+		{
+			unsigned int s = 0;
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				while(s < steps)
+				{
+					unsigned int partition = -1U;
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+						claims[partition]++;
+					}
+
+					if(par_runtime_barrier(rt))
+					{
+						dynamic_partitioning_reset(dp);
+						s++;
+						par_runtime_barrier_release(rt);
+					}
+				}
+			}
+		}
+		mt += get_nano_time();
+
+	// Validating
+		int ret = 0;
+		for(unsigned int p = 0; p < partitions_count; p++)
+			if(claims[p] != steps)
+			{
+				printf("Partition %'u has been claimed %'u times.\n", p, claims[p]);
+				ret = -1;
+				break;
+			}
+
+		res[0] = 1.0 * mt / steps;
+		printf("Time: %'.1f (ms), per step: %'.2f (us)\n", mt / 1e6, res[0] / 1e3);
+		if(type == 2)
+			par_runtime_print_stats(rt);
+
+	// Releasing memory
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		rt = NULL;
+
+		free(claims);
+		claims = NULL;
+
+	return ret;
+}
+
+#endif
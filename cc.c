@@ -1,182 +1,59 @@
 #ifndef __CC_C
 #define __CC_C
 
-// This file contains implementation of the Connected Components algorithms
-
-/*
-
-CC with pull direction in all iterations. We use this for validation of results.
-
-flags: 
-	bit 0: print stats
-	bit 1: do not reset papi
-
-exec_info: if not NULL, will have 
-	[0]: exec time
-	[1-7]: papi events
-*/
-unsigned int* cc_pull(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
-{
-	// Initial checks
-		assert(pe != NULL && g != NULL);
-		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_pull\033[0;37m\n");
-
-	// Reset papi
-		if(!(flags & 2U))
-			#pragma omp parallel 
-			{
-				unsigned tid = omp_get_thread_num();
-				papi_reset(pe->papi_args[tid]);
-			}
-
-	// Allocate memory
-		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
-		assert(cc != NULL);
-		#pragma omp parallel for
-		for(unsigned int v = 0; v < g->vertices_count; v++)
-			cc[v] = v;
-
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
-
-	// Edge partitioning
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-
-	// Pull iterations
-		unsigned int cc_changed = 0;
-		unsigned int cc_iter = 0;
-		do
-		{
-			cc_changed = 0;
-			unsigned long mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned long thread_cc_changed = 0;
-				unsigned int partition = -1U;		
-				
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					{
-						unsigned int component = cc[v];
-						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
-						{
-							unsigned int neighbour = g->edges_list[e];
-							if(cc[neighbour] < component)
-								component = cc[neighbour];
-						}
-
-						if(component < cc[v])
-						{
-							cc[v] = component;
-							thread_cc_changed++;
-						}
-					}
-				}
-
-				if(thread_cc_changed)
-					__sync_fetch_and_add(&cc_changed, thread_cc_changed, __ATOMIC_SEQ_CST);
-				
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			if(flags & 1U)
-			{
-				char temp[255];
-				if(cc_changed < 100)
-					sprintf(temp, "Iter: %'3u, |F|: %5u, time:", cc_iter, cc_changed);
-				else
-					sprintf(temp, "Iter: %'3u, |F|: %'4.1f%, time:", cc_iter, 100.0*cc_changed/g->vertices_count);
-				PTIP(temp);
-			}
-			cc_iter++;
-		}while(cc_changed);
-
-	// Saving events
-		if(!(flags & 2U))
-		{
-			#pragma omp parallel
-			{
-				assert(0 == thread_papi_read(pe));
-			}
-			if(flags & 1U)
-				print_hw_events(pe, 1);
-			if(exec_info)
-				copy_reset_hw_events(pe, &exec_info[1], 1);
-		}
-
-	// Number of components
-		if(ccs_p)
-		{
-			unsigned int ccs = 0;
-			#pragma omp parallel for reduction(+:ccs)
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				if(cc[v] == v)
-					ccs++;
-			printf("|CCs|:            \t\t%'u\n",ccs);
-			*ccs_p = ccs;
-		}
-		
-	// Finalizing
-		t0 += get_nano_time();
-		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
-		if(exec_info)
-			exec_info[0] = t0;
+#include "compressed_graph.c"
+#include "runtime.c"
 
-	// Releasing memory
-		free(partitions);
-		partitions = NULL;
-
-		free(ttimes);
-		ttimes = NULL;
+// This file contains implementation of the Connected Components algorithms
 
-	return cc;
-}
+#define LL_IDW 4
+#include "cc.tpl.c"
+#undef LL_IDW
+#define LL_IDW 8
+#include "cc.tpl.c"
+#undef LL_IDW
+#define LL_IDW 4
+#define LL_OFW 4
+#include "cc.tpl.c"
+#undef LL_OFW
+#undef LL_IDW
+
+// Select the specialisations of cc_pull(), cc_jt(), and cc_thrifty_400() by the type of the graph at compile time
+#define cc_pull(__pe, __g, ...) \
+	_Generic((__g), \
+		struct ll_800_graph*: cc_pull_800, \
+		struct ll_400_c32_graph*: cc_pull_c32, \
+		default: cc_pull \
+	)(__pe, __g, __VA_ARGS__)
+
+#define cc_jt(__pe, __g, ...) \
+	_Generic((__g), \
+		struct ll_800_graph*: cc_jt_800, \
+		struct ll_400_c32_graph*: cc_jt_c32, \
+		default: cc_jt \
+	)(__pe, __g, __VA_ARGS__)
+
+#define cc_thrifty(__pe, __g, ...) \
+	_Generic((__g), \
+		struct ll_800_graph*: cc_thrifty_800, \
+		struct ll_400_c32_graph*: cc_thrifty_400_c32, \
+		default: cc_thrifty_400 \
+	)(__pe, __g, __VA_ARGS__)
 
 /*
-	Thrifty Label Propagation Connected Components
-
-	https://blogs.qub.ac.uk/DIPSA/Thrifty-Label-Propagation-Fast-Connected-Components-for-Skewed-Degree-Graphs/
-
-	@INPROCEEDINGS{10.1109/Cluster48925.2021.00042,
-	  author={Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
-	  booktitle={2021 IEEE International Conference on Cluster Computing (CLUSTER)}, 
-	  title={Thrifty Label Propagation: Fast Connected Components for Skewed-Degree Graphs}, 
-	  year={2021},
-	  volume={},
-	  number={},
-	  pages={226-237},
-	  publisher={IEEE Computer Society},
-	  doi={10.1109/Cluster48925.2021.00042}
-	}
-
-	flags:
-		bit 0: print stats
-		bit 1: do not reset papi
-
-	exec_info: if not NULL, will have
-		[0]: exec time
-		[1-7]: papi events
-		[8]: push max-degree
+	It is the thrifty for weighted graphs
 */
-unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
 {
 	// Initial checks
 		assert(pe != NULL && g != NULL);
 		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_thrifty\033[0;37m\n");
+		printf("\n\033[3;31mcc_thrifty_w4\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
 
 	// Reset papi
 		if(!(flags & 2U))
@@ -195,10 +72,8 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 	// Edge partitioning
 		unsigned int thread_partitions = 64;
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+		struct dynamic_partitioning* dp = NULL;
+		unsigned int* partitions = partitions_cache_get(pe, (struct ll_400_graph*)g, partitions_count, &dp);
 
 	// Zero Planting: Assigning the zero label to the vertex with max degree
 		unsigned long mt = - get_nano_time();
@@ -253,7 +128,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 			ttimes[tid] = - get_nano_time();
 
 			#pragma omp for nowait
-			for(unsigned long e = g->offsets_list[max_degree_id]; e < g->offsets_list[max_degree_id + 1]; e++)
+			for(unsigned long e = 2 * g->offsets_list[max_degree_id]; e < 2 * g->offsets_list[max_degree_id + 1]; e+=2)
 				cc[g->edges_list[e]] = 0;
 
 			ttimes[tid] += get_nano_time();
@@ -293,7 +168,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 						if(!component)
 							continue;
 
-						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+						for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
 						{
 							unsigned int neighbour = g->edges_list[e];
 							if(cc[neighbour] < component)
@@ -338,18 +213,18 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 	// Allocating memory for the shared worklists
 		/*
 			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
-			Since push iterations are sparse, we dedicate a chunk (with a size of cacheline, i.e., 16 uints) to each thread and after filling it we allocate another chunk. This way, we do not need to allocate per thread worklist. 
+			Since push iterations are sparse, we dedicate a chunk of `waspr` size to each thread and 
+			after filling it we allocate another chunk. This way, we do not need to alocate per vertex worklist.
 			
-			The another point is about tiling. The initial implementation of thrifty used the 
-			edge-tiling [Galois, DOI:10.1145/2517349.2522739] in the push iterations to allow
+			The another point is about tiling. The initial implementation of thrifty had edge-tiling to allow
 			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
-			push direction, we do not expect to see very high degree vertices and we do not use edge-tiling in this implementation. 
+			push direction, we do not expect to see very high degree vertices. 
 
 			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
 			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
 			
 			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
-			previously stored in the worklist. We do not use atomics for accessing `df` as it is correct to process a 
+			previously stored in the worklist. We do not use atomics for accessing df as it is correct to process a 
 			vertex multiple times in a CC iteration. 
 		*/
 
@@ -389,7 +264,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 					if(!component)
 						continue;
 
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
 					{
 						unsigned int neighbour = g->edges_list[e];
 						if(cc[neighbour] < component)
@@ -475,7 +350,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 					if(degree > push_max_degree)
 						push_max_degree = degree;
 
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v+1]; e++)
+					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v+1]; e += 2)
 					{
 						unsigned int neighbour = g->edges_list[e];
 						unsigned int changed = 0;
@@ -578,6 +453,18 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 			*ccs_p = ccs;
 		}
 		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
 	// Finalizing
 		t0 += get_nano_time();
 		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
@@ -585,8 +472,9 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 			exec_info[0] = t0;
 
 	// Releasing memory
-		free(partitions);
+		partitions_cache_put(partitions, dp);
 		partitions = NULL;
+		dp = NULL;
 		free(ttimes);
 		ttimes = NULL;
 		numa_free(worklist, sizeof(unsigned int) * worklist_size);
@@ -602,14 +490,209 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 }
 
 /*
-	It is the thrifty for weighted graphs
+	Thrifty for weighted graphs in the structure-of-arrays layout. As CC does not read the weights, 
+	the graph is processed by `cc_thrifty_400()` and only the 4 Bytes destinations of edges are read, 
+	i.e., half of the edges bytes that `cc_thrifty_404()` reads.
+	`flags`, `exec_info`, and `ccs_p` are the same as `cc_thrifty_400()`.
 */
-unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+unsigned int* cc_thrifty_404_soa(struct par_env* pe, struct ll_404_soa_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	return cc_thrifty_400(pe, (struct ll_400_graph*)g, flags, exec_info, ccs_p);
+}
+
+/*
+	`cc_pull()` for compressed graphs. Neighbours are decoded in the inner loop and 
+	partitions are balanced by the number of bytes.
+
+flags: 
+	bit 0: print stats
+	bit 1: do not reset papi
+
+exec_info: if not NULL, will have 
+	[0]: exec time
+	[1-7]: papi events
+	[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+	[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
+*/
+unsigned int* cc_pull_cg(struct par_env* pe, struct ll_400_cgraph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
 {
 	// Initial checks
 		assert(pe != NULL && g != NULL);
 		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_thrifty_w4\033[0;37m\n");
+		printf("\n\033[3;31mcc_pull_cg\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(cc != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			cc[v] = v;
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		ll_400_cgraph_partitioning(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Pull iterations
+		unsigned int cc_changed = 0;
+		unsigned int cc_iter = 0;
+		do
+		{
+			cc_changed = 0;
+			unsigned long mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned long thread_cc_changed = 0;
+				unsigned int partition = -1U;		
+				
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						unsigned int component = cc[v];
+						unsigned char* bp = g->bytes_list + g->offsets_list[v];
+						unsigned long degree;
+						LL_CG_READ_VARINT(bp, degree);
+						unsigned long neighbour = v;
+						for(unsigned long d = 0; d < degree; d++)
+						{
+							LL_CG_READ_NEIGHBOUR(bp, neighbour);
+							if(cc[neighbour] < component)
+								component = cc[neighbour];
+						}
+
+						if(component < cc[v])
+						{
+							cc[v] = component;
+							thread_cc_changed++;
+						}
+					}
+				}
+
+				if(thread_cc_changed)
+					__sync_fetch_and_add(&cc_changed, thread_cc_changed, __ATOMIC_SEQ_CST);
+				
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			if(flags & 1U)
+			{
+				char temp[255];
+				if(cc_changed < 100)
+					sprintf(temp, "Iter: %'3u, |F|: %5u, time:", cc_iter, cc_changed);
+				else
+					sprintf(temp, "Iter: %'3u, |F|: %'4.1f%, time:", cc_iter, 100.0*cc_changed/g->vertices_count);
+				PTIP(temp);
+			}
+			cc_iter++;
+		}while(cc_changed);
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Number of components
+		if(ccs_p)
+		{
+			unsigned int ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'u\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	// Releasing memory
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(partitions);
+		partitions = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+	return cc;
+}
+
+/*
+	`cc_thrifty_400()` for compressed graphs. Neighbours are decoded in the inner loops and 
+	partitions are balanced by the number of bytes.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: push max-degree
+		[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+		[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
+*/
+unsigned int* cc_thrifty_400_cg(struct par_env* pe, struct ll_400_cgraph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_thrifty_cg\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
 
 	// Reset papi
 		if(!(flags & 2U))
@@ -630,7 +713,7 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
 		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
 		assert(partitions != NULL);
-		parallel_edge_partitioning((struct ll_400_graph*)g, partitions, partitions_count);
+		ll_400_cgraph_partitioning(g, partitions, partitions_count);
 		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
 
 	// Zero Planting: Assigning the zero label to the vertex with max degree
@@ -650,7 +733,7 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 				{
 					cc[v] = v + 1;
 
-					unsigned int degree = g->offsets_list[v+1] - g->offsets_list[v];
+					unsigned int degree = ll_400_cgraph_degree(g, v);
 					if(degree > thread_max_vals[0])
 					{
 						thread_max_vals[0] = degree;
@@ -679,21 +762,22 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 		}
 
 	// Initial Push: Propagate the zero label to the neighbours of the max-degree vertex
+		// The neighbour-list is decoded sequentially
 		mt = - get_nano_time();
-		#pragma omp parallel  
 		{
-			unsigned tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-
-			#pragma omp for nowait
-			for(unsigned long e = 2 * g->offsets_list[max_degree_id]; e < 2 * g->offsets_list[max_degree_id + 1]; e+=2)
-				cc[g->edges_list[e]] = 0;
-
-			ttimes[tid] += get_nano_time();
+			unsigned char* bp = g->bytes_list + g->offsets_list[max_degree_id];
+			unsigned long degree;
+			LL_CG_READ_VARINT(bp, degree);
+			unsigned long neighbour = max_degree_id;
+			for(unsigned long d = 0; d < degree; d++)
+			{
+				LL_CG_READ_NEIGHBOUR(bp, neighbour);
+				cc[neighbour] = 0;
+			}
 		}
 		mt += get_nano_time();
 		if(flags & 1U)
-			PTIP("Initial Push:");
+			PT("Initial Push:");
 
 	// Pull iterations with Zero Convergence: 
 		// If a vertex has reached zero label, its label cannot be reduced => do not process it.
@@ -726,9 +810,13 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 						if(!component)
 							continue;
 
-						for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
+						unsigned char* bp = g->bytes_list + g->offsets_list[v];
+						unsigned long degree;
+						LL_CG_READ_VARINT(bp, degree);
+						unsigned long neighbour = v;
+						for(unsigned long d = 0; d < degree; d++)
 						{
-							unsigned int neighbour = g->edges_list[e];
+							LL_CG_READ_NEIGHBOUR(bp, neighbour);
 							if(cc[neighbour] < component)
 							{
 								component = cc[neighbour];
@@ -742,7 +830,7 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 						{
 							cc[v] = component;
 							thread_next_vertices++;
-							thread_next_edges += g->offsets_list[v+1] - g->offsets_list[v];
+							thread_next_edges += degree;
 						}
 					}
 				}
@@ -771,18 +859,18 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 	// Allocating memory for the shared worklists
 		/*
 			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
-			Since push iterations are sparse, we dedicate a chunk of `waspr` size to each thread and 
-			after filling it we allocate another chunk. This way, we do not need to alocate per vertex worklist.
+			Since push iterations are sparse, we dedicate a chunk (with a size of cacheline, i.e., 16 uints) to each thread and after filling it we allocate another chunk. This way, we do not need to allocate per thread worklist. 
 			
-			The another point is about tiling. The initial implementation of thrifty had edge-tiling to allow
+			The another point is about tiling. The initial implementation of thrifty used the 
+			edge-tiling [Galois, DOI:10.1145/2517349.2522739] in the push iterations to allow
 			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
-			push direction, we do not expect to see very high degree vertices. 
+			push direction, we do not expect to see very high degree vertices and we do not use edge-tiling in this implementation. 
 
 			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
 			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
 			
 			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
-			previously stored in the worklist. We do not use atomics for accessing df as it is correct to process a 
+			previously stored in the worklist. We do not use atomics for accessing `df` as it is correct to process a 
 			vertex multiple times in a CC iteration. 
 		*/
 
@@ -822,9 +910,13 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 					if(!component)
 						continue;
 
-					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
+					unsigned char* bp = g->bytes_list + g->offsets_list[v];
+					unsigned long degree;
+					LL_CG_READ_VARINT(bp, degree);
+					unsigned long neighbour = v;
+					for(unsigned long d = 0; d < degree; d++)
 					{
-						unsigned int neighbour = g->edges_list[e];
+						LL_CG_READ_NEIGHBOUR(bp, neighbour);
 						if(cc[neighbour] < component)
 						{
 							component = cc[neighbour];
@@ -904,13 +996,16 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 						continue;
 					df[v] = 0;
 
-					unsigned int degree = g->offsets_list[v+1] - g->offsets_list[v];
+					unsigned char* bp = g->bytes_list + g->offsets_list[v];
+					unsigned long degree;
+					LL_CG_READ_VARINT(bp, degree);
 					if(degree > push_max_degree)
 						push_max_degree = degree;
 
-					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v+1]; e += 2)
+					unsigned long neighbour = v;
+					for(unsigned long d = 0; d < degree; d++)
 					{
-						unsigned int neighbour = g->edges_list[e];
+						LL_CG_READ_NEIGHBOUR(bp, neighbour);
 						unsigned int changed = 0;
 
 						while(1)
@@ -1011,6 +1106,18 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 			*ccs_p = ccs;
 		}
 		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
 	// Finalizing
 		t0 += get_nano_time();
 		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
@@ -1018,6 +1125,8 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 			exec_info[0] = t0;
 
 	// Releasing memory
+		dynamic_partitioning_release(dp);
+		dp = NULL;
 		free(partitions);
 		partitions = NULL;
 		free(ttimes);
@@ -1034,203 +1143,4 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 	return cc;
 }
 
-void cc_release(struct ll_400_graph* g, unsigned int* cc)
-{
-	assert(cc != NULL && g != NULL);
-	numa_free(cc, sizeof(unsigned int) * g->vertices_count);
-	return;
-} 
-
-/*
-	An implementation of a Disjoint-Set Union CC 
-	introduced by Siddhartha Jayanti and Robert Tarjan in the following paper
-
-	@article{ DBLP:journals/corr/JayantiT16,
-	author    = {Siddhartha V. Jayanti and Robert E. Tarjan},
-	title     = {A Randomized Concurrent Algorithm for Disjoint Set Union},
-	journal   = {CoRR},
-	volume    = {abs/1612.01514},
-	year      = {2016},
-	url       = {http://arxiv.org/abs/1612.01514},
-	eprinttype = {arXiv},
-	eprint    = {1612.01514},
-	}
-
-	flags:
-		bit 0: print stats
-		bit 1: do not reset papi
-
-	exec_info: if not NULL, will have
-		[0]: exec time
-		[1-7]: papi events
-*/
-
-unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
-{
-	// Initial checks
-		assert(pe != NULL && g != NULL);
-		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_jt\033[0;37m\n");
-
-	// Reset papi
-		if(!(flags & 2U))
-			#pragma omp parallel 
-			{
-				unsigned tid = omp_get_thread_num();
-				papi_reset(pe->papi_args[tid]);
-			}
-	
-	// Allocate memory
-		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
-		assert(cc != NULL);
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
-
-	// Edge partitioning
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-
-	// (1) Initializing
-		unsigned long mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					cc[v] = v;
-				
-			}
-
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		if(flags & 1U)
-			PTIP("(1) Initializing");
-
-	// (2) Traversing edges
-		mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
-					{
-						unsigned int neighbour = g->edges_list[e];
-						if(neighbour >= v)
-							break;
-
-						unsigned int x = v;
-						unsigned int y = neighbour;
-
-						while(1)
-						{
-							while(x != cc[x])
-								x = cc[x];
-
-							while(y != cc[y])
-								y = cc[y];
-
-							if(x == y)
-								break;
-
-							if(x < y)
-							{
-								if(__sync_bool_compare_and_swap(&cc[y], y, x))
-									break;
-							}
-							else
-							{
-								if(__sync_bool_compare_and_swap(&cc[x], x, y))
-									break;
-							}
-
-						}
-					}
-			}
-
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		if(flags & 1U)
-			PTIP("(2) Traversing edges:");
-
-	// (3) Pointer jumping
-		mt = - get_nano_time();
-		#pragma omp parallel   
-		{
-			unsigned tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-
-			#pragma omp for 
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				while(cc[cc[v]] != cc[v])
-					cc[v] = cc[cc[v]];
-
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		if(flags & 1U)
-			PTIP("(3) Pointer jumping:");
-
-	// Saving events
-		if(!(flags & 2U))
-		{
-			#pragma omp parallel
-			{
-				assert(0 == thread_papi_read(pe));
-			}
-			if(flags & 1U)
-				print_hw_events(pe, 1);
-			if(exec_info)
-				copy_reset_hw_events(pe, &exec_info[1], 1);
-		}
-
-	// Counting number of components
-		if(ccs_p)
-		{
-			unsigned int ccs = 0;
-			#pragma omp parallel for reduction(+:ccs)
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				if(cc[v] == v)
-					ccs++;
-			printf("|CCs|:            \t\t%'u\n",ccs);
-			*ccs_p = ccs;
-		}
-		
-	// Finalizing
-		t0 += get_nano_time();
-		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
-		if(exec_info)
-			exec_info[0] = t0;
-
-	// Releasing memory
-		free(partitions);
-		partitions = NULL;
-		free(ttimes);
-		ttimes = NULL;
-	
-	return cc;
-}
-
 #endif
@@ -0,0 +1,1093 @@
+// Connected Components functions specialised for the width of vertex IDs, included by cc.c (see id_width.c)
+
+#include "id_width.c"
+
+/*
+
+CC with pull direction in all iterations. We use this for validation of results.
+
+flags: 
+	bit 0: print stats
+	bit 1: do not reset papi
+	bits 4-5: huge pages for the cc array, LL_HUGE_PAGES_NONE (default) or LL_HUGE_PAGES_THP 
+		(explicit huge pages are reduced to THP as cc is released by numa_free())
+	bit 7: edge tiles, i.e., partitions split the edges of hubs (see parallel_edge_tiling())
+
+exec_info: if not NULL, will have 
+	[0]: exec time
+	[1-7]: papi events
+	[9]: partitions per thread (see partitions_plan_decide())
+	[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+	[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
+*/
+IDW_T* IDW_FN(cc_pull, cc_pull_800)(struct par_env* pe, IDW_GRAPH* g, unsigned int flags, unsigned long* exec_info, IDW_T* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_pull\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
+		IDW_OFFSETS_SAVED_INIT;
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned int cc_pages = LL_HUGE_PAGES_NONE;
+		IDW_T* cc = numa_alloc_interleaved_huge(sizeof(IDW_T) * g->vertices_count, min((flags >> 4) & 3U, LL_HUGE_PAGES_THP), &cc_pages);
+		assert(cc != NULL);
+		#pragma omp parallel for
+		for(IDW_T v = 0; v < g->vertices_count; v++)
+			cc[v] = v;
+		if((flags & 1U) && ((flags >> 4) & 3U))
+			print_huge_pages_stats("cc:", cc, sizeof(IDW_T) * g->vertices_count, cc_pages);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		struct partitions_plan* pp = IDW_FN(partitions_plan_create, partitions_plan_create_800)(pe, g, "cc_pull", 64);
+		unsigned int thread_partitions = pp->thread_partitions;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		struct dynamic_partitioning* dp = NULL;
+		IDW_T* partitions = IDW_FN(partitions_cache_get, partitions_cache_get_800)(pe, g, partitions_count, &dp);
+
+	// Edge tiling: as many tiles as partitions, so `dp` also dispenses the tiles
+		IDW_T* tiles_vertices = NULL;
+		unsigned long* tiles_edges = NULL;
+		if((flags >> 7) & 1U)
+		{
+			tiles_vertices = calloc(sizeof(IDW_T), partitions_count + 1);
+			tiles_edges = calloc(sizeof(unsigned long), partitions_count + 1);
+			assert(tiles_vertices != NULL && tiles_edges != NULL);
+			IDW_FN(parallel_edge_tiling, parallel_edge_tiling_800)(g, tiles_vertices, tiles_edges, partitions_count);
+		}
+
+	// Pull iterations
+		IDW_T cc_changed = 0;
+		unsigned int cc_iter = 0;
+		do
+		{
+			cc_changed = 0;
+			unsigned long mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned long thread_cc_changed = 0;
+				unsigned int partition = -1U;		
+				
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					if(tiles_vertices == NULL)
+						for(IDW_T v = partitions[partition]; v < partitions[partition + 1]; v++)
+						{
+							IDW_T component = cc[v];
+							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							{
+								IDW_T neighbour = g->edges_list[e];
+								if(cc[neighbour] < component)
+									component = cc[neighbour];
+							}
+
+							if(component < cc[v])
+							{
+								cc[v] = component;
+								thread_cc_changed++;
+							}
+						}
+					else
+						for(IDW_T v = tiles_vertices[partition]; v <= tiles_vertices[partition + 1] && v < g->vertices_count; v++)
+						{
+							unsigned long e_start = v == tiles_vertices[partition] ? tiles_edges[partition] : g->offsets_list[v];
+							unsigned long e_end = v == tiles_vertices[partition + 1] ? tiles_edges[partition + 1] : g->offsets_list[v + 1];
+							if(v == tiles_vertices[partition + 1] && e_end == g->offsets_list[v])
+								break;
+
+							IDW_T component = cc[v];
+							for(unsigned long e = e_start; e < e_end; e++)
+							{
+								IDW_T neighbour = g->edges_list[e];
+								if(cc[neighbour] < component)
+									component = cc[neighbour];
+							}
+
+							// The tiles of a split hub are combined by atomic min
+							if(e_start != g->offsets_list[v] || e_end != g->offsets_list[v + 1])
+								thread_cc_changed += IDW_FN(edge_tiles_reduce_min, edge_tiles_reduce_min_800)(cc, v, component);
+							else if(component < cc[v])
+							{
+								cc[v] = component;
+								thread_cc_changed++;
+							}
+						}
+				}
+
+				if(thread_cc_changed)
+					__sync_fetch_and_add(&cc_changed, thread_cc_changed, __ATOMIC_SEQ_CST);
+				
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			partitions_plan_add_step(pp, mt, ttimes, pe->threads_count);
+			if(flags & 1U)
+			{
+				char temp[255];
+				if(cc_changed < 100)
+					sprintf(temp, "Iter: %'3u, |F|: %5" IDW_FMT ", time:", cc_iter, cc_changed);
+				else
+					sprintf(temp, "Iter: %'3u, |F|: %'4.1f%, time:", cc_iter, 100.0*cc_changed/g->vertices_count);
+				IDW_PTIP(temp, g->vertices_count + 1);
+			}
+			cc_iter++;
+		}while(cc_changed);
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Number of components
+		if(ccs_p)
+		{
+			IDW_T ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(IDW_T v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'" IDW_FMT "\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		IDW_OFFSETS_SAVED_PRINT();
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[9] = pp->thread_partitions;
+		}
+
+	// Releasing memory
+		partitions_cache_put(partitions, dp);
+		partitions = NULL;
+		dp = NULL;
+		if(tiles_vertices != NULL)
+		{
+			free(tiles_vertices);
+			tiles_vertices = NULL;
+			free(tiles_edges);
+			tiles_edges = NULL;
+		}
+
+		free(ttimes);
+		ttimes = NULL;
+
+		partitions_plan_release(pp);
+		pp = NULL;
+
+	return cc;
+}
+
+/*
+	Thrifty Label Propagation Connected Components
+
+	https://blogs.qub.ac.uk/DIPSA/Thrifty-Label-Propagation-Fast-Connected-Components-for-Skewed-Degree-Graphs/
+
+	@INPROCEEDINGS{10.1109/Cluster48925.2021.00042,
+	  author={Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
+	  booktitle={2021 IEEE International Conference on Cluster Computing (CLUSTER)}, 
+	  title={Thrifty Label Propagation: Fast Connected Components for Skewed-Degree Graphs}, 
+	  year={2021},
+	  volume={},
+	  number={},
+	  pages={226-237},
+	  publisher={IEEE Computer Society},
+	  doi={10.1109/Cluster48925.2021.00042}
+	}
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+		bits 2-3: NUMA placement policy of the graph and the vertex arrays, LL_NUMA_INTERLEAVE (default), 
+			LL_NUMA_OWNER_LOCAL or LL_NUMA_HYBRID (see numa_place_graph()). The placement is not included in 
+			the exec time and the graph is interleaved again at the end (see numa_restore_graph()).
+		bits 4-5: huge pages kind (LL_HUGE_PAGES_*, see numa_alloc_interleaved_huge()) of the vertex arrays.
+			The cc array is at most THP-backed as it is returned and released by numa_free().
+		bit 6: stealing order of threads, LL_STEAL_ORDER_NUMA (default) or LL_STEAL_ORDER_HIERARCHICAL
+			(see dynamic_partitioning_set_steal_order())
+		bit 7: edge tiles in the pull iterations, i.e., partitions split the edges of hubs (see parallel_edge_tiling())
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: push max-degree
+		[9]: partitions per thread (see partitions_plan_decide())
+		[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+		[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
+*/
+IDW_T* IDW_FN(cc_thrifty_400, cc_thrifty_800)(struct par_env* pe, IDW_GRAPH* g, unsigned int flags, unsigned long* exec_info, IDW_T* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_thrifty\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
+		IDW_OFFSETS_SAVED_INIT;
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+	
+	// Allocate memory
+		unsigned int huge_pages = (flags >> 4) & 3U;
+		unsigned int cc_pages = LL_HUGE_PAGES_NONE;
+		IDW_T* cc = numa_alloc_interleaved_huge(sizeof(IDW_T) * g->vertices_count, min(huge_pages, LL_HUGE_PAGES_THP), &cc_pages);
+		assert(cc != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		struct partitions_plan* pp = IDW_FN(partitions_plan_create, partitions_plan_create_800)(pe, g, "cc_thrifty", 64);
+		unsigned int thread_partitions = pp->thread_partitions;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		struct dynamic_partitioning* dp = NULL;
+		IDW_T* partitions = IDW_FN(partitions_cache_get, partitions_cache_get_800)(pe, g, partitions_count, &dp);
+
+	// Edge tiling: as many tiles as partitions, so `dp` also dispenses the tiles
+		IDW_T* tiles_vertices = NULL;
+		unsigned long* tiles_edges = NULL;
+		if((flags >> 7) & 1U)
+		{
+			tiles_vertices = calloc(sizeof(IDW_T), partitions_count + 1);
+			tiles_edges = calloc(sizeof(unsigned long), partitions_count + 1);
+			assert(tiles_vertices != NULL && tiles_edges != NULL);
+			IDW_FN(parallel_edge_tiling, parallel_edge_tiling_800)(g, tiles_vertices, tiles_edges, partitions_count);
+		}
+		dynamic_partitioning_set_steal_order(dp, (flags >> 6) & 1U);
+
+	// NUMA placement
+		unsigned int placement = (flags >> 2) & 3U;
+		unsigned int* partition_owner = NULL;
+		if(placement != LL_NUMA_INTERLEAVE)
+		{
+			unsigned long pt = - get_nano_time();
+			partition_owner = dynamic_partitioning_get_partition_owners(dp);
+			IDW_FN(numa_place_graph, numa_place_graph_800)(pe, placement, g, partitions, partitions_count, partition_owner);
+			IDW_FN(numa_place_vertex_array, numa_place_vertex_array_800)(pe, placement, cc, sizeof(IDW_T), partitions, partitions_count, partition_owner);
+			pt += get_nano_time();
+			t0 -= pt;
+			printf("NUMA placement (%s): 		 %'.1f (ms), not included in the exec. time\n", numa_placement_names[placement], pt/1e6);
+		}
+
+	// Zero Planting: Assigning the zero label to the vertex with max degree
+		unsigned long mt = - get_nano_time();
+		IDW_T max_degree_id = 0;
+		{
+			IDW_T max_vals[2] = {0,0};
+
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				IDW_T thread_max_vals[2] = {0,0};
+				
+				#pragma omp for nowait
+				for(IDW_T v = 0; v < g->vertices_count; v++)
+				{
+					cc[v] = v + 1;
+
+					IDW_T degree = g->offsets_list[v+1] - g->offsets_list[v];
+					if(degree > thread_max_vals[0])
+					{
+						thread_max_vals[0] = degree;
+						thread_max_vals[1] = v;
+					}
+				}
+
+				// Update max_vals
+				#if LL_IDW == 4
+					while(1)
+					{
+						unsigned long prev_val = *(unsigned long*)max_vals;
+						if((unsigned int)prev_val >= thread_max_vals[0])
+							break;
+						__sync_val_compare_and_swap((unsigned long*)max_vals, prev_val, *(unsigned long*)thread_max_vals);
+					}
+				#else
+					// (degree, ID) does not fit in a single 8 Bytes CAS
+					#pragma omp critical
+					if(thread_max_vals[0] > max_vals[0])
+					{
+						max_vals[0] = thread_max_vals[0];
+						max_vals[1] = thread_max_vals[1];
+					}
+				#endif
+
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			if(flags & 1U)
+				IDW_PTIP("Zero Planting:", g->vertices_count + 1);
+			printf("Max. degree: \t %'" IDW_FMT " \t\t (ID: %'" IDW_FMT ")\n", max_vals[0], max_vals[1]);
+			// Plant the zero label
+			cc[max_vals[1]] = 0;
+			max_degree_id = max_vals[1];
+		}
+
+	// Initial Push: Propagate the zero label to the neighbours of the max-degree vertex
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for nowait
+			for(unsigned long e = g->offsets_list[max_degree_id]; e < g->offsets_list[max_degree_id + 1]; e++)
+				cc[g->edges_list[e]] = 0;
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("Initial Push:");
+
+	// Pull iterations with Zero Convergence: 
+		// If a vertex has reached zero label, its label cannot be reduced => do not process it.
+		// The iterations are executed by the persistent workers of `rt` (see runtime.c), and the last thread 
+		// of each iteration resets `dp` and evaluates the frontier density.
+		struct par_runtime* rt = par_runtime_get(pe);
+		par_runtime_reset_stats(rt);
+		double frontier_density = 0;
+		IDW_T next_vertices = 0;
+		unsigned long next_edges = 0;
+		unsigned int cc_iter = 0;
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			do
+			{
+				ttimes[tid] = - get_nano_time();
+				IDW_T thread_next_vertices = 0;
+				unsigned long thread_next_edges = 0;
+				unsigned int partition = -1U;		
+				
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					if(tiles_vertices == NULL)
+						for(IDW_T v = partitions[partition]; v < partitions[partition + 1]; v++)
+						{
+							IDW_T component = cc[v];
+							// Zero Convergence
+							if(!component)
+								continue;
+
+							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							{
+								IDW_T neighbour = g->edges_list[e];
+								if(cc[neighbour] < component)
+								{
+									component = cc[neighbour];
+									// Zero Convergence
+									if(!component)
+										break;
+								}
+							}
+
+							if(component < cc[v])
+							{
+								cc[v] = component;
+								thread_next_vertices++;
+								thread_next_edges += g->offsets_list[v+1] - g->offsets_list[v];
+							}
+						}
+					else
+						for(IDW_T v = tiles_vertices[partition]; v <= tiles_vertices[partition + 1] && v < g->vertices_count; v++)
+						{
+							unsigned long e_start = v == tiles_vertices[partition] ? tiles_edges[partition] : g->offsets_list[v];
+							unsigned long e_end = v == tiles_vertices[partition + 1] ? tiles_edges[partition + 1] : g->offsets_list[v + 1];
+							if(v == tiles_vertices[partition + 1] && e_end == g->offsets_list[v])
+								break;
+
+							IDW_T component = cc[v];
+							// Zero Convergence
+							if(!component)
+								continue;
+
+							for(unsigned long e = e_start; e < e_end; e++)
+							{
+								IDW_T neighbour = g->edges_list[e];
+								if(cc[neighbour] < component)
+								{
+									component = cc[neighbour];
+									// Zero Convergence
+									if(!component)
+										break;
+								}
+							}
+
+							// The tiles of a split hub are combined by atomic min and each tile counts its own edges 
+							if(e_start != g->offsets_list[v] || e_end != g->offsets_list[v + 1])
+							{
+								if(IDW_FN(edge_tiles_reduce_min, edge_tiles_reduce_min_800)(cc, v, component))
+								{
+									thread_next_vertices++;
+									thread_next_edges += e_end - e_start;
+								}
+							}
+							else if(component < cc[v])
+							{
+								cc[v] = component;
+								thread_next_vertices++;
+								thread_next_edges += e_end - e_start;
+							}
+						}
+				}
+
+				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
+				__sync_fetch_and_add(&next_edges, thread_next_edges, __ATOMIC_SEQ_CST);
+				
+				ttimes[tid] += get_nano_time();
+
+				if(par_runtime_barrier(rt))
+				{
+					mt += get_nano_time();
+					dynamic_partitioning_reset(dp);
+					partitions_plan_add_step(pp, mt, ttimes, pe->threads_count);
+
+					frontier_density = 1.0 * (next_vertices + next_edges) / g->edges_count;
+					if(flags & 1U)
+					{
+						char temp[255];
+						if(next_vertices < 100)
+							sprintf(temp, "Pull %'3u, |F|: %5" IDW_FMT ", Dns: %'5.2f, time:", cc_iter, next_vertices, frontier_density);
+						else
+							sprintf(temp, "Pull %'3u, |F|: %'4.1f%, Dns: %'5.2f, time:", cc_iter, 100.0 * next_vertices/g->vertices_count, frontier_density);
+						IDW_PTIP(temp, g->vertices_count + 1);
+					}
+					cc_iter++;
+
+					// The `next_vertices` of the last pull iteration is used to allocate the worklists
+					if(frontier_density >= 0.01)
+					{
+						next_vertices = 0;
+						next_edges = 0;
+					}
+
+					mt = - get_nano_time();
+					par_runtime_barrier_release(rt);
+				}
+			}while(frontier_density >= 0.01);
+		}
+
+	// Allocating memory for the shared worklists
+		/*
+			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
+			Since push iterations are sparse, we dedicate a chunk (with a size of cacheline, i.e., 16 uints) to each thread and after filling it we allocate another chunk. This way, we do not need to allocate per thread worklist. 
+			
+			The another point is about tiling. The initial implementation of thrifty used the 
+			edge-tiling [Galois, DOI:10.1145/2517349.2522739] in the push iterations to allow
+			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
+			push direction, we do not expect to see very high degree vertices and we do not use edge-tiling in this implementation. 
+
+			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
+			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
+			
+			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
+			previously stored in the worklist. We do not use atomics for accessing `df` as it is correct to process a 
+			vertex multiple times in a CC iteration. 
+		*/
+
+		unsigned int waspr = 16;  // worklist_allocation_size_per_request
+		IDW_T worklist_size = max(2 * next_vertices + waspr * pe->threads_count, (IDW_T)1024 * 1024);
+		
+		IDW_T* worklist = numa_alloc_interleaved(sizeof(IDW_T) * worklist_size);
+		IDW_T worklist_length = waspr * pe->threads_count;				 // initial allocation per thread
+		
+		IDW_T* next_worklist = numa_alloc_interleaved(sizeof(IDW_T) * worklist_size);
+		IDW_T next_worklist_length = waspr * pe->threads_count;    // initial allocation per thread
+
+		unsigned int df_pages = LL_HUGE_PAGES_NONE;
+		unsigned int next_df_pages = LL_HUGE_PAGES_NONE;
+		unsigned char* df = numa_alloc_interleaved_huge(sizeof(unsigned char) * g->vertices_count, huge_pages, &df_pages);
+		unsigned char* next_df = numa_alloc_interleaved_huge(sizeof(unsigned char) * g->vertices_count, huge_pages, &next_df_pages);
+		assert(worklist != NULL && next_worklist != NULL && df != NULL && next_df != NULL);
+		if(partition_owner != NULL)
+		{
+			// Worklists are shared by all threads and remain interleaved
+			IDW_FN(numa_place_vertex_array, numa_place_vertex_array_800)(pe, placement, df, sizeof(unsigned char), partitions, partitions_count, partition_owner);
+			IDW_FN(numa_place_vertex_array, numa_place_vertex_array_800)(pe, placement, next_df, sizeof(unsigned char), partitions, partitions_count, partition_owner);
+		}
+
+	// Pull-Frontier and push iterations, executed by the persistent workers of `rt`
+		IDW_T push_max_degree = 0;
+		IDW_T push_vertices = 0;
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+
+			// Pull-Frontier: One more pull iteration to store active vertices into worklist
+			{
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;		
+
+				IDW_T thread_worklist_index = tid * waspr;
+				IDW_T thread_worklist_end = (tid + 1) * waspr;
+			
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(IDW_T v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						IDW_T component = cc[v];
+						// Zero Convergence
+						if(!component)
+							continue;
+
+						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+						{
+							IDW_T neighbour = g->edges_list[e];
+							if(cc[neighbour] < component)
+							{
+								component = cc[neighbour];
+								// Zero Convergence
+								if(!component)
+									break;
+							}
+						}
+
+						// if new label has been found
+						if(component < cc[v])
+						{
+							cc[v] = component;
+
+							// set the frontier
+							if(df[v])
+								continue;
+
+							// add to worklist
+							df[v] = 1;
+							worklist[thread_worklist_index++] = v;
+							if(thread_worklist_index == thread_worklist_end)
+							{
+								// grab a new chunk
+								do
+								{
+									thread_worklist_index = worklist_length;
+									thread_worklist_end = thread_worklist_index + waspr;
+								}while(__sync_val_compare_and_swap(&worklist_length, thread_worklist_index, thread_worklist_end) != thread_worklist_index);
+								assert(worklist_length <= worklist_size);
+							}
+						}
+					}
+				}
+
+				// fill unused indecis with -1U to prevent from being processed in the next iteration
+				while(thread_worklist_index < thread_worklist_end)
+					worklist[thread_worklist_index++] = IDW_NONE;
+
+				ttimes[tid] += get_nano_time();
+
+				if(par_runtime_barrier(rt))
+				{
+					mt += get_nano_time();
+					dynamic_partitioning_reset(dp);
+					partitions_plan_add_step(pp, mt, ttimes, pe->threads_count);
+
+					if(flags & 1U)
+					{
+						char temp[255];
+						sprintf(temp, "Pull-Frontier, |F|: %'" IDW_FMT ", time:", worklist_length);
+						IDW_PTIP(temp, g->vertices_count + 1);
+					}
+					cc_iter++;
+					next_vertices = 0;
+
+					mt = - get_nano_time();
+					par_runtime_barrier_release(rt);
+				}
+			}
+
+			// Push iterations
+			do
+			{
+				ttimes[tid] = - get_nano_time();
+			
+				IDW_T thread_next_worklist_index = tid * waspr;
+				IDW_T thread_next_worklist_end = (tid + 1) * waspr;
+				IDW_T thread_next_vertices = 0;
+				IDW_T thread_push_max_degree = 0;
+
+				#pragma omp for nowait
+				for(IDW_T index = 0; index < worklist_length; index++)
+				{
+					if(worklist[index] == IDW_NONE)
+						continue;
+
+					IDW_T v = worklist[index];
+					if(df[v] == 0)
+						continue;
+					df[v] = 0;
+
+					IDW_T degree = g->offsets_list[v+1] - g->offsets_list[v];
+					if(degree > thread_push_max_degree)
+						thread_push_max_degree = degree;
+
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v+1]; e++)
+					{
+						IDW_T neighbour = g->edges_list[e];
+						unsigned int changed = 0;
+
+						while(1)
+						{
+							IDW_T cc_neighbour = cc[neighbour];
+							IDW_T cc_v = cc[v];
+							if(cc_neighbour <= cc_v)
+								break;
+
+							IDW_T prev_val = __sync_val_compare_and_swap(&cc[neighbour], cc_neighbour, cc_v);
+							if(prev_val == cc_neighbour)
+							{
+								changed = 1;
+								break;
+							}
+						}
+
+						if(!changed)
+							continue;
+
+						if(next_df[neighbour])
+							continue;
+
+						next_df[neighbour] = 1;
+						thread_next_vertices++;
+						next_worklist[thread_next_worklist_index++] = neighbour;
+						if(thread_next_worklist_index == thread_next_worklist_end)
+						{
+							// grab a new chunk
+							do
+							{
+								thread_next_worklist_index = next_worklist_length;
+								thread_next_worklist_end = thread_next_worklist_index + waspr;
+							}while(__sync_val_compare_and_swap(&next_worklist_length, thread_next_worklist_index, thread_next_worklist_end) != thread_next_worklist_index);
+							assert(next_worklist_length <= worklist_size);
+						}
+					}
+				}	
+
+				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
+
+				// Update push_max_degree
+				IDW_T prev_max = __atomic_load_n(&push_max_degree, __ATOMIC_RELAXED);
+				while(thread_push_max_degree > prev_max)
+					if(__atomic_compare_exchange_n(&push_max_degree, &prev_max, thread_push_max_degree, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+						break;
+
+				// fill unused indecis with -1U to prevent from being processed in the next iteration
+				while(thread_next_worklist_index < thread_next_worklist_end)
+					next_worklist[thread_next_worklist_index++] = IDW_NONE;
+
+				ttimes[tid] += get_nano_time();
+
+				if(par_runtime_barrier(rt))
+				{
+					mt += get_nano_time();
+					if(flags & 1U)
+					{
+						char temp[255];
+						sprintf(temp, "Push, |F|: %5" IDW_FMT ", time:", next_vertices);
+						IDW_PTIP(temp, 2 * worklist_length);
+					}
+					cc_iter++;
+
+					// swapping
+						{
+							IDW_T* temp = worklist;
+							worklist = next_worklist;
+							next_worklist = temp;
+
+							worklist_length = next_worklist_length;
+							next_worklist_length = waspr * pe->threads_count;
+
+							unsigned char* temp2 = df;
+							df = next_df;
+							next_df = temp2;
+
+							unsigned int temp3 = df_pages;
+							df_pages = next_df_pages;
+							next_df_pages = temp3;
+						}
+
+					push_vertices = next_vertices;
+					next_vertices = 0;
+
+					mt = - get_nano_time();
+					par_runtime_barrier_release(rt);
+				}
+			}while(push_vertices);
+		}
+		if(flags & 1U)
+		{
+			printf("Max-degree in push iterations: \t\t%'" IDW_FMT "\n", push_max_degree);
+			par_runtime_print_stats(rt);
+		}
+		if(exec_info)
+			exec_info[8] = push_max_degree;
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			IDW_T ccs = 1;
+			#pragma omp parallel for reduction(+:ccs)
+			for(IDW_T v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v + 1)
+					ccs++;
+			printf("|CCs|:            \t\t%'" IDW_FMT "\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Huge pages
+		if((flags & 1U) && huge_pages != LL_HUGE_PAGES_NONE)
+		{
+			print_huge_pages_stats("cc:", cc, sizeof(IDW_T) * g->vertices_count, cc_pages);
+			print_huge_pages_stats("df:", df, sizeof(unsigned char) * g->vertices_count, df_pages);
+		}
+
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		IDW_OFFSETS_SAVED_PRINT();
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[9] = pp->thread_partitions;
+		}
+
+	// Restoring the interleaved placement of the graph
+		if(placement != LL_NUMA_INTERLEAVE)
+			IDW_FN(numa_restore_graph, numa_restore_graph_800)(placement, g);
+
+	// Releasing memory
+		partitions_cache_put(partitions, dp);
+		partitions = NULL;
+		dp = NULL;
+		if(tiles_vertices != NULL)
+		{
+			free(tiles_vertices);
+			tiles_vertices = NULL;
+			free(tiles_edges);
+			tiles_edges = NULL;
+		}
+		if(partition_owner != NULL)
+		{
+			free(partition_owner);
+			partition_owner = NULL;
+		}
+		free(ttimes);
+		ttimes = NULL;
+		partitions_plan_release(pp);
+		pp = NULL;
+		numa_free(worklist, sizeof(IDW_T) * worklist_size);
+		worklist = NULL;
+		numa_free(next_worklist, sizeof(IDW_T) * worklist_size);
+		next_worklist = NULL;
+		numa_free_huge(df, sizeof(unsigned char) * g->vertices_count, df_pages);
+		df = NULL;
+		numa_free_huge(next_df, sizeof(unsigned char) * g->vertices_count, next_df_pages);
+		next_df = NULL;
+
+	return cc;
+}
+
+void IDW_FN(cc_release, cc_release_800)(IDW_GRAPH* g, IDW_T* cc)
+{
+	assert(cc != NULL && g != NULL);
+	numa_free(cc, sizeof(IDW_T) * g->vertices_count);
+	return;
+}
+
+/*
+	An implementation of a Disjoint-Set Union CC 
+	introduced by Siddhartha Jayanti and Robert Tarjan in the following paper
+
+	@article{ DBLP:journals/corr/JayantiT16,
+	author    = {Siddhartha V. Jayanti and Robert E. Tarjan},
+	title     = {A Randomized Concurrent Algorithm for Disjoint Set Union},
+	journal   = {CoRR},
+	volume    = {abs/1612.01514},
+	year      = {2016},
+	url       = {http://arxiv.org/abs/1612.01514},
+	eprinttype = {arXiv},
+	eprint    = {1612.01514},
+	}
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+		[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
+*/
+
+IDW_T* IDW_FN(cc_jt, cc_jt_800)(struct par_env* pe, IDW_GRAPH* g, unsigned int flags, unsigned long* exec_info, IDW_T* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_jt\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
+		IDW_OFFSETS_SAVED_INIT;
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+	
+	// Allocate memory
+		IDW_T* cc = numa_alloc_interleaved(sizeof(IDW_T) * g->vertices_count);
+		assert(cc != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		struct dynamic_partitioning* dp = NULL;
+		IDW_T* partitions = IDW_FN(partitions_cache_get, partitions_cache_get_800)(pe, g, partitions_count, &dp);
+
+	// (1) Initializing
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(IDW_T v = partitions[partition]; v < partitions[partition + 1]; v++)
+					cc[v] = v;
+				
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+			PTIP("(1) Initializing");
+
+	// (2) Traversing edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(IDW_T v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						IDW_T neighbour = g->edges_list[e];
+						if(neighbour >= v)
+							break;
+
+						IDW_T x = v;
+						IDW_T y = neighbour;
+
+						while(1)
+						{
+							while(x != cc[x])
+								x = cc[x];
+
+							while(y != cc[y])
+								y = cc[y];
+
+							if(x == y)
+								break;
+
+							if(x < y)
+							{
+								if(__sync_bool_compare_and_swap(&cc[y], y, x))
+									break;
+							}
+							else
+							{
+								if(__sync_bool_compare_and_swap(&cc[x], x, y))
+									break;
+							}
+
+						}
+					}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+			IDW_PTIP("(2) Traversing edges:", g->vertices_count + 1);
+
+	// (3) Pointer jumping
+		mt = - get_nano_time();
+		#pragma omp parallel   
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for 
+			for(IDW_T v = 0; v < g->vertices_count; v++)
+				while(cc[cc[v]] != cc[v])
+					cc[v] = cc[cc[v]];
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(3) Pointer jumping:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			IDW_T ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(IDW_T v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'" IDW_FMT "\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		IDW_OFFSETS_SAVED_PRINT();
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	// Releasing memory
+		partitions_cache_put(partitions, dp);
+		partitions = NULL;
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+	
+	return cc;
+}
@@ -0,0 +1,316 @@
+#ifndef __COMPRESSED_GRAPH_C
+#define __COMPRESSED_GRAPH_C
+
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "omp.c"
+#include "graph.c"
+#include "partitioning.c"
+
+/*
+	Compressed 4 Bytes ID graph, without weights on edges or vertices
+
+	The neighbour-list of each vertex is stored in `bytes_list` starting from `offsets_list[v]` as
+	a sequence of varints (LEB128, 7 bits per byte, the most significant bit shows if the next byte belongs to the same number):
+		- the degree of the vertex,
+		- the zigzag-encoded difference between the first neighbour and the vertex ID, and
+		- the zigzag-encoded difference between each neighbour and its previous neighbour.
+
+	The order of neighbours is preserved. Graphs with sorted neighbour-lists (e.g., the output of
+	`symmetrize_graph()` with bit 1 of flags) have smaller differences and are compressed better.
+*/
+struct ll_400_cgraph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long bytes_count;
+	unsigned long* offsets_list;
+	unsigned char* bytes_list;
+};
+
+#define LL_CG_READ_VARINT(__p, __val) \
+	{ \
+		unsigned char __b = *(__p)++; \
+		__val = __b & 127UL; \
+		unsigned int __s = 7; \
+		while(__b & 128U) \
+		{ \
+			__b = *(__p)++; \
+			__val |= (__b & 127UL) << __s; \
+			__s += 7; \
+		} \
+	}
+
+#define LL_CG_ZIGZAG_DECODE(__val) (((__val) >> 1) ^ -((__val) & 1UL))
+#define LL_CG_ZIGZAG_ENCODE(__diff) ( ((unsigned long)(__diff) << 1) ^ (unsigned long)((long)(__diff) >> 63) )
+
+/*
+	Reads the next neighbour of a vertex. `__neighbour` is an `unsigned long` that 
+	should be initialized to the vertex ID before reading the first neighbour.
+*/
+#define LL_CG_READ_NEIGHBOUR(__p, __neighbour) \
+	{ \
+		unsigned long __z; \
+		LL_CG_READ_VARINT(__p, __z); \
+		__neighbour += LL_CG_ZIGZAG_DECODE(__z); \
+	}
+
+unsigned int __ll_cg_varint_length(unsigned long val)
+{
+	unsigned int length = 1;
+	while(val >= 128)
+	{
+		val >>= 7;
+		length++;
+	}
+
+	return length;
+}
+
+unsigned char* __ll_cg_write_varint(unsigned char* p, unsigned long val)
+{
+	while(val >= 128)
+	{
+		*p++ = (unsigned char)(val | 128U);
+		val >>= 7;
+	}
+	*p++ = (unsigned char)val;
+
+	return p;
+}
+
+unsigned int ll_400_cgraph_degree(struct ll_400_cgraph* g, unsigned int v)
+{
+	unsigned char* p = g->bytes_list + g->offsets_list[v];
+	unsigned long degree;
+	LL_CG_READ_VARINT(p, degree);
+
+	return degree;
+}
+
+/*
+	Creates the compressed graph of `g` in parallel:
+		(1) the compressed size of each vertex is calculated and stored in `offsets_list[v + 1]`,
+		(2) the prefix sum of sizes is calculated per partition and the partial sums are propagated,
+		(3) neighbour-lists are encoded.
+
+	flags:
+		bit 0: validate the compressed graph by decoding it
+*/
+struct ll_400_cgraph* compress_ll_400_graph(struct par_env* pe, struct ll_400_graph* g, unsigned int flags)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;35mcompress_ll_400_graph\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
+
+	// Allocating memory
+		struct ll_400_cgraph* cg = calloc(sizeof(struct ll_400_cgraph), 1);
+		assert(cg != NULL);
+		cg->vertices_count = g->vertices_count;
+		cg->edges_count = g->edges_count;
+		cg->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(cg->offsets_list != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(g, partitions, partitions_count);
+		unsigned long* partitions_bytes = calloc(sizeof(unsigned long), partitions_count + 1);
+		assert(partitions_bytes != NULL);
+
+	// (1) Calculating compressed size of vertices
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for nowait schedule(dynamic, 1)
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long partition_bytes = 0;
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				{
+					unsigned long bytes = __ll_cg_varint_length(g->offsets_list[v + 1] - g->offsets_list[v]);
+					long prev = v;
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						long neighbour = g->edges_list[e];
+						bytes += __ll_cg_varint_length(LL_CG_ZIGZAG_ENCODE(neighbour - prev));
+						prev = neighbour;
+					}
+					cg->offsets_list[v + 1] = bytes;
+					partition_bytes += bytes;
+				}
+				partitions_bytes[p + 1] = partition_bytes;
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(1) Calculating sizes");
+
+	// (2) Prefix sum
+		mt = - get_nano_time();
+		for(unsigned int p = 0; p < partitions_count; p++)
+			partitions_bytes[p + 1] += partitions_bytes[p];
+		cg->bytes_count = partitions_bytes[partitions_count];
+
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for nowait schedule(dynamic, 1)
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long offset = partitions_bytes[p];
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				{
+					unsigned long bytes = cg->offsets_list[v + 1];
+					cg->offsets_list[v] = offset;
+					offset += bytes;
+				}
+				assert(offset == partitions_bytes[p + 1]);
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		cg->offsets_list[g->vertices_count] = cg->bytes_count;
+		mt += get_nano_time();
+		PTIP("(2) Prefix sum");
+
+		cg->bytes_list = numa_alloc_interleaved(sizeof(unsigned char) * max(cg->bytes_count, 1UL));
+		assert(cg->bytes_list != NULL);
+
+	// (3) Encoding
+		mt = - get_nano_time();
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for nowait schedule(dynamic, 1)
+			for(unsigned int p = 0; p < partitions_count; p++)
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				{
+					unsigned char* bp = cg->bytes_list + cg->offsets_list[v];
+					bp = __ll_cg_write_varint(bp, g->offsets_list[v + 1] - g->offsets_list[v]);
+					long prev = v;
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						long neighbour = g->edges_list[e];
+						bp = __ll_cg_write_varint(bp, LL_CG_ZIGZAG_ENCODE(neighbour - prev));
+						prev = neighbour;
+					}
+					assert(bp == cg->bytes_list + cg->offsets_list[v + 1]);
+				}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(3) Encoding");
+
+	// Validation
+		if(flags & 1U)
+		{
+			mt = - get_nano_time();
+			unsigned long errors = 0;
+			#pragma omp parallel reduction(+:errors)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+
+				#pragma omp for nowait schedule(dynamic, 1)
+				for(unsigned int p = 0; p < partitions_count; p++)
+					for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+					{
+						if(ll_400_cgraph_degree(cg, v) != g->offsets_list[v + 1] - g->offsets_list[v])
+						{
+							errors++;
+							continue;
+						}
+
+						unsigned char* bp = cg->bytes_list + cg->offsets_list[v];
+						unsigned long degree;
+						LL_CG_READ_VARINT(bp, degree);
+						unsigned long neighbour = v;
+						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+						{
+							LL_CG_READ_NEIGHBOUR(bp, neighbour);
+							if(neighbour != g->edges_list[e])
+								errors++;
+						}
+						if(bp != cg->bytes_list + cg->offsets_list[v + 1])
+							errors++;
+					}
+
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			PTIP("Validation");
+			assert(errors == 0);
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		free(partitions_bytes);
+		partitions_bytes = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Compressed |E|: %'lu, bytes: %'lu (%.2f Bytes per edge, %.2fx smaller edges list)\n",
+			cg->edges_count, cg->bytes_count, 1.0 * cg->bytes_count / max(cg->edges_count, 1UL),
+			4.0 * cg->edges_count / max(cg->bytes_count, 1UL));
+		printf("Total time: \t\t\t %'.3f (s)\n\n", t0/1e9);
+
+	return cg;
+}
+
+void release_numa_interleaved_ll_400_cgraph(struct ll_400_cgraph* g)
+{
+	assert(g != NULL && g->offsets_list != NULL);
+
+	numa_free(g->offsets_list, sizeof(unsigned long) * (1 + g->vertices_count));
+	g->offsets_list = NULL;
+
+	if(g->bytes_list)
+	{
+		numa_free(g->bytes_list, sizeof(unsigned char) * max(g->bytes_count, 1UL));
+		g->bytes_list = NULL;
+	}
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
+/*
+	Edge partitioning of the compressed graph using the number of bytes as the load of each vertex,
+	as decoding cost is proportional to the bytes.
+*/
+int ll_400_cgraph_partitioning(struct ll_400_cgraph* g, unsigned int* borders, int partitions)
+{
+	struct ll_400_graph bg = {g->vertices_count, g->bytes_count, g->offsets_list, NULL};
+
+	return parallel_edge_partitioning(&bg, borders, partitions);
+}
+
+#endif
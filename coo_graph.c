@@ -0,0 +1,870 @@
+#ifndef __COO_GRAPH_C
+#define __COO_GRAPH_C
+
+/*
+	Loading graphs stored as lists of edges (COO), i.e., SNAP edge lists and Matrix Market (`.mtx`) files.
+
+	A SNAP edge list has one edge per line as `source destination [weight]`, separated by spaces or tabs.
+	Lines starting with `#` are comments. The IDs are 0-based and |V| is the largest ID plus one.
+
+	A Matrix Market file starts with the `%%MatrixMarket matrix coordinate <field> <symmetry>` banner,
+	followed by comment lines starting with `%`, the `rows columns entries` line, and the entries as
+	`row column [value]` with 1-based IDs. The `pattern`, `integer`, and `real` fields are supported and
+	real values are rounded to the nearest `uint` weight. For `symmetric`, `skew-symmetric`, and `hermitian`
+	matrices, only one triangle is stored in the file and the mirrored edges are added to the graph.
+
+	Files ending with `.gz` are decompressed by zlib, and files ending with `.zst` by libzstd if
+	compiled with `-D_ZSTD_SUPPORT` (`make zstd=1`).
+
+	The file is read in windows. Each window is cut at its last line break and its lines are counted and
+	parsed by all threads into the COO arrays. The CSR graph is then created by a parallel counting sort of
+	the edges by their sources (degree counting, prefix sum, and atomic scattering, similar to atomic_transpose()).
+*/
+
+#include <zlib.h>
+#ifdef _ZSTD_SUPPORT
+	#include <zstd.h>
+#endif
+
+#include "omp.c"
+#include "graph.c"
+
+#define LL_COO_SNAP 0U
+#define LL_COO_MTX  1U
+
+struct __ll_coo_reader
+{
+	char* file_name;
+	unsigned int compression;         // 0: none, 1: gzip, 2: zstd
+	unsigned long file_size;
+	unsigned long offset;             // offset of the next window in the (uncompressed) file
+	unsigned long read_bytes;         // total bytes passed to the parser
+	unsigned int eof;
+
+	char* mem;                        // window_size + 2 * 4096 Bytes, as required by par_read_file()
+	unsigned long window_size;
+	char* window;
+	unsigned long window_length;
+
+	gzFile gz;
+#ifdef _ZSTD_SUPPORT
+	FILE* zst_file;
+	ZSTD_DCtx* zst_dctx;
+	ZSTD_inBuffer zst_in;
+	void* zst_in_mem;
+	unsigned long zst_in_size;
+#endif
+};
+
+int __ll_coo_has_suffix(char* file_name, char* suffix)
+{
+	unsigned long fl = strlen(file_name);
+	unsigned long sl = strlen(suffix);
+
+	return fl >= sl && strcmp(file_name + fl - sl, suffix) == 0;
+}
+
+struct __ll_coo_reader* __ll_coo_reader_open(char* file_name)
+{
+	struct __ll_coo_reader* r = calloc(sizeof(struct __ll_coo_reader), 1);
+	assert(r != NULL);
+
+	r->file_name = file_name;
+	r->file_size = get_file_size(file_name);
+	r->window_size = 4096UL * 1024 * 256;
+	r->mem = numa_alloc_interleaved(r->window_size + 2 * 4096);
+	assert(r->mem != NULL);
+
+	if(__ll_coo_has_suffix(file_name, ".gz"))
+	{
+		r->compression = 1;
+		r->gz = gzopen(file_name, "rb");
+		assert(r->gz != NULL);
+		gzbuffer(r->gz, 1U << 20);
+	}
+	else if(__ll_coo_has_suffix(file_name, ".zst"))
+	{
+	#ifdef _ZSTD_SUPPORT
+		r->compression = 2;
+		r->zst_file = fopen(file_name, "rb");
+		assert(r->zst_file != NULL);
+		r->zst_dctx = ZSTD_createDCtx();
+		assert(r->zst_dctx != NULL);
+		r->zst_in_size = max(ZSTD_DStreamInSize(), 1UL << 20);
+		r->zst_in_mem = malloc(r->zst_in_size);
+		assert(r->zst_in_mem != NULL);
+		r->zst_in.src = r->zst_in_mem;
+		r->zst_in.size = 0;
+		r->zst_in.pos = 0;
+	#else
+		printf("Error: \"%s\" is compressed by zstd, please compile with `zstd=1`.\n", file_name);
+		numa_free(r->mem, r->window_size + 2 * 4096);
+		r->mem = NULL;
+		free(r);
+		return NULL;
+	#endif
+	}
+
+	return r;
+}
+
+void __ll_coo_reader_close(struct __ll_coo_reader* r)
+{
+	assert(r != NULL);
+
+	if(r->compression == 1)
+	{
+		gzclose(r->gz);
+		r->gz = NULL;
+	}
+#ifdef _ZSTD_SUPPORT
+	if(r->compression == 2)
+	{
+		ZSTD_freeDCtx(r->zst_dctx);
+		r->zst_dctx = NULL;
+		fclose(r->zst_file);
+		r->zst_file = NULL;
+		free(r->zst_in_mem);
+		r->zst_in_mem = NULL;
+	}
+#endif
+
+	numa_free(r->mem, r->window_size + 2 * 4096);
+	r->mem = NULL;
+	r->window = NULL;
+	free(r);
+
+	return;
+}
+
+/*
+	Reads the next window. The last `carry` Bytes of the current window (i.e., an incomplete line) are
+	placed at the beginning of the next window. The window is terminated by a `\0`.
+
+	Returns the length of the window, or 0 if the file has been completely read.
+*/
+unsigned long __ll_coo_reader_next(struct __ll_coo_reader* r, unsigned long carry)
+{
+	assert(carry <= r->window_length);
+
+	if(r->compression == 0)
+	{
+		// Uncompressed files are read in parallel and the carried bytes are read again
+		r->offset -= carry;
+		if(r->offset >= r->file_size)
+		{
+			r->eof = 1;
+			r->window_length = 0;
+			return 0;
+		}
+
+		unsigned long end = min(r->offset + r->window_size, r->file_size);
+		r->window = par_read_file(r->file_name, r->offset, end, r->mem);
+		r->window_length = end - r->offset;
+		r->offset = end;
+		r->eof = end == r->file_size;
+	}
+	else
+	{
+		// Moving the carried bytes to the beginning of the window and decompressing the next bytes
+		if(carry)
+			memmove(r->mem, r->window + r->window_length - carry, carry);
+		r->window = r->mem;
+
+		unsigned long length = carry;
+		while(length < r->window_size && !r->eof)
+		{
+			if(r->compression == 1)
+			{
+				int ret = gzread(r->gz, r->mem + length, min(r->window_size - length, 1UL << 30));
+				if(ret < 0)
+				{
+					int errnum = 0;
+					printf("Error: decompressing \"%s\": %s\n", r->file_name, gzerror(r->gz, &errnum));
+					assert(ret >= 0);
+				}
+				if(ret == 0)
+					r->eof = 1;
+				length += ret;
+			}
+		#ifdef _ZSTD_SUPPORT
+			if(r->compression == 2)
+			{
+				if(r->zst_in.pos == r->zst_in.size)
+				{
+					unsigned long ret = fread(r->zst_in_mem, 1, r->zst_in_size, r->zst_file);
+					if(ret == 0)
+					{
+						r->eof = 1;
+						break;
+					}
+					r->zst_in.size = ret;
+					r->zst_in.pos = 0;
+				}
+
+				ZSTD_outBuffer out = {r->mem + length, r->window_size - length, 0};
+				unsigned long ret = ZSTD_decompressStream(r->zst_dctx, &out, &r->zst_in);
+				if(ZSTD_isError(ret))
+				{
+					printf("Error: decompressing \"%s\": %s\n", r->file_name, ZSTD_getErrorName(ret));
+					assert(!ZSTD_isError(ret));
+				}
+				length += out.pos;
+			}
+		#endif
+		}
+
+		r->window_length = length;
+		r->offset += length - carry;
+	}
+
+	r->window[r->window_length] = 0;
+
+	return r->window_length;
+}
+
+/*
+	Parses the Matrix Market banner, comments, and size line at the beginning of `buf`.
+	Returns the length of the header, or -1UL if `buf` does not start with a valid banner.
+*/
+unsigned long __ll_coo_mtx_read_header(char* buf, unsigned long length, unsigned int* is_symmetric,
+	unsigned int* has_values, unsigned long* vertices_count, unsigned long* entries_count)
+{
+	char object[64] = {0}, format[64] = {0}, field[64] = {0}, symmetry[64] = {0};
+	if(sscanf(buf, "%%%%MatrixMarket %63s %63s %63s %63s", object, format, field, symmetry) != 4)
+	{
+		printf("Error: cannot read the Matrix Market banner.\n");
+		return -1UL;
+	}
+
+	if(strcasecmp(object, "matrix") || strcasecmp(format, "coordinate"))
+	{
+		printf("Error: only the \"matrix coordinate\" Matrix Market files are supported.\n");
+		return -1UL;
+	}
+
+	if(!strcasecmp(field, "pattern"))
+		*has_values = 0;
+	else if(!strcasecmp(field, "integer") || !strcasecmp(field, "real"))
+		*has_values = 1;
+	else
+	{
+		printf("Error: Matrix Market field \"%s\" is not supported.\n", field);
+		return -1UL;
+	}
+
+	if(!strcasecmp(symmetry, "general"))
+		*is_symmetric = 0;
+	else if(!strcasecmp(symmetry, "symmetric") || !strcasecmp(symmetry, "skew-symmetric") || !strcasecmp(symmetry, "hermitian"))
+		*is_symmetric = 1;
+	else
+	{
+		printf("Error: Matrix Market symmetry \"%s\" is not supported.\n", symmetry);
+		return -1UL;
+	}
+
+	// Skipping the banner and comments
+	unsigned long i = 0;
+	while(i < length && (buf[i] == '%' || buf[i] == '\n' || buf[i] == '\r'))
+	{
+		while(i < length && buf[i] != '\n')
+			i++;
+		i++;
+	}
+
+	// The size line
+	unsigned long rows = 0, columns = 0;
+	if(i >= length || sscanf(buf + i, "%lu %lu %lu", &rows, &columns, entries_count) != 3)
+	{
+		printf("Error: cannot read the size line of the Matrix Market file.\n");
+		return -1UL;
+	}
+	*vertices_count = max(rows, columns);
+
+	while(i < length && buf[i] != '\n')
+		i++;
+
+	return min(i + 1, length);
+}
+
+/*
+	Reads the edges of a SNAP or Matrix Market file (and the weights if `weights` is not NULL) into the
+	COO arrays that are (re)allocated by this function.
+
+	Returns the number of edges. The number of allocated elements of the COO arrays are written to `*coo_capacity`.
+*/
+unsigned long __ll_coo_read(char* file_name, unsigned int* type, unsigned int* is_symmetric, unsigned long* vertices_count,
+	unsigned int** sources, unsigned int** destinations, unsigned int** weights, unsigned long* coo_capacity)
+{
+	struct __ll_coo_reader* cr = __ll_coo_reader_open(file_name);
+	if(cr == NULL)
+		return -1UL;
+
+	unsigned int ranges_count = omp_get_max_threads() * 16;
+	unsigned long* ranges_start = calloc(sizeof(unsigned long), ranges_count + 1);
+	unsigned long* ranges_index = calloc(sizeof(unsigned long), ranges_count + 1);
+	assert(ranges_start != NULL && ranges_index != NULL);
+
+	#define __LL_COO_IS_DIGIT(c) ((unsigned char)((c) - '0') < 10)
+	#define __LL_COO_IS_SEP(c) ((c) == ' ' || (c) == '\t' || (c) == ',')
+
+	unsigned int has_values = 0;
+	unsigned long entries_count = -1UL;
+	unsigned int base = 0;
+	*type = LL_COO_SNAP;
+	*is_symmetric = 0;
+	*vertices_count = 0;
+
+	unsigned long edges_count = 0;
+	unsigned long capacity = 0;
+	unsigned int* src = NULL;
+	unsigned int* dest = NULL;
+	unsigned int* w = NULL;
+	unsigned long max_id = 0;
+	unsigned long errors = 0;
+
+	unsigned long carry = 0;
+	unsigned int first_window = 1;
+	while(__ll_coo_reader_next(cr, carry) > 0)
+	{
+		char* buf = cr->window;
+		unsigned long length = cr->window_length;
+
+		// Cutting the window at the last line break, the incomplete line is carried to the next window
+		if(!cr->eof)
+		{
+			while(length > 0 && buf[length - 1] != '\n')
+				length--;
+			if(length == 0)
+			{
+				printf("Error: a line in \"%s\" is longer than the window.\n", file_name);
+				assert(length > 0);
+			}
+		}
+		carry = cr->window_length - length;
+		cr->read_bytes += length;
+
+		// Matrix Market header
+		if(first_window)
+		{
+			first_window = 0;
+			if(length >= 14 && strncasecmp(buf, "%%MatrixMarket", 14) == 0)
+			{
+				*type = LL_COO_MTX;
+				base = 1;
+				unsigned long header_length = __ll_coo_mtx_read_header(buf, length, is_symmetric, &has_values, vertices_count, &entries_count);
+				if(header_length == -1UL)
+				{
+					edges_count = -1UL;
+					break;
+				}
+				buf += header_length;
+				length -= header_length;
+			}
+		}
+
+		// Identifying ranges, starting at the beginning of lines
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long s = length * r / ranges_count;
+			while(s > 0 && s < length && buf[s - 1] != '\n')
+				s++;
+			ranges_start[r] = max(s, r == 0 ? 0 : ranges_start[r - 1]);
+		}
+		ranges_start[ranges_count] = length;
+
+		// (1) Counting edges (lines starting with a digit) of each range
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long count = 0;
+			unsigned long i = ranges_start[r];
+			unsigned long end = ranges_start[r + 1];
+			while(i < end)
+			{
+				while(i < end && (buf[i] == ' ' || buf[i] == '\t'))
+					i++;
+				if(i < end && __LL_COO_IS_DIGIT(buf[i]))
+					count++;
+				while(i < end && buf[i] != '\n')
+					i++;
+				i++;
+			}
+			ranges_index[r + 1] = count;
+		}
+
+		ranges_index[0] = edges_count;
+		for(unsigned int r = 0; r < ranges_count; r++)
+			ranges_index[r + 1] += ranges_index[r];
+
+		// Growing the COO arrays
+		if(ranges_index[ranges_count] > capacity)
+		{
+			unsigned long new_capacity = max(2 * capacity, ranges_index[ranges_count]);
+			if(entries_count != -1UL)
+				new_capacity = max(entries_count, ranges_index[ranges_count]);
+
+			#define __LL_COO_GROW(__arr) \
+				if(capacity == 0) \
+					__arr = numa_alloc_interleaved(sizeof(unsigned int) * new_capacity); \
+				else \
+					__arr = numa_realloc(__arr, sizeof(unsigned int) * capacity, sizeof(unsigned int) * new_capacity); \
+				assert(__arr != NULL);
+
+			__LL_COO_GROW(src);
+			__LL_COO_GROW(dest);
+			if(weights != NULL)
+			{
+				__LL_COO_GROW(w);
+			}
+			#undef __LL_COO_GROW
+			capacity = new_capacity;
+		}
+
+		// (2) Parsing
+		#pragma omp parallel for schedule(dynamic, 1) reduction(max:max_id) reduction(+:errors)
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long index = ranges_index[r];
+			unsigned long i = ranges_start[r];
+			unsigned long end = ranges_start[r + 1];
+			while(i < end)
+			{
+				while(i < end && (buf[i] == ' ' || buf[i] == '\t'))
+					i++;
+
+				if(i < end && __LL_COO_IS_DIGIT(buf[i]))
+				{
+					char* p = buf + i;
+					unsigned long s = 0, d = 0;
+					while(__LL_COO_IS_DIGIT(*p))
+						s = s * 10 + (*p++ - '0');
+					while(__LL_COO_IS_SEP(*p))
+						p++;
+					if(!__LL_COO_IS_DIGIT(*p))
+						errors++;
+					while(__LL_COO_IS_DIGIT(*p))
+						d = d * 10 + (*p++ - '0');
+
+					if(s < base || d < base)
+						errors++;
+					s -= base;
+					d -= base;
+					if(s >= (1UL<<32) - 1 || d >= (1UL<<32) - 1)
+						errors++;
+
+					src[index] = s;
+					dest[index] = d;
+					max_id = max(max_id, max(s, d));
+
+					if(weights != NULL)
+					{
+						double val = 1;
+						while(__LL_COO_IS_SEP(*p))
+							p++;
+						if(*p != '\n' && *p != '\r' && *p != 0)
+							val = strtod(p, &p);
+						if(val < 0 || val >= 4294967295.5)
+							errors++;
+						w[index] = (unsigned int)(val + 0.5);
+					}
+					index++;
+
+					i = p - buf;
+				}
+
+				while(i < end && buf[i] != '\n')
+					i++;
+				i++;
+			}
+			assert(index == ranges_index[r + 1]);
+		}
+
+		edges_count = ranges_index[ranges_count];
+	}
+
+	#undef __LL_COO_IS_DIGIT
+	#undef __LL_COO_IS_SEP
+
+	if(edges_count != -1UL)
+	{
+		if(errors)
+		{
+			printf("Error: %'lu malformed lines or out of range values in \"%s\".\n", errors, file_name);
+			edges_count = -1UL;
+		}
+		else if(*type == LL_COO_MTX)
+		{
+			if(entries_count != edges_count)
+				printf("Warning: %'lu entries are expected in \"%s\" but %'lu entries have been read.\n", entries_count, file_name, edges_count);
+			if(edges_count > 0 && max_id >= *vertices_count)
+			{
+				printf("Error: the ID %'lu is out of the matrix size.\n", max_id + 1);
+				edges_count = -1UL;
+			}
+		}
+		else if(edges_count > 0)
+			*vertices_count = max_id + 1;
+	}
+
+	printf("Reading %'.1f (MB) completed.\n", cr->read_bytes / 1e6);
+
+	// Releasing mem
+		free(ranges_start);
+		ranges_start = NULL;
+		free(ranges_index);
+		ranges_index = NULL;
+		__ll_coo_reader_close(cr);
+		cr = NULL;
+
+	*sources = src;
+	*destinations = dest;
+	if(weights != NULL)
+		*weights = w;
+	*coo_capacity = capacity;
+
+	return edges_count;
+}
+
+/*
+	Sorts the neighbour-list of vertex `v` and removes its duplicate edges, if requested.
+	For weighted graphs (`ew` = 2), the edges are sorted by their destinations and the first edge
+	(i.e., the one with the minimum weight) of the duplicate edges is kept.
+	Returns the new degree.
+*/
+unsigned long __ll_coo_sort_neighbours(unsigned int* edges, unsigned long degree, unsigned int ew, unsigned int dedup)
+{
+	if(degree < 2)
+		return degree;
+
+	if(ew == 1)
+	{
+		quick_sort_uint(edges, 0, degree - 1);
+		if(!dedup)
+			return degree;
+
+		unsigned long d = 1;
+		for(unsigned long e = 1; e < degree; e++)
+			if(edges[e] != edges[d - 1])
+				edges[d++] = edges[e];
+		return d;
+	}
+
+	// Rotating the (destination, weight) pairs to sort by destinations and then by weights
+	unsigned long* pairs = (unsigned long*)edges;
+	for(unsigned long e = 0; e < degree; e++)
+		pairs[e] = (pairs[e] << 32) | (pairs[e] >> 32);
+	quick_sort_ulong(pairs, 0, degree - 1);
+	for(unsigned long e = 0; e < degree; e++)
+		pairs[e] = (pairs[e] << 32) | (pairs[e] >> 32);
+
+	if(!dedup)
+		return degree;
+
+	unsigned long d = 1;
+	for(unsigned long e = 1; e < degree; e++)
+		if(edges[2 * e] != edges[2 * (d - 1)])
+			pairs[d++] = pairs[e];
+
+	return d;
+}
+
+/*
+	Creates the CSR graph (`ew` = 1 for ll_400 and 2 for ll_404) from the COO file, see get_ll_400_coo_graph().
+*/
+struct ll_400_graph* __get_ll_coo_graph(char* file_name, unsigned int ew, unsigned int coo_flags)
+{
+	// Checks
+		unsigned long tt = - get_nano_time();
+		if(access(file_name, F_OK) != 0)
+		{
+			printf("Error: file \"%s\" does not exist\n",file_name);
+			return NULL;
+		}
+
+		unsigned int threads_count = omp_get_max_threads();
+		printf("\n\033[3;35mget_ll_40%u_coo_graph\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", ew == 1 ? 0 : 4, threads_count);
+
+	// (1) Reading the COO
+		unsigned long t0 = - get_nano_time();
+		unsigned int type = 0;
+		unsigned int mirror = 0;
+		unsigned long vertices_count = 0;
+		unsigned long coo_capacity = 0;
+		unsigned int* src = NULL;
+		unsigned int* dest = NULL;
+		unsigned int* weights = NULL;
+		unsigned long coo_edges = __ll_coo_read(file_name, &type, &mirror, &vertices_count, &src, &dest, ew == 2 ? &weights : NULL, &coo_capacity);
+		t0 += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "(1) Reading COO", t0 / 1e6);
+
+		if(coo_edges == -1UL || vertices_count == 0)
+		{
+			if(coo_capacity)
+			{
+				numa_free(src, sizeof(unsigned int) * coo_capacity);
+				numa_free(dest, sizeof(unsigned int) * coo_capacity);
+				if(weights != NULL)
+					numa_free(weights, sizeof(unsigned int) * coo_capacity);
+			}
+			if(coo_edges != -1UL)
+				printf("Error: no vertices in \"%s\".\n", file_name);
+			return NULL;
+		}
+
+		if(coo_flags & 8U)
+			mirror = 1;
+		printf("%-40s %s\n", "Format:", type == LL_COO_MTX ? "Matrix Market" : "SNAP edge list");
+		printf("%-40s %'10lu\n", "COO edges:", coo_edges);
+		printf("%-40s %s\n", "Mirrored edges:", mirror ? "Yes" : "No");
+
+	// Allocating memory
+		struct ll_400_graph* g = calloc(sizeof(struct ll_400_graph), 1);
+		assert(g != NULL);
+		g->vertices_count = vertices_count;
+		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(g->offsets_list != NULL);
+
+		unsigned int blocks_count = threads_count * 64;
+		unsigned long* blocks_offsets = calloc(sizeof(unsigned long), blocks_count + 1);
+		assert(blocks_offsets != NULL);
+
+	// (2) Identifying degrees
+		unsigned long self_edges = 0;
+		t0 = - get_nano_time();
+		#pragma omp parallel for reduction(+:self_edges)
+		for(unsigned long e = 0; e < coo_edges; e++)
+		{
+			unsigned int s = src[e];
+			unsigned int d = dest[e];
+			if(s == d)
+			{
+				self_edges++;
+				if(coo_flags & 1U)
+					continue;
+			}
+
+			__atomic_fetch_add(&g->offsets_list[s], 1UL, __ATOMIC_RELAXED);
+			if(mirror && s != d)
+				__atomic_fetch_add(&g->offsets_list[d], 1UL, __ATOMIC_RELAXED);
+		}
+		t0 += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "(2) Identifying degrees", t0 / 1e6);
+		printf("%-40s %'10lu\n", "Self edges:", self_edges);
+
+	// (3) Prefix sum of degrees
+		t0 = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned int b = 0; b < blocks_count; b++)
+		{
+			unsigned long sum = 0;
+			for(unsigned long v = g->vertices_count * b / blocks_count; v < g->vertices_count * (b + 1) / blocks_count; v++)
+				sum += g->offsets_list[v];
+			blocks_offsets[b + 1] = sum;
+		}
+		for(unsigned int b = 0; b < blocks_count; b++)
+			blocks_offsets[b + 1] += blocks_offsets[b];
+		g->edges_count = blocks_offsets[blocks_count];
+
+		#pragma omp parallel for
+		for(unsigned int b = 0; b < blocks_count; b++)
+		{
+			unsigned long offset = blocks_offsets[b];
+			for(unsigned long v = g->vertices_count * b / blocks_count; v < g->vertices_count * (b + 1) / blocks_count; v++)
+			{
+				unsigned long degree = g->offsets_list[v];
+				g->offsets_list[v] = offset;
+				offset += degree;
+			}
+			assert(offset == blocks_offsets[b + 1]);
+		}
+		g->offsets_list[g->vertices_count] = g->edges_count;
+		t0 += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "(3) Prefix sum", t0 / 1e6);
+
+	// (4) Writing edges
+		g->edges_list = numa_alloc_interleaved(ew * sizeof(unsigned int) * max(1UL, g->edges_count));
+		assert(g->edges_list != NULL);
+
+		t0 = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned long e = 0; e < coo_edges; e++)
+		{
+			unsigned int s = src[e];
+			unsigned int d = dest[e];
+			if(s == d && (coo_flags & 1U))
+				continue;
+
+			unsigned long offset = __atomic_fetch_add(&g->offsets_list[s], 1UL, __ATOMIC_RELAXED);
+			g->edges_list[ew * offset] = d;
+			if(ew == 2)
+				g->edges_list[ew * offset + 1] = weights[e];
+
+			if(mirror && s != d)
+			{
+				offset = __atomic_fetch_add(&g->offsets_list[d], 1UL, __ATOMIC_RELAXED);
+				g->edges_list[ew * offset] = s;
+				if(ew == 2)
+					g->edges_list[ew * offset + 1] = weights[e];
+			}
+		}
+
+		// Shifting offsets back, offsets_list[v] is now the start of vertex v + 1
+		#pragma omp parallel for
+		for(unsigned int b = 0; b < blocks_count; b++)
+		{
+			unsigned long vs = g->vertices_count * b / blocks_count;
+			unsigned long ve = g->vertices_count * (b + 1) / blocks_count;
+			if(vs == ve)
+				continue;
+			assert(g->offsets_list[ve - 1] == blocks_offsets[b + 1]);
+			for(unsigned long v = ve - 1; v > vs; v--)
+				g->offsets_list[v] = g->offsets_list[v - 1];
+			g->offsets_list[vs] = blocks_offsets[b];
+		}
+		t0 += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "(4) Writing edges", t0 / 1e6);
+
+	// Releasing the COO
+		numa_free(src, sizeof(unsigned int) * coo_capacity);
+		src = NULL;
+		numa_free(dest, sizeof(unsigned int) * coo_capacity);
+		dest = NULL;
+		if(weights != NULL)
+		{
+			numa_free(weights, sizeof(unsigned int) * coo_capacity);
+			weights = NULL;
+		}
+
+	// (5) Sorting neighbour-lists and removing duplicate edges
+	if(coo_flags & (2U + 4U))
+	{
+		t0 = - get_nano_time();
+		unsigned int dedup = (coo_flags & 2U) != 0;
+
+		// The new degrees are stored in new_offsets
+		unsigned long* new_offsets = NULL;
+		if(dedup)
+		{
+			new_offsets = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+			assert(new_offsets != NULL);
+		}
+
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(unsigned int b = 0; b < blocks_count; b++)
+		{
+			unsigned long sum = 0;
+			for(unsigned long v = g->vertices_count * b / blocks_count; v < g->vertices_count * (b + 1) / blocks_count; v++)
+			{
+				unsigned long degree = g->offsets_list[v + 1] - g->offsets_list[v];
+				degree = __ll_coo_sort_neighbours(g->edges_list + ew * g->offsets_list[v], degree, ew, dedup);
+				if(dedup)
+					new_offsets[v] = degree;
+				sum += degree;
+			}
+			blocks_offsets[b + 1] = sum;
+		}
+
+		for(unsigned int b = 0; b < blocks_count; b++)
+			blocks_offsets[b + 1] += blocks_offsets[b];
+		unsigned long new_edges_count = blocks_offsets[blocks_count];
+
+		if(new_edges_count != g->edges_count)
+		{
+			// Compacting the neighbour-lists in a new edges_list
+			unsigned int* new_edges = numa_alloc_interleaved(ew * sizeof(unsigned int) * max(1UL, new_edges_count));
+			assert(new_edges != NULL);
+
+			#pragma omp parallel for schedule(dynamic, 1)
+			for(unsigned int b = 0; b < blocks_count; b++)
+			{
+				unsigned long offset = blocks_offsets[b];
+				for(unsigned long v = g->vertices_count * b / blocks_count; v < g->vertices_count * (b + 1) / blocks_count; v++)
+				{
+					unsigned long degree = new_offsets[v];
+					new_offsets[v] = offset;
+					memcpy(new_edges + ew * offset, g->edges_list + ew * g->offsets_list[v], ew * sizeof(unsigned int) * degree);
+					offset += degree;
+				}
+				assert(offset == blocks_offsets[b + 1]);
+			}
+			new_offsets[g->vertices_count] = new_edges_count;
+
+			numa_free(g->offsets_list, sizeof(unsigned long) * (1 + g->vertices_count));
+			numa_free(g->edges_list, ew * sizeof(unsigned int) * max(1UL, g->edges_count));
+			g->offsets_list = new_offsets;
+			g->edges_list = new_edges;
+			new_offsets = NULL;
+			new_edges = NULL;
+
+			printf("%-40s %'10lu\n", "Duplicate edges:", g->edges_count - new_edges_count);
+			g->edges_count = new_edges_count;
+		}
+
+		if(new_offsets != NULL)
+		{
+			numa_free(new_offsets, sizeof(unsigned long) * (1 + g->vertices_count));
+			new_offsets = NULL;
+		}
+
+		t0 += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "(5) Sorting neighbour-lists", t0 / 1e6);
+	}
+
+	// Releasing mem
+		free(blocks_offsets);
+		blocks_offsets = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-40s %'10.1f (ms)\n", "Total time:", tt / 1e6);
+		print_ll_400_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	return g;
+}
+
+/*
+	Reads a SNAP edge list or a Matrix Market file (optionally compressed by gzip or zstd) in parallel,
+	see the comments at the beginning of this file.
+
+	`coo_flags`:
+		bit 0: remove self-edges
+		bit 1: remove duplicate edges (sorts neighbour-lists)
+		bit 2: sort neighbour-lists
+		bit 3: symmetrize, i.e., add the reverse of each edge (it is always done for symmetric Matrix Market files)
+			Without bit 1, the edges that exist in both directions are duplicated.
+
+	`flags`:
+		bit 30, 31:
+			Will be cleared by this function as the graph is allocated by numa_alloc_interleaved() and
+			should be released by `release_numa_interleaved_ll_400_graph()`.
+
+	The CSR graph is returned, or NULL if the file cannot be read.
+*/
+struct ll_400_graph* get_ll_400_coo_graph(char* file_name, unsigned int coo_flags, unsigned int* flags)
+{
+	assert(flags != NULL);
+	*flags &= ~(3U<<30);
+
+	return __get_ll_coo_graph(file_name, 1, coo_flags);
+}
+
+/*
+	Similar to get_ll_400_coo_graph() but also reads the 3rd column of each line (the value of Matrix
+	Market entries) as the weight of the edge. Edges without a weight (e.g., in `pattern` Matrix Market
+	files) have the weight 1. When duplicate edges are removed, the edge with the minimum weight is kept.
+
+	The graph should be released by `release_numa_interleaved_ll_404_graph()`.
+*/
+struct ll_404_graph* get_ll_404_coo_graph(char* file_name, unsigned int coo_flags, unsigned int* flags)
+{
+	assert(flags != NULL);
+	*flags &= ~(3U<<30);
+
+	return (struct ll_404_graph*)__get_ll_coo_graph(file_name, 2, coo_flags);
+}
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef __ENERGY_C
+#define __ENERGY_C
+
+#include <dirent.h>
+#include <pthread.h>
+
+/*
+	Energy measurement by RAPL (Running Average Power Limit) counters
+
+	The energy counters of packages and DRAMs are read from the powercap interface of Linux:
+		/sys/class/powercap/intel-rapl:<p>/energy_uj     for the zones named "package-<socket>", and
+		/sys/class/powercap/intel-rapl:<p>:<s>/energy_uj for the sub-zones named "dram".
+	AMD processors (Zen and newer) are exposed by the same interface (by the `intel_rapl_msr` driver) with
+	package zones only, so the DRAM energy is zero on them. The `intel-rapl-mmio` zones that duplicate
+	the package counters, and the `psys`, `core`, and `uncore` zones are not considered.
+
+	The counters are in micro-Joules and wrap around at `max_energy_range_uj`. As a counter may wrap around
+	more than once in a long run, a sampler thread reads the counters every __ENERGY_SAMPLING_INTERVAL seconds
+	and accumulates the differences of consecutive reads of each counter.
+
+	Since CVE-2020-8694, `energy_uj` is readable only by root, the counters that cannot be opened are skipped
+	and their energy is reported as zero.
+
+	Usage (compiled with `-D_ENERGY_MEASUREMENT`, i.e., `make energy=1`):
+		struct energy_measurement* em = energy_measurement_init();
+		energy_measurement_start(em);
+		...
+		struct energy_counters_vals* evals = energy_measurement_stop(em);
+		// evals->packages_total, evals->drams_total, evals->packages[socket], evals->drams[socket] in micro-Joules
+		energy_measurement_release(em);
+
+	The algorithms call energy_measurement_exec_info() to stop the measurement, print the energy, and store it
+	in their `exec_info`.
+*/
+
+#define __ENERGY_MAX_DOMAINS 64
+#define __ENERGY_MAX_SOCKETS 16
+#define __ENERGY_SAMPLING_INTERVAL 1   // seconds
+#ifndef __ENERGY_POWERCAP_PATH
+	#define __ENERGY_POWERCAP_PATH "/sys/class/powercap"
+#endif
+
+struct energy_domain
+{
+	int fd;                    // energy_uj
+	unsigned int is_dram;
+	unsigned int socket;
+	unsigned long max_range;   // max_energy_range_uj
+	unsigned long last;        // the last value read from energy_uj
+	unsigned long total;       // the energy since the start (uJ)
+};
+
+struct energy_counters_vals
+{
+	unsigned int sockets_count;
+	unsigned long time;                            // ns
+	unsigned long packages_total;                  // uJ
+	unsigned long drams_total;                     // uJ
+	unsigned long packages[__ENERGY_MAX_SOCKETS];  // uJ
+	unsigned long drams[__ENERGY_MAX_SOCKETS];     // uJ
+};
+
+struct energy_measurement
+{
+	unsigned int domains_count;
+	struct energy_domain domains[__ENERGY_MAX_DOMAINS];
+	struct energy_counters_vals vals;
+	unsigned long start_time;
+
+	pthread_t sampler;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	unsigned int running;
+};
+
+// Reads a counter by its open `fd`, returns -1UL on failure
+unsigned long __energy_read_counter(int fd)
+{
+	char buff[32];
+	long count = pread(fd, buff, sizeof(buff) - 1, 0);
+	if(count <= 0)
+		return -1UL;
+	buff[count] = 0;
+
+	return strtoul(buff, NULL, 10);
+}
+
+// Reads the `name` of a zone into `name` without the trailing '\n', returns 0 on success
+int __energy_read_zone_name(char* zone, char* name, int name_size)
+{
+	char path[PATH_MAX];
+	sprintf(path, __ENERGY_POWERCAP_PATH "/%s/name", zone);
+	int count = get_file_contents(path, name, name_size - 1);
+	if(count <= 0)
+		return -1;
+	name[count] = 0;
+	if(name[count - 1] == '\n')
+		name[count - 1] = 0;
+
+	return 0;
+}
+
+struct energy_measurement* energy_measurement_init()
+{
+	struct energy_measurement* em = calloc(sizeof(struct energy_measurement), 1);
+	assert(em != NULL);
+	int ret = pthread_mutex_init(&em->lock, NULL);
+	assert(ret == 0);
+	ret = pthread_cond_init(&em->cond, NULL);
+	assert(ret == 0);
+
+	DIR* dir = opendir(__ENERGY_POWERCAP_PATH);
+	if(dir == NULL)
+	{
+		printf("energy_measurement_init(), cannot open " __ENERGY_POWERCAP_PATH ", errno: %d, %s\n", errno, strerror(errno));
+		return em;
+	}
+
+	unsigned int packages_count = 0;
+	unsigned int drams_count = 0;
+	unsigned int unreadable_count = 0;
+	struct dirent* de;
+	while((de = readdir(dir)) != NULL && em->domains_count < __ENERGY_MAX_DOMAINS)
+	{
+		// (1) Identifying the zone: intel-rapl:<p> or intel-rapl:<p>:<s>
+			unsigned int p, s;
+			int matched = sscanf(de->d_name, "intel-rapl:%u:%u", &p, &s);
+			if(matched < 1)
+				continue;
+
+			char name[64];
+			if(__energy_read_zone_name(de->d_name, name, sizeof(name)))
+				continue;
+
+			unsigned int is_dram = 0;
+			if(matched == 1 && !strncmp(name, "package-", 8))
+				is_dram = 0;
+			else if(matched == 2 && !strcmp(name, "dram"))
+			{
+				// The socket of a DRAM is the socket of its parent package
+				char parent[32];
+				sprintf(parent, "intel-rapl:%u", p);
+				if(__energy_read_zone_name(parent, name, sizeof(name)) || strncmp(name, "package-", 8))
+					continue;
+				is_dram = 1;
+			}
+			else
+				continue;
+
+			unsigned int socket = atoi(name + 8);
+			if(socket >= __ENERGY_MAX_SOCKETS)
+				continue;
+
+		// (2) Opening the counter
+			char path[PATH_MAX];
+			sprintf(path, __ENERGY_POWERCAP_PATH "/%s/energy_uj", de->d_name);
+			int fd = open(path, O_RDONLY);
+			if(fd < 0)
+			{
+				unreadable_count++;
+				continue;
+			}
+
+			char range[32];
+			sprintf(path, __ENERGY_POWERCAP_PATH "/%s/max_energy_range_uj", de->d_name);
+			int count = get_file_contents(path, range, sizeof(range) - 1);
+			range[max(count, 0)] = 0;
+
+			struct energy_domain* d = &em->domains[em->domains_count++];
+			d->fd = fd;
+			d->is_dram = is_dram;
+			d->socket = socket;
+			d->max_range = strtoul(range, NULL, 10);
+
+			if(is_dram)
+				drams_count++;
+			else
+				packages_count++;
+			em->vals.sockets_count = max(em->vals.sockets_count, socket + 1);
+	}
+	closedir(dir);
+	dir = NULL;
+
+	printf("Energy measurement: %u packages, %u DRAMs", packages_count, drams_count);
+	if(unreadable_count)
+		printf(", %u counters are not readable (requires root access)", unreadable_count);
+	printf(".\n");
+
+	return em;
+}
+
+// Accumulates the changes of counters since the previous read, `em->lock` should be held by the caller
+void __energy_measurement_sample(struct energy_measurement* em)
+{
+	for(unsigned int d = 0; d < em->domains_count; d++)
+	{
+		struct energy_domain* dom = &em->domains[d];
+		unsigned long val = __energy_read_counter(dom->fd);
+		if(val == -1UL)
+			continue;
+
+		// Wraparound
+		if(val >= dom->last)
+			dom->total += val - dom->last;
+		else
+			dom->total += val + dom->max_range - dom->last;
+		dom->last = val;
+	}
+
+	return;
+}
+
+void* __energy_measurement_sampler(void* in)
+{
+	struct energy_measurement* em = (struct energy_measurement*)in;
+
+	pthread_mutex_lock(&em->lock);
+	while(em->running)
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += __ENERGY_SAMPLING_INTERVAL;
+		pthread_cond_timedwait(&em->cond, &em->lock, &ts);
+		if(em->running)
+			__energy_measurement_sample(em);
+	}
+	pthread_mutex_unlock(&em->lock);
+
+	return NULL;
+}
+
+void energy_measurement_start(struct energy_measurement* em)
+{
+	assert(em != NULL && em->running == 0);
+
+	for(unsigned int d = 0; d < em->domains_count; d++)
+	{
+		em->domains[d].last = __energy_read_counter(em->domains[d].fd);
+		em->domains[d].total = 0;
+	}
+	em->start_time = get_nano_time();
+
+	if(em->domains_count)
+	{
+		em->running = 1;
+		int ret = pthread_create(&em->sampler, NULL, __energy_measurement_sampler, em);
+		assert(ret == 0);
+	}
+
+	return;
+}
+
+/*
+	Stops the measurement and returns the energy since energy_measurement_start().
+	The returned struct belongs to `em`.
+*/
+struct energy_counters_vals* energy_measurement_stop(struct energy_measurement* em)
+{
+	assert(em != NULL);
+
+	if(em->running)
+	{
+		pthread_mutex_lock(&em->lock);
+		em->running = 0;
+		__energy_measurement_sample(em);
+		pthread_cond_signal(&em->cond);
+		pthread_mutex_unlock(&em->lock);
+		int ret = pthread_join(em->sampler, NULL);
+		assert(ret == 0);
+	}
+
+	struct energy_counters_vals* vals = &em->vals;
+	vals->time = get_nano_time() - em->start_time;
+	vals->packages_total = 0;
+	vals->drams_total = 0;
+	for(unsigned int s = 0; s < __ENERGY_MAX_SOCKETS; s++)
+	{
+		vals->packages[s] = 0;
+		vals->drams[s] = 0;
+	}
+
+	for(unsigned int d = 0; d < em->domains_count; d++)
+	{
+		struct energy_domain* dom = &em->domains[d];
+		if(dom->is_dram)
+		{
+			vals->drams[dom->socket] += dom->total;
+			vals->drams_total += dom->total;
+		}
+		else
+		{
+			vals->packages[dom->socket] += dom->total;
+			vals->packages_total += dom->total;
+		}
+	}
+
+	return vals;
+}
+
+void energy_measurement_print(struct energy_counters_vals* vals)
+{
+	printf("Energy consumption:\n");
+	for(unsigned int s = 0; s < vals->sockets_count; s++)
+		printf("  Socket %-8u : %'.2f (J) package, %'.2f (J) DRAM\n", s, vals->packages[s] / 1e6, vals->drams[s] / 1e6);
+	printf("  Packages energy : %'.2f (J)\n", vals->packages_total / 1e6);
+	printf("  DRAM energy     : %'.2f (J)\n", vals->drams_total / 1e6);
+	printf("  Total energy    : %'.2f (J)\n", (vals->packages_total + vals->drams_total) / 1e6);
+	if(vals->time)
+		printf("  Average power   : %'.2f (W)\n", 1e3 * (vals->packages_total + vals->drams_total) / vals->time);
+
+	return;
+}
+
+void energy_measurement_release(struct energy_measurement* em)
+{
+	assert(em != NULL);
+
+	if(em->running)
+		energy_measurement_stop(em);
+
+	for(unsigned int d = 0; d < em->domains_count; d++)
+	{
+		close(em->domains[d].fd);
+		em->domains[d].fd = -1;
+	}
+	em->domains_count = 0;
+
+	pthread_mutex_destroy(&em->lock);
+	pthread_cond_destroy(&em->cond);
+	free(em);
+	em = NULL;
+
+	return;
+}
+
+/*
+	Stops and releases `em`, prints the energy and the energy per edge of a graph with `edges_count` edges,
+	and if `exec_info` is not NULL, stores the energy (uJ) of packages in `exec_info[18]` and of DRAMs in `exec_info[19]`.
+*/
+void energy_measurement_exec_info(struct energy_measurement* em, unsigned long edges_count, unsigned long* exec_info)
+{
+	struct energy_counters_vals* evals = energy_measurement_stop(em);
+	energy_measurement_print(evals);
+	if(edges_count)
+		printf("  Energy per edge : %'.2f (nJ)\n", 1e3 * (evals->packages_total + evals->drams_total) / edges_count);
+
+	if(exec_info)
+	{
+		exec_info[18] = evals->packages_total;
+		exec_info[19] = evals->drams_total;
+	}
+
+	evals = NULL;
+	energy_measurement_release(em);
+	em = NULL;
+
+	return;
+}
+
+#endif
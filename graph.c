@@ -41,6 +41,19 @@ struct ll_404_graph
 	unsigned int* edges_list;
 };
 
+// 4 Bytes ID per vertex, 4 Bytes weight per edge, in the structure-of-arrays layout:
+// The destination/source of edge `e` is `edges_list[e]` and its weight is `weights_list[e]`. 
+// The first 4 fields are the same as `ll_400_graph`, so the topology-only functions of 
+// ll_400 graphs can receive it by a cast without reading the weights.
+struct ll_404_soa_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long* offsets_list;
+	unsigned int* edges_list;
+	unsigned int* weights_list;
+};
+
 // 8 Bytes IDs per vertex, without weights on edges or vertices
 struct ll_800_graph
 {
@@ -50,6 +63,23 @@ struct ll_800_graph
 	unsigned long* edges_list;
 };
 
+// 4 Bytes ID per vertex and 4 Bytes offsets, for graphs with |E| < 2^32, without weights.
+// It halves the bytes of offsets_list that are read in each pass over vertices, 
+// see LL_OFW in id_width.c for its `_c32` functions.
+struct ll_400_c32_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned int* offsets_list;
+	unsigned int* edges_list;
+};
+
+/*
+	Called by the release functions of graphs with the graph that is being released, e.g., 
+	to release the partitions cached for the graph (set by partitioning.c, see partitions_cache_get()).
+*/
+void (*graph_release_hook)(void* g) = NULL;
+
 void print_ll_400_graph(struct ll_400_graph* ret)
 {
 	printf("\n|V|: %'20lu\n|E|: %'20lu\n", ret->vertices_count, ret->edges_count);
@@ -81,6 +111,68 @@ void print_ll_400_graph(struct ll_400_graph* ret)
 	return;
 }
 
+void print_ll_800_graph(struct ll_800_graph* ret)
+{
+	printf("\n|V|: %'20lu\n|E|: %'20lu\n", ret->vertices_count, ret->edges_count);
+	printf("First offsets: ");
+	for(unsigned long v=0; v<min(ret->vertices_count + 1, 20); v++)
+		printf("%lu, ", ret->offsets_list[v]);
+	if(ret->vertices_count > 20)
+	{
+		printf("...\nLast offsets: ... ");
+		for(unsigned long v = ret->vertices_count - 20; v <= ret->vertices_count; v++)
+			printf(", %lu", ret->offsets_list[v]);
+	}
+
+	if(ret->edges_list)
+	{
+		printf("\nFirst edges: ");
+		for(unsigned long e=0; e<min(ret->edges_count, 20); e++)
+			printf("%lu, ", ret->edges_list[e]);
+		if(ret->edges_count > 20)
+		{
+			printf(" ...\nLast edges: ... ");
+			for(unsigned long e = ret->edges_count - 20; e < ret->edges_count; e++)
+				printf(", %lu", ret->edges_list[e]);
+		}
+	}
+
+	printf("\n\n");
+
+	return;
+}
+
+void print_ll_400_c32_graph(struct ll_400_c32_graph* ret)
+{
+	printf("\n|V|: %'20lu\n|E|: %'20lu\n", ret->vertices_count, ret->edges_count);
+	printf("First offsets: ");
+	for(unsigned int v=0; v<min(ret->vertices_count + 1, 20); v++)
+		printf("%u, ", ret->offsets_list[v]);
+	if(ret->vertices_count > 20)
+	{
+		printf("...\nLast offsets: ... ");
+		for(unsigned int v = ret->vertices_count - 20; v <= ret->vertices_count; v++)
+			printf(", %u", ret->offsets_list[v]);
+	}
+
+	if(ret->edges_list)
+	{
+		printf("\nFirst edges: ");
+		for(unsigned long e=0; e<min(ret->edges_count, 20); e++)
+			printf("%u, ", ret->edges_list[e]);
+		if(ret->edges_count > 20)
+		{
+			printf(" ...\nLast edges: ... ");
+			for(unsigned long e = ret->edges_count - 20; e < ret->edges_count; e++)
+				printf(", %u", ret->edges_list[e]);
+		}
+	}
+
+	printf("\n\n");
+
+	return;
+}
+
 char* get_shm_graph_name(char* file_name)
 {
 	assert(file_name != NULL);
@@ -168,6 +260,171 @@ struct ll_400_graph* get_shm_ll_400_graph(char* file_name, unsigned long vertice
 	return g;
 }
 
+/*
+	Reads |V| and |E| from the first two lines of a textual graph and 
+	returns the byte offset of the third line (i.e., the offsets list) in `data_offset`.
+*/
+int __ll_txt_graph_read_header(char* file_name, unsigned long* vertices_count, unsigned long* edges_count, unsigned long* data_offset)
+{
+	FILE* fp = fopen(file_name, "r");
+	if(fp == NULL)
+	{
+		printf("Can't open the file: %d - %s\n",errno,strerror(errno));
+		return -1;
+	}
+
+	int ret = fscanf(fp, "%lu", vertices_count);
+	assert(ret == 1);
+	ret = fscanf(fp, "%lu", edges_count);
+	assert(ret == 1);
+	
+	long pos = ftell(fp);
+	assert(pos > 0);
+	*data_offset = pos;
+
+	fclose(fp);
+	fp = NULL;
+
+	printf("Vertices: %'lu\n", *vertices_count);
+	printf("Edges: %'lu\n", *edges_count);
+
+	return 0;
+}
+
+/*
+	Parses the offsets and edges sections of a textual graph in parallel. 
+
+	The file is processed in windows of 1 GB (or the size of data if smaller). Each window is read by `par_read_file()`, 
+	cut at the last separator, and split into `omp_get_max_threads() * 16` ranges whose borders
+	are moved forward to the next separator so that no number is shared by two ranges.
+	Numbers of each range are counted in the first pass, prefix-summed to find the 
+	index of the first number of each range, and parsed in the second pass.
+
+	The first `vertices_count` numbers are written to `offsets_list` and the next 
+	`edges_list_length` numbers to `edges_list`. Any non-digit character is a separator.
+
+	Returns the number of bytes read.
+*/
+unsigned long __ll_txt_graph_parse(char* file_name, unsigned long data_offset, unsigned long vertices_count, 
+	unsigned long* offsets_list, unsigned long edges_list_length, unsigned int* edges_list)
+{
+	unsigned long file_size = get_file_size(file_name);
+	assert(data_offset <= file_size);
+
+	// Windows of 1 GB, or smaller for smaller files
+	unsigned long window_size = min(4096UL * 1024 * 256, file_size - data_offset);
+	char* main_mem = numa_alloc_interleaved(window_size + 2 * 4096);
+	assert(main_mem != NULL);
+
+	unsigned int ranges_count = omp_get_max_threads() * 16;
+	unsigned long* ranges_start = calloc(sizeof(unsigned long), ranges_count + 1);
+	unsigned long* ranges_index = calloc(sizeof(unsigned long), ranges_count + 1);
+	assert(ranges_start != NULL && ranges_index != NULL);
+
+	#define __LL_TXT_IS_DIGIT(c) ((unsigned char)((c) - '0') < 10)
+
+	unsigned long total_numbers = vertices_count + edges_list_length;
+	unsigned long parsed_numbers = 0;
+	unsigned long window_start = data_offset;
+
+	while(window_start < file_size)
+	{
+		unsigned long window_end = min(window_start + window_size, file_size);
+		char* buf = par_read_file(file_name, window_start, window_end, main_mem);
+
+		// Cutting the window at the last separator, the remaining digits are read by the next window
+		unsigned long length = window_end - window_start;
+		if(window_end != file_size)
+		{
+			while(length > 0 && __LL_TXT_IS_DIGIT(buf[length - 1]))
+				length--;
+			assert(length > 0);
+		}
+
+		// Identifying ranges
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long s = length * r / ranges_count;
+			while(s > 0 && s < length && __LL_TXT_IS_DIGIT(buf[s]) && __LL_TXT_IS_DIGIT(buf[s - 1]))
+				s++;
+			ranges_start[r] = max(s, r == 0 ? 0 : ranges_start[r - 1]);
+		}
+		ranges_start[ranges_count] = length;
+
+		// Counting numbers in each range
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long count = 0;
+			unsigned int in_number = 0;
+			for(unsigned long i = ranges_start[r]; i < ranges_start[r + 1]; i++)
+			{
+				unsigned int is_digit = __LL_TXT_IS_DIGIT(buf[i]);
+				count += is_digit & ~in_number;
+				in_number = is_digit;
+			}
+			ranges_index[r + 1] = count;
+		}
+
+		ranges_index[0] = parsed_numbers;
+		for(unsigned int r = 0; r < ranges_count; r++)
+			ranges_index[r + 1] += ranges_index[r];
+		assert(ranges_index[ranges_count] <= total_numbers);
+
+		// Parsing
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(unsigned int r = 0; r < ranges_count; r++)
+		{
+			unsigned long index = ranges_index[r];
+			unsigned long val = 0;
+			unsigned int val_length = 0;
+
+			for(unsigned long i = ranges_start[r]; i <= ranges_start[r + 1]; i++)
+			{
+				if(i < ranges_start[r + 1] && __LL_TXT_IS_DIGIT(buf[i]))
+				{
+					val = val * 10 + (buf[i] - '0');
+					val_length++;
+					continue;
+				}
+
+				if(val_length == 0)
+					continue;
+
+				if(index < vertices_count)
+					offsets_list[index] = val;
+				else
+				{
+					assert(val < (1UL<<32));
+					edges_list[index - vertices_count] = val;
+				}
+				index++;
+
+				val = 0;
+				val_length = 0;
+			}
+			assert(index == ranges_index[r + 1]);
+		}
+
+		parsed_numbers = ranges_index[ranges_count];
+		window_start += length;
+	}
+
+	#undef __LL_TXT_IS_DIGIT
+
+	assert(parsed_numbers == total_numbers);
+
+	// Release mem
+		numa_free(main_mem, window_size + 2 * 4096);
+		main_mem = NULL;
+		free(ranges_start);
+		ranges_start = NULL;
+		free(ranges_index);
+		ranges_index = NULL;
+
+	return file_size - data_offset;
+}
+
 /*
 	`flags`:
 		bit 0: 
@@ -189,25 +446,12 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 			return NULL;
 		}
 
-	// Reading vertices and edges count and graph size
+	// Reading vertices and edges count
 		unsigned long vertices_count = 0;
 		unsigned long edges_count = 0;	
-		{
-			char temp[512];
-			sprintf(temp, "head -n1 %s", file_name);
-			FILE *fp = popen(temp, "r");
-			int ret = fscanf(fp, "%lu", &vertices_count);
-			assert(ret == 1);
-			pclose(fp);
-			printf("Vertices: %'lu\n",vertices_count);
-
-			sprintf(temp, "head -n2 %s | tail -n1", file_name);
-			fp = popen(temp, "r");
-			ret = fscanf(fp, "%lu", &edges_count);
-			assert(ret == 1);
-			pclose(fp);
-			printf("Edges: %'lu\n",edges_count);
-		}
+		unsigned long data_offset = 0;
+		if(__ll_txt_graph_read_header(file_name, &vertices_count, &edges_count, &data_offset) != 0)
+			return NULL;
 
 	// Check if the graph exists in /dev/shm
 		if((*flags & 1U<<0) == 0)
@@ -236,106 +480,77 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 		
 	// Reading graph from disk
 	{
-		int fd=open(file_name, O_RDONLY | O_DIRECT);
-		if(fd<0)
-		{
-			printf("Can't open the file: %d - %s\n",errno,strerror(errno));
-			return NULL;
-		}
+		unsigned long t1 = get_nano_time();
+		unsigned long total_read_bytes = __ll_txt_graph_parse(file_name, data_offset, g->vertices_count, g->offsets_list, g->edges_count, g->edges_list);
+		g->offsets_list[g->vertices_count]=g->edges_count;
 
-		unsigned long buf_size=4096UL * 1024 * 24;
-		char* buf=malloc(sizeof(char)*buf_size);
-		assert(buf != NULL);
-		char* main_buff_address = buf;
-		
-		// 4096 alignment of buf for O_DIRECT
-		if((unsigned long)buf % 4096)
-		{
-			unsigned long excess = 4096 - (unsigned long)buf % 4096 ;
-			buf = (char*)((unsigned long)buf + excess);
-			buf_size -= 4096;
- 		}
+		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", total_read_bytes/1e6, (get_nano_time() - t1)/1e9); 
+	}
+
+	// Printing the first vals in the read graph
+		print_ll_400_graph(g);
 
-		long count=-1;
+	// Flush the OS cache
+		flush_os_cache();
 
-		unsigned long val=0;
-		unsigned int val_length=0;
-		unsigned int status=0;
+	*flags &= ~(1U<<31);
 
-		unsigned long t1=get_nano_time();
-		unsigned long vl_count=0;
-		unsigned long el_count=0;
-		unsigned long total_read_bytes = 0;
+	return g;	
+}
 
-		while((count=read(fd, buf, buf_size)) > 0)
-		{
-			total_read_bytes += count;
-			int i=0;
+/*
+	Creates the /dev/shm object of a graph with `graph_size` Bytes before reading the graph, 
+	so that the loader writes the graph directly into the shared memory (bit 1 of the `flags` of 
+	`get_ll_400_webgraph()` and `get_ll_404_webgraph()`) and a second copy of the graph is not required.
 
-			while(i<count)
-			{
-				//if(i<50) printf("status: %d, v: %c\n",status,buf[i]);
-				if(buf[i]!='\n' && buf[i]!=' ')
-				{
-					val = val * 10 + (buf[i]-'0');
-					val_length++;
-				}
-				else if(val_length)
-				{
-					switch(status)
-					{
-						case 0:
-							assert(vertices_count == val);
-							break;
-
-						case 1:
-							assert(edges_count == val);
-							break;
-
-						case 2:
-							g->offsets_list[vl_count++]=val;
-							break;
-
-						case 3:
-							assert(val < (1UL<<32));
-							g->edges_list[el_count++]=val;
-							break;
-					}
-					val=0;
-					val_length=0;
-				}
-				
-				if(buf[i] == '\n')
-					status++;
+	The header (|V| and |E|) is written by `__finalize_shm_graph()` after writing the whole graph.
+	So, the object of a partially written graph (e.g., an interrupted run) has zero |V| and |E| and
+	is rejected by the loaders in the next runs.
 
-				i++;
-			}	
-		}
+	Returns NULL if the object cannot be created.
+*/
+unsigned long* __create_shm_graph(char* file_name, unsigned long graph_size)
+{
+	char* shm_name = get_shm_graph_name(file_name);
+	unsigned long* sg = create_shm(shm_name, graph_size);
+	if(sg != NULL)
+	{
+		numa_interleave_allocated_memory(sg, graph_size);
+		printf("Reading directly into shm: %s\n", shm_name);
+	}
 
-		assert(count >= 0);
-		assert(el_count == edges_count);
-		assert(vl_count == vertices_count);
+	free(shm_name);
+	shm_name = NULL;
 
-		free(main_buff_address);
-		main_buff_address = NULL;
-		buf = NULL;
-		close(fd);
-		fd = -1;
+	return sg;
+}
 
-		g->offsets_list[g->vertices_count]=g->edges_count;
+void __finalize_shm_graph(char* file_name, unsigned long* sg, unsigned long graph_size, unsigned long vertices_count, unsigned long edges_count)
+{
+	int ret = msync(sg, graph_size, MS_SYNC);
+	assert(ret == 0);
 
-		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", total_read_bytes/1e6, (get_nano_time() - t1)/1e9); 
-	}
+	sg[0] = vertices_count;
+	sg[1] = edges_count;
+	ret = msync(sg, 4096, MS_SYNC);
+	assert(ret == 0);
 
-	// Printing the first vals in the read graph
-		print_ll_400_graph(g);
+	// The graph is read-only similar to the graphs mapped by get_shm_ll_400_graph()
+	ret = mprotect(sg, graph_size, PROT_READ);
+	assert(ret == 0);
 
-	// Flush the OS cache
-		flush_os_cache();
+	char* shm_name = get_shm_graph_name(file_name);
+	int shm_fd = shm_open(shm_name, O_RDONLY, 0);
+	assert(shm_fd > 0);
+	ret = fchmod(shm_fd, S_IRUSR|S_IRGRP|S_IROTH);
+	assert(ret == 0);
 
-	*flags &= ~(1U<<31);
+	close(shm_fd);
+	shm_fd = -1;
+	free(shm_name);
+	shm_name = NULL;
 
-	return g;	
+	return;
 }
 
 void __ll_400_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
@@ -364,6 +579,10 @@ void __ll_400_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_
 	`flags`:
 		bit 0: 
 			Read from storage. Do not use the copy in /dev/shm (if it exists).
+
+		bit 1:
+			Store the graph in /dev/shm. The shm object is created before reading and the graph is 
+			written directly into it. If successful, bit 31 is set.
 		
 		bit 31: 
 			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
@@ -439,10 +658,23 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 		assert(g != NULL);
 		g->vertices_count = vertices_count;
 		g->edges_count = edges_count;
-		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
-		assert(g->offsets_list != NULL);
-		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
-		assert(g->edges_list != NULL);
+
+		unsigned long shm_graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + edges_count * sizeof(unsigned int);
+		unsigned long* sg = NULL;
+		if(*flags & 1U<<1)
+			sg = __create_shm_graph(file_name, shm_graph_size);
+		if(sg != NULL)
+		{
+			g->offsets_list = sg + 2;
+			g->edges_list = (unsigned int*)(sg + 2 + vertices_count + 1);
+		}
+		else
+		{
+			g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+			assert(g->offsets_list != NULL);
+			g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+			assert(g->edges_list != NULL);
+		}
 		
 	// Writing offsets
 	{
@@ -526,61 +758,31 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 	// Flush the OS cache
 		flush_os_cache();
 
-	*flags &= ~(1U<<31);
-
-	return g;	
-}
-
-struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
-{
-	char* shm_name = get_shm_graph_name(file_name);
-	printf("shm_name: %s\n", shm_name);
-	unsigned long graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + 2UL * edges_count * sizeof(unsigned int);
-
-	struct ll_404_graph* g = NULL;
-	int shm_fd = shm_open(shm_name, O_RDONLY, 0);
-	if(shm_fd > 0)
-	{
-		printf("Shared memory file exists.\n");
-		unsigned long* ul_graph = (unsigned long*)mmap(NULL, graph_size, PROT_READ, MAP_PRIVATE, shm_fd, 0);
-		if(ul_graph == MAP_FAILED)
+	// Finalizing the shm graph
+		if(sg != NULL)
 		{
-			printf("Couldn't get graph -> mmap error : %d, %s\n", errno, strerror(errno) );
-			assert (ul_graph != MAP_FAILED);
+			__finalize_shm_graph(file_name, sg, shm_graph_size, vertices_count, edges_count);
+			*flags |= 1U<<31;
+			return g;
 		}
-		close(shm_fd);
-		shm_fd = -1;
-		
-		g = malloc(sizeof(struct ll_404_graph));
-		assert(g != NULL);
-		g->vertices_count = ul_graph[0];
-		g->edges_count = ul_graph[1];
-		g->offsets_list = &ul_graph[2];
-		g->edges_list = (unsigned int*)(&ul_graph[ 2 + ul_graph[0] + 1 ]);
-	}
 
-	// Release mem
-		free(shm_name);
-		shm_name = NULL;
+	*flags &= ~(1U<<31);
 
-	return g;
+	return g;	
 }
 
-void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+void __ll_800_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
 {
 	void** args = (void**) in_args;
 	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
-	// Each edge has 4-Bytes for vertex ID and 4-Bytes for edge weight, we copy the 8-Bytes together
 	unsigned long* graph_edges = (unsigned long*)args[1];
 
 	unsigned long* offsets = (unsigned long*)in_offsets;
 	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
 	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
-	unsigned long* ul_in_edges = (unsigned long*)in_edges;
 
-	// No need to parallelize this loop as multiple instances of this callback are concurrently called by the ParaGrapher 
-	for(unsigned long e = 0; e < ec; e++, dest_off++)
-		graph_edges[dest_off] = ul_in_edges[e];
+	// No need to parallelize this copy as multiple instances of this callback are concurrently called by the ParaGrapher 
+	memcpy(graph_edges + dest_off, in_edges, sizeof(unsigned long) * ec);
 
 	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
 
@@ -590,18 +792,233 @@ void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_
 }
 
 /*
+	Reads a WebGraph with 8 Bytes IDs per vertex, i.e., graphs with |V| >= 2^32 that cannot be 
+	read by `get_ll_400_webgraph()`.
+
+	The graph is not mapped from or stored in /dev/shm. The binary format (`store_ll_800_bin_graph()` and 
+	`get_ll_800_bin_graph()`) can be used to avoid decompressing the graph in the next executions.
+
 	`flags`:
-		bit 0: 
-			Read from storage. Do not use the copy in /dev/shm (if it exists).
-		
-		bit 31: 
-			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
-			This flag should be used for releasing the graph. If it is set, `release_shm_ll_404_graph()` should be called.
-			Otherwise, `release_numa_interleaved_ll_404_graph()` should be called.
+		No flags are used for now, the bits 30 and 31 are cleared by the function. 
+		The graph should be released by `release_numa_interleaved_ll_800_graph()`.
 */
-struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned int* flags)
+struct ll_800_graph* get_ll_800_webgraph(char* file_name, char* type, unsigned int* flags)
 {	
-	// Opening graph
+	// Opening the graph
+		unsigned long t1=get_nano_time();
+			
+		int ret = paragrapher_init();
+		assert(ret == 0);
+
+		paragrapher_graph_type pgt;
+		if(!strcmp(type, "PARAGRAPHER_CSX_WG_400_AP") || !strcmp(type, "PARAGRAPHER_CSX_WG_800_AP"))
+			pgt = PARAGRAPHER_CSX_WG_800_AP;
+		else
+		{
+			assert(0 && "get_ll_800_webgraph does not work for this type of graph.");
+			return NULL;
+		}
+		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, NULL, 0);
+		assert(graph != NULL);
+
+		unsigned long vertices_count = 0;
+		unsigned long edges_count = 0;	
+		{
+			void* op_args []= {&vertices_count, &edges_count};
+
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_VERTICES_COUNT, op_args, 1);
+			assert (ret == 0);
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_EDGES_COUNT, op_args + 1, 1);
+			assert (ret == 0);
+			printf("Vertices: %'lu\n",vertices_count);
+			printf("Edges: %'lu\n",edges_count);
+		}
+
+	// Allocating memory
+		struct ll_800_graph* g =calloc(sizeof(struct ll_800_graph),1);
+		assert(g != NULL);
+		g->vertices_count = vertices_count;
+		g->edges_count = edges_count;
+		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(g->offsets_list != NULL);
+		g->edges_list = numa_alloc_interleaved(sizeof(unsigned long) * g->edges_count);
+		assert(g->edges_list != NULL);
+		
+	// Writing offsets
+	{
+		unsigned long* offsets = (unsigned long*)paragrapher_csx_get_offsets(graph, NULL, 0, -1UL, NULL, 0);
+		assert(offsets != NULL);
+
+		#pragma omp parallel for
+		for(unsigned long v = 0; v <= vertices_count; v++)
+			g->offsets_list[v] = offsets[v];
+
+		paragrapher_csx_release_offsets_weights_arrays(graph, offsets);
+		offsets = NULL;
+	}
+
+	// Reading edges
+	{
+		unsigned long completed_callbacks_count = 0;
+		void* callback_args[] = {(void*)&completed_callbacks_count, (void*)g->edges_list};
+		paragrapher_edge_block eb;
+		eb.start_vertex = 0;
+		eb.start_edge=0;
+		eb.end_vertex = -1UL;
+		eb.end_edge= -1UL;
+
+		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_800_webgraph_callback, (void*)callback_args, NULL, 0);
+		assert(req != NULL);
+
+		struct timespec ts = {0, 200 * 1000 * 1000};
+		long status = 0;
+		unsigned long read_edges = 0;
+		unsigned long callbacks_count = 0;
+		void* op0_args []= {req, &status};
+		void* op1_args []= {req, &read_edges};
+		void* op2_args []= {req, &callbacks_count};
+		unsigned long next_edge_limit_print = 0;
+		do
+		{
+			nanosleep(&ts, NULL);
+			
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
+			assert (ret == 0);
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_EDGES, op1_args, 2);
+			assert (ret == 0);
+			if(callbacks_count == 0)
+			{
+				ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_TOTAL_CALLBACKS, op2_args, 2);
+				assert (ret == 0);
+			}
+
+			if(read_edges >= next_edge_limit_print)
+			{
+				printf("  Reading ..., status: %'ld, read_edges: %'15lu (%.1f%%), completed callbacks: %'lu/%'lu .\n", status, read_edges, 100.0 *read_edges/edges_count, completed_callbacks_count, callbacks_count);
+
+				next_edge_limit_print = read_edges + 0.05 * edges_count;
+			}
+		}
+		while(status == 0);
+
+		// Waiting for all buffers to be processed
+		while(completed_callbacks_count < callbacks_count)
+			nanosleep(&ts, NULL);
+		
+		// Releasing the req
+		paragrapher_csx_release_read_request(req);
+		req = NULL;
+	}
+
+	// Releasing the paragrapher graph
+		ret = paragrapher_release_graph(graph, NULL, 0);
+		assert(ret == 0);
+		graph = NULL;
+		
+	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
+
+	// Printing the first vals in the read graph
+		print_ll_800_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	*flags &= ~(3U<<30);
+
+	return g;	
+}
+
+struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
+{
+	char* shm_name = get_shm_graph_name(file_name);
+	printf("shm_name: %s\n", shm_name);
+	unsigned long graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + 2UL * edges_count * sizeof(unsigned int);
+
+	struct ll_404_graph* g = NULL;
+	int shm_fd = shm_open(shm_name, O_RDONLY, 0);
+	if(shm_fd > 0)
+	{
+		printf("Shared memory file exists.\n");
+		unsigned long* ul_graph = (unsigned long*)mmap(NULL, graph_size, PROT_READ, MAP_PRIVATE, shm_fd, 0);
+		if(ul_graph == MAP_FAILED)
+		{
+			printf("Couldn't get graph -> mmap error : %d, %s\n", errno, strerror(errno) );
+			assert (ul_graph != MAP_FAILED);
+		}
+		close(shm_fd);
+		shm_fd = -1;
+		
+		g = malloc(sizeof(struct ll_404_graph));
+		assert(g != NULL);
+		g->vertices_count = ul_graph[0];
+		g->edges_count = ul_graph[1];
+		g->offsets_list = &ul_graph[2];
+		g->edges_list = (unsigned int*)(&ul_graph[ 2 + ul_graph[0] + 1 ]);
+	}
+
+	// Release mem
+		free(shm_name);
+		shm_name = NULL;
+
+	return g;
+}
+
+void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+{
+	void** args = (void**) in_args;
+	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
+	// Each edge has 4-Bytes for vertex ID and 4-Bytes for edge weight, we copy the 8-Bytes together
+	unsigned long* graph_edges = (unsigned long*)args[1];
+
+	unsigned long* offsets = (unsigned long*)in_offsets;
+	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
+	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
+	unsigned long* ul_in_edges = (unsigned long*)in_edges;
+
+	// No need to parallelize this loop as multiple instances of this callback are concurrently called by the ParaGrapher 
+	for(unsigned long e = 0; e < ec; e++, dest_off++)
+		graph_edges[dest_off] = ul_in_edges[e];
+
+	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
+
+	__atomic_add_fetch(completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+
+	return;
+}
+
+// Similar to `__ll_404_webgraph_callback()` but splits each edge into the `edges_list` and `weights_list` of a ll_404_soa_graph
+void __ll_404_soa_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+{
+	void** args = (void**) in_args;
+	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
+	unsigned int* graph_edges = (unsigned int*)args[1];
+	unsigned int* graph_weights = (unsigned int*)args[2];
+
+	unsigned long* offsets = (unsigned long*)in_offsets;
+	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
+	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
+	unsigned int* ui_in_edges = (unsigned int*)in_edges;
+
+	for(unsigned long e = 0; e < ec; e++, dest_off++)
+	{
+		graph_edges[dest_off] = ui_in_edges[2 * e];
+		graph_weights[dest_off] = ui_in_edges[2 * e + 1];
+	}
+
+	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
+
+	__atomic_add_fetch(completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+
+	return;
+}
+
+/*
+	Reads a PARAGRAPHER_CSX_WG_404_AP graph into a ll_404_graph (`soa` == 0) or a ll_404_soa_graph (`soa` == 1),
+	see `get_ll_404_webgraph()`. The ll_404_soa_graph is not stored in or mapped from /dev/shm.
+*/
+struct ll_404_soa_graph* __get_ll_404_webgraph(char* file_name, char* type, unsigned int* flags, unsigned int soa)
+{	
+	// Opening graph
 		unsigned long t1=get_nano_time();
 			
 		int ret = paragrapher_init();
@@ -637,7 +1054,7 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 		}
 
 	// Check if the graph exists in /dev/shm
-		if((*flags & 1U<<0) == 0)
+		if((*flags & 1U<<0) == 0 && !soa)
 		{
 			struct ll_404_graph* g = get_shm_ll_404_graph(file_name, vertices_count, edges_count);
 			if(g != NULL)
@@ -647,19 +1064,49 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 
 				print_ll_400_graph((struct ll_400_graph*)g);
 				*flags |= 1U<<31;
-				return g;
+
+				// The returned struct has the size of ll_404_soa_graph with `weights_list` set to NULL
+				struct ll_404_soa_graph* ret = calloc(sizeof(struct ll_404_soa_graph), 1);
+				assert(ret != NULL);
+				memcpy(ret, g, sizeof(struct ll_404_graph));
+				free(g);
+				g = NULL;
+
+				return ret;
 			}
 		}
 
 	// Allocating memory
-		struct ll_404_graph* g =calloc(sizeof(struct ll_404_graph),1);
+		struct ll_404_soa_graph* g =calloc(sizeof(struct ll_404_soa_graph),1);
 		assert(g != NULL);
 		g->vertices_count = vertices_count;
 		g->edges_count = edges_count;
-		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
-		assert(g->offsets_list != NULL);
-		g->edges_list = numa_alloc_interleaved(2UL * sizeof(unsigned int) * g->edges_count);
-		assert(g->edges_list != NULL);
+
+		unsigned long shm_graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + 2UL * edges_count * sizeof(unsigned int);
+		unsigned long* sg = NULL;
+		if((*flags & 1U<<1) && !soa)
+			sg = __create_shm_graph(file_name, shm_graph_size);
+		if(sg != NULL)
+		{
+			g->offsets_list = sg + 2;
+			g->edges_list = (unsigned int*)(sg + 2 + vertices_count + 1);
+		}
+		else
+		{
+			g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+			assert(g->offsets_list != NULL);
+			if(soa)
+			{
+				g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+				g->weights_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+				assert(g->edges_list != NULL && g->weights_list != NULL);
+			}
+			else
+			{
+				g->edges_list = numa_alloc_interleaved(2UL * sizeof(unsigned int) * g->edges_count);
+				assert(g->edges_list != NULL);
+			}
+		}
 		
 	// Writing offsets
 	{
@@ -676,14 +1123,16 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 	// Reading edges
 	{
 		unsigned long completed_callbacks_count = 0;
-		void* callback_args[] = {(void*)&completed_callbacks_count, (void*)g->edges_list};
+		void* callback_args[] = {(void*)&completed_callbacks_count, (void*)g->edges_list, (void*)g->weights_list};
 		paragrapher_edge_block eb;
 		eb.start_vertex = 0;
 		eb.start_edge=0;
 		eb.end_vertex = -1UL;
 		eb.end_edge= -1UL;
 
-		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_404_webgraph_callback, (void*)callback_args, NULL, 0);
+		void (*callback)(paragrapher_read_request*, paragrapher_edge_block*, void*, void*, void*, void*) = 
+			soa ? __ll_404_soa_webgraph_callback : __ll_404_webgraph_callback;
+		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, callback, (void*)callback_args, NULL, 0);
 		assert(req != NULL);
 
 		struct timespec ts = {0, 200 * 1000 * 1000};
@@ -735,7 +1184,120 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 		assert(ret == 0);
 		graph = NULL;
 		
-	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
+	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
+
+	// Printing the first vals in the read graph
+		print_ll_400_graph((struct ll_400_graph*)g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	// Finalizing the shm graph
+		if(sg != NULL)
+		{
+			__finalize_shm_graph(file_name, sg, shm_graph_size, vertices_count, edges_count);
+			*flags |= 1U<<31;
+			return g;
+		}
+
+	*flags &= ~(1U<<31);
+
+	return g;	
+}
+
+/*
+	`flags`:
+		bit 0: 
+			Read from storage. Do not use the copy in /dev/shm (if it exists).
+
+		bit 1:
+			Store the graph in /dev/shm. The shm object is created before reading and the graph is 
+			written directly into it. If successful, bit 31 is set.
+		
+		bit 31: 
+			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
+			This flag should be used for releasing the graph. If it is set, `release_shm_ll_404_graph()` should be called.
+			Otherwise, `release_numa_interleaved_ll_404_graph()` should be called.
+*/
+struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned int* flags)
+{
+	return (struct ll_404_graph*)__get_ll_404_webgraph(file_name, type, flags, 0);
+}
+
+/*
+	Reads a PARAGRAPHER_CSX_WG_404_AP graph in the structure-of-arrays layout. 
+	The /dev/shm is not used and bits 0 and 1 of `flags` are ignored.
+	The graph should be released by `release_numa_interleaved_ll_404_soa_graph()`.
+*/
+struct ll_404_soa_graph* get_ll_404_soa_webgraph(char* file_name, char* type, unsigned int* flags)
+{
+	return __get_ll_404_webgraph(file_name, type, flags, 1);
+}
+
+/*
+	Reads a weighted textual graph. The format is similar to the format of `get_ll_400_txt_graph()`
+	but the 4th line contains 2 * |E| numbers: the destination/source and the weight of each edge.
+
+	`flags`:
+		bit 0: 
+			Read from storage. Do not use the copy in /dev/shm (if it exists).
+		
+		bit 31: 
+			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
+			This flag should be used for releasing the graph. If it is set, `release_shm_ll_404_graph()` should be called.
+			Otherwise, `release_numa_interleaved_ll_404_graph()` should be called.
+*/
+struct ll_404_graph* get_ll_404_txt_graph(char* file_name, unsigned int* flags)
+{
+	// Checks 
+		assert(flags != NULL);
+
+		if(access(file_name, F_OK) != 0)
+		{
+			printf("Error: file \"%s\" does not exist\n",file_name);
+			return NULL;
+		}
+
+	// Reading vertices and edges count
+		unsigned long vertices_count = 0;
+		unsigned long edges_count = 0;	
+		unsigned long data_offset = 0;
+		if(__ll_txt_graph_read_header(file_name, &vertices_count, &edges_count, &data_offset) != 0)
+			return NULL;
+
+	// Check if the graph exists in /dev/shm
+		if((*flags & 1U<<0) == 0)
+		{
+			struct ll_404_graph* g = get_shm_ll_404_graph(file_name, vertices_count, edges_count);
+			if(g != NULL)
+			{
+				assert(vertices_count == g->vertices_count);
+				assert(edges_count == g->edges_count);
+
+				print_ll_400_graph((struct ll_400_graph*)g);
+				*flags |= 1U<<31;
+				return g;
+			}
+		}
+		
+	// Allocate memory
+		struct ll_404_graph* g =calloc(sizeof(struct ll_404_graph),1);
+		assert(g != NULL);
+		g->vertices_count = vertices_count;
+		g->edges_count = edges_count;
+		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(g->offsets_list != NULL);
+		g->edges_list = numa_alloc_interleaved(2UL * sizeof(unsigned int) * g->edges_count);
+		assert(g->edges_list != NULL);
+		
+	// Reading graph from disk
+	{
+		unsigned long t1 = get_nano_time();
+		unsigned long total_read_bytes = __ll_txt_graph_parse(file_name, data_offset, g->vertices_count, g->offsets_list, 2UL * g->edges_count, g->edges_list);
+		g->offsets_list[g->vertices_count]=g->edges_count;
+
+		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", total_read_bytes/1e6, (get_nano_time() - t1)/1e9); 
+	}
 
 	// Printing the first vals in the read graph
 		print_ll_400_graph((struct ll_400_graph*)g);
@@ -781,7 +1343,7 @@ int store_shm_ll_400_graph(struct par_env* pe, char* file_name, struct ll_400_gr
 		for(unsigned long e=0; e < g->edges_count; e++)
 			sg_edges[e] = g->edges_list[e];
 
-		int ret = msync(sg, graph_size, MS_SYNC);
+		ret = msync(sg, graph_size, MS_SYNC);
 		assert(ret == 0);
 
 		munmap(sg, graph_size);
@@ -837,7 +1399,7 @@ int store_shm_ll_404_graph(struct par_env* pe, char* file_name, struct ll_404_gr
 		for(unsigned long e=0; e < 2UL * g->edges_count; e++)
 			sg_edges[e] = g->edges_list[e];
 
-		int ret = msync(sg, graph_size, MS_SYNC);
+		ret = msync(sg, graph_size, MS_SYNC);
 		assert(ret == 0);
 
 		munmap(sg, graph_size);
@@ -881,6 +1443,8 @@ void delete_shm_graph_from(char* file_name)
 void release_numa_interleaved_ll_400_graph(struct ll_400_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
 
 	numa_free(g->offsets_list, sizeof(unsigned long)*(1 + g->vertices_count));
 	g->offsets_list = NULL;
@@ -900,6 +1464,8 @@ void release_numa_interleaved_ll_400_graph(struct ll_400_graph* g)
 void release_shm_ll_400_graph(struct ll_400_graph* g)
 {
 	assert(g != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
 	assert( (void*)(g->offsets_list - 2) == (void*)(g->edges_list - 2 * (2 + g->vertices_count + 1)) );
 
 	unsigned long graph_size = (2 + g->vertices_count + 1) * sizeof(unsigned long) + g->edges_count * sizeof(unsigned int);
@@ -917,6 +1483,8 @@ void release_shm_ll_400_graph(struct ll_400_graph* g)
 void release_numa_interleaved_ll_800_graph(struct ll_800_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
 
 	numa_free(g->offsets_list, sizeof(unsigned long)*(1 + g->vertices_count));
 	g->offsets_list = NULL;
@@ -933,9 +1501,32 @@ void release_numa_interleaved_ll_800_graph(struct ll_800_graph* g)
 	return;
 }
 
+void release_numa_interleaved_ll_400_c32_graph(struct ll_400_c32_graph* g)
+{
+	assert(g!= NULL && g->offsets_list != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
+
+	numa_free(g->offsets_list, sizeof(unsigned int)*(1 + g->vertices_count));
+	g->offsets_list = NULL;
+
+	if(g->edges_list)
+	{
+		numa_free(g->edges_list, sizeof(unsigned int) * g->edges_count);
+		g->edges_list = NULL;
+	}
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
 void release_numa_interleaved_ll_404_graph(struct ll_404_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
 
 	numa_free(g->offsets_list, sizeof(unsigned long)*(1 + g->vertices_count));
 	g->offsets_list = NULL;
@@ -952,9 +1543,38 @@ void release_numa_interleaved_ll_404_graph(struct ll_404_graph* g)
 	return;
 }
 
+void release_numa_interleaved_ll_404_soa_graph(struct ll_404_soa_graph* g)
+{
+	assert(g!= NULL && g->offsets_list != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
+
+	numa_free(g->offsets_list, sizeof(unsigned long)*(1 + g->vertices_count));
+	g->offsets_list = NULL;
+
+	if(g->edges_list)
+	{
+		numa_free(g->edges_list, sizeof(unsigned int) * g->edges_count);
+		g->edges_list = NULL;
+	}
+
+	if(g->weights_list)
+	{
+		numa_free(g->weights_list, sizeof(unsigned int) * g->edges_count);
+		g->weights_list = NULL;
+	}
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
 void release_shm_ll_404_graph(struct ll_404_graph* g)
 {
 	assert(g != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
 	assert( (void*)(g->offsets_list - 2) == (void*)(g->edges_list - 2 * (2 + g->vertices_count + 1)) );
 
 	unsigned long graph_size = (2 + g->vertices_count + 1) * sizeof(unsigned long) + 2 * g->edges_count * sizeof(unsigned int);
@@ -969,4 +1589,436 @@ void release_shm_ll_404_graph(struct ll_404_graph* g)
 	return;
 }
 
+/*
+	Binary CSR/CSC container 
+
+	The file starts with a header page (`struct ll_bin_graph_header`) followed by the offsets section 
+	((|V| + 1) unsigned long elements) and the edges section (|E| elements of 4 Bytes for ll_400_graph, 
+	|E| pairs of 4 Bytes for ll_404_graph, and |E| elements of 8 Bytes for ll_800_graph).
+	Both sections are page-aligned and zero-padded to a multiple of the page size, 
+	so a graph can be mapped to memory and used without copying.
+
+	`checksum` covers the (padded) offsets and edges sections.
+*/
+
+#define LL_BIN_GRAPH_MAGIC "LLGRAPH"
+#define LL_BIN_GRAPH_VERSION 1U
+#define LL_BIN_GRAPH_PAGE_SIZE 4096UL
+
+// Properties of the graph stored in the header 
+#define LL_GRAPH_PROPERTY_SYMMETRIC              (1UL << 0)
+#define LL_GRAPH_PROPERTY_SORTED_NEIGHBOUR_LISTS (1UL << 1)
+#define LL_GRAPH_PROPERTY_NO_SELF_EDGES          (1UL << 2)
+#define LL_GRAPH_PROPERTY_CSC                    (1UL << 3)
+
+struct ll_bin_graph_header
+{
+	char magic[8];
+	unsigned int version;
+	unsigned int type;     // 400, 404, or 800
+	unsigned long properties;
+
+	unsigned long vertices_count;
+	unsigned long edges_count;
+
+	unsigned long offsets_section_offset;
+	unsigned long offsets_section_size;
+	unsigned long edges_section_offset;
+	unsigned long edges_section_size;
+
+	unsigned long checksum;
+};
+
+unsigned long __ll_bin_graph_edge_size(unsigned int type)
+{
+	if(type == 400)
+		return sizeof(unsigned int);
+	if(type == 404)
+		return 2UL * sizeof(unsigned int);
+	if(type == 800)
+		return sizeof(unsigned long);
+
+	assert(0 && "Unknown binary graph type.");
+	return 0;
+}
+
+void __ll_bin_graph_set_layout(struct ll_bin_graph_header* h, unsigned int type, unsigned long vertices_count, unsigned long edges_count)
+{
+	#define __LL_PAGE_ROUND_UP(x) ((((x) + LL_BIN_GRAPH_PAGE_SIZE - 1) / LL_BIN_GRAPH_PAGE_SIZE) * LL_BIN_GRAPH_PAGE_SIZE)
+
+	memset(h, 0, sizeof(struct ll_bin_graph_header));
+	strcpy(h->magic, LL_BIN_GRAPH_MAGIC);
+	h->version = LL_BIN_GRAPH_VERSION;
+	h->type = type;
+	h->vertices_count = vertices_count;
+	h->edges_count = edges_count;
+
+	h->offsets_section_offset = LL_BIN_GRAPH_PAGE_SIZE;
+	h->offsets_section_size = __LL_PAGE_ROUND_UP(sizeof(unsigned long) * (vertices_count + 1));
+	h->edges_section_offset = h->offsets_section_offset + h->offsets_section_size;
+	h->edges_section_size = __LL_PAGE_ROUND_UP(__ll_bin_graph_edge_size(type) * edges_count);
+
+	#undef __LL_PAGE_ROUND_UP
+
+	return;
+}
+
+/*
+	A position-dependent sum of the splitmix64-mixed 8-Bytes words of `mem`. 
+	`start_index` is the index of the first word of `mem` in the whole checksummed area.
+*/
+unsigned long ll_bin_graph_checksum(void* mem, unsigned long size, unsigned long start_index)
+{
+	assert(size % sizeof(unsigned long) == 0);
+
+	unsigned long* words = (unsigned long*)mem;
+	unsigned long words_count = size / sizeof(unsigned long);
+	unsigned long sum = 0;
+
+	#pragma omp parallel for reduction(+:sum)
+	for(unsigned long w = 0; w < words_count; w++)
+	{
+		unsigned long z = words[w] + 0x9e3779b97f4a7c15UL * (start_index + w + 1);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+		sum += z ^ (z >> 31);
+	}
+
+	return sum;
+}
+
+/*
+	Writes a graph in the binary format. 
+	`edges_list` should contain `edges_count * __ll_bin_graph_edge_size(type)` bytes.
+	`properties` is a combination of `LL_GRAPH_PROPERTY_*` flags.
+
+	Returns 0 on success.
+*/
+int __store_ll_bin_graph(char* file_name, unsigned int type, unsigned long vertices_count, unsigned long edges_count, 
+	unsigned long* offsets_list, void* edges_list, unsigned long properties)
+{
+	assert(file_name != NULL && offsets_list != NULL);
+	assert(edges_list != NULL || edges_count == 0);
+
+	unsigned long t1 = - get_nano_time();
+
+	struct ll_bin_graph_header h;
+	__ll_bin_graph_set_layout(&h, type, vertices_count, edges_count);
+	h.properties = properties;
+	unsigned long file_size = h.edges_section_offset + h.edges_section_size;
+
+	int fd = open(file_name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0)
+	{
+		printf("Can't open the file: %s, %d - %s\n", file_name, errno, strerror(errno));
+		return -1;
+	}
+
+	int ret = ftruncate(fd, file_size);
+	if(ret != 0)
+	{
+		printf("Can't truncate the file: %s, %d - %s\n", file_name, errno, strerror(errno));
+		close(fd);
+		return -1;
+	}
+
+	char* mem = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	fd = -1;
+	if(mem == MAP_FAILED)
+	{
+		printf("Can't mmap the file: %s, %d - %s\n", file_name, errno, strerror(errno));
+		return -1;
+	}
+
+	// Writing offsets and edges, the padding bytes remain zero by ftruncate()
+		unsigned long* offsets = (unsigned long*)(mem + h.offsets_section_offset);
+		#pragma omp parallel for 
+		for(unsigned long v = 0; v <= vertices_count; v++)
+			offsets[v] = offsets_list[v];
+
+		unsigned long edges_bytes = __ll_bin_graph_edge_size(type) * edges_count;
+		unsigned long chunk = 1UL << 24;
+		#pragma omp parallel for 
+		for(unsigned long c = 0; c < edges_bytes; c += chunk)
+			memcpy(mem + h.edges_section_offset + c, (char*)edges_list + c, min(chunk, edges_bytes - c));
+
+	// Checksum and header
+		h.checksum = ll_bin_graph_checksum(mem + h.offsets_section_offset, h.offsets_section_size + h.edges_section_size, 0);
+		memcpy(mem, &h, sizeof(struct ll_bin_graph_header));
+
+	ret = msync(mem, file_size, MS_SYNC);
+	assert(ret == 0);
+	munmap(mem, file_size);
+	mem = NULL;
+
+	t1 += get_nano_time();
+	printf("Binary graph %s (type: %u, %'.1f MB) written in %'.3f (seconds)\n", file_name, type, file_size / 1e6, t1 / 1e9);
+
+	return 0;
+}
+
+int store_ll_400_bin_graph(struct par_env* pe, char* file_name, struct ll_400_graph* g, unsigned long properties)
+{
+	assert(g != NULL);
+	return __store_ll_bin_graph(file_name, 400, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list, properties);
+}
+
+int store_ll_404_bin_graph(struct par_env* pe, char* file_name, struct ll_404_graph* g, unsigned long properties)
+{
+	assert(g != NULL);
+	return __store_ll_bin_graph(file_name, 404, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list, properties);
+}
+
+int store_ll_800_bin_graph(struct par_env* pe, char* file_name, struct ll_800_graph* g, unsigned long properties)
+{
+	assert(g != NULL);
+	return __store_ll_bin_graph(file_name, 800, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list, properties);
+}
+
+/*
+	Maps a binary graph of type `type` to memory. The returned struct points to the mapped 
+	offsets and edges sections; therefore no memory is allocated for the graph.
+
+	`flags`:
+		bit 0: 
+			Interleave the pages of the graph over NUMA nodes. The page cache pages of the file are 
+			allocated by the threads that fault them in, so an interleave policy is set on all threads and 
+			the graph is touched in parallel. The pages that are already in the OS cache are not moved.
+
+		bit 1: 
+			Validate the checksum.
+
+		bit 30: 
+			Will be set by the function. It specifies the graph should be released 
+			by `release_bin_ll_400_graph()` (or its 404 and 800 counterparts).
+
+	The properties of the graph (`LL_GRAPH_PROPERTY_*`) are written to `properties` if it is not NULL.
+*/
+void* __get_ll_bin_graph(char* file_name, unsigned int type, unsigned int* flags, unsigned long* properties)
+{
+	// Checks
+		assert(flags != NULL);
+
+		if(access(file_name, F_OK) != 0)
+		{
+			printf("Error: file \"%s\" does not exist\n",file_name);
+			return NULL;
+		}
+
+	unsigned long t1 = - get_nano_time();
+
+	// Reading and checking the header
+		struct ll_bin_graph_header h;
+		{
+			int fd = open(file_name, O_RDONLY);
+			assert(fd > 0);
+			long ret = pread(fd, &h, sizeof(struct ll_bin_graph_header), 0);
+			assert(ret == sizeof(struct ll_bin_graph_header));
+			close(fd);
+			fd = -1;
+		}
+
+		if(strncmp(h.magic, LL_BIN_GRAPH_MAGIC, 8) != 0 || h.version != LL_BIN_GRAPH_VERSION)
+		{
+			printf("Error: \"%s\" is not a binary graph of version %u.\n", file_name, LL_BIN_GRAPH_VERSION);
+			return NULL;
+		}
+
+		if(h.type != type)
+		{
+			printf("Error: \"%s\" has type %u, but type %u was requested.\n", file_name, h.type, type);
+			return NULL;
+		}
+
+		{
+			struct ll_bin_graph_header eh;
+			__ll_bin_graph_set_layout(&eh, h.type, h.vertices_count, h.edges_count);
+			assert(eh.offsets_section_offset == h.offsets_section_offset && eh.offsets_section_size == h.offsets_section_size);
+			assert(eh.edges_section_offset == h.edges_section_offset && eh.edges_section_size == h.edges_section_size);
+		}
+
+		unsigned long file_size = h.edges_section_offset + h.edges_section_size;
+		assert(get_file_size(file_name) >= file_size);
+
+		printf("Vertices: %'lu\n", h.vertices_count);
+		printf("Edges: %'lu\n", h.edges_count);
+		printf("Properties: 0x%lx\n", h.properties);
+
+	// Mapping
+		char* mem = NULL;
+		{
+			int fd = open(file_name, O_RDONLY);
+			assert(fd > 0);
+			mem = mmap(NULL, file_size, PROT_READ, MAP_SHARED, fd, 0);
+			close(fd);
+			fd = -1;
+			if(mem == MAP_FAILED)
+			{
+				printf("Couldn't map the graph -> mmap error : %d, %s\n", errno, strerror(errno));
+				return NULL;
+			}
+		}
+
+	// Interleaving pages 
+		if(*flags & 1U)
+		{
+			unsigned long pages_count = file_size / LL_BIN_GRAPH_PAGE_SIZE;
+			unsigned long sum = 0;
+			#pragma omp parallel reduction(+:sum)
+			{
+				numa_set_interleave_mask(numa_all_nodes_ptr);
+
+				#pragma omp for
+				for(unsigned long p = 0; p < pages_count; p++)
+					sum += mem[p * LL_BIN_GRAPH_PAGE_SIZE];
+
+				numa_set_localalloc();
+			}
+			assert(sum != -1UL);
+		}
+
+	// Validating checksum
+		if(*flags & 2U)
+		{
+			unsigned long checksum = ll_bin_graph_checksum(mem + h.offsets_section_offset, h.offsets_section_size + h.edges_section_size, 0);
+			if(checksum != h.checksum)
+			{
+				printf("Error: checksum mismatch for \"%s\": %lx != %lx\n", file_name, checksum, h.checksum);
+				munmap(mem, file_size);
+				return NULL;
+			}
+		}
+
+	// Creating the struct, the 400, 404, and 800 structs have the same layout
+		struct ll_400_graph* g = calloc(sizeof(struct ll_400_graph), 1);
+		assert(g != NULL);
+		g->vertices_count = h.vertices_count;
+		g->edges_count = h.edges_count;
+		g->offsets_list = (unsigned long*)(mem + h.offsets_section_offset);
+		g->edges_list = (unsigned int*)(mem + h.edges_section_offset);
+		assert(g->offsets_list[g->vertices_count] == g->edges_count);
+
+		if(properties != NULL)
+			*properties = h.properties;
+
+	t1 += get_nano_time();
+	printf("Mapping %'.1f (MB) completed in %'.3f (seconds)\n", file_size/1e6, t1/1e9); 
+
+	*flags &= ~(1U<<31);
+	*flags |= 1U<<30;
+
+	return g;
+}
+
+struct ll_400_graph* get_ll_400_bin_graph(char* file_name, unsigned int* flags, unsigned long* properties)
+{
+	struct ll_400_graph* g = __get_ll_bin_graph(file_name, 400, flags, properties);
+	if(g != NULL)
+		print_ll_400_graph(g);
+
+	return g;
+}
+
+struct ll_404_graph* get_ll_404_bin_graph(char* file_name, unsigned int* flags, unsigned long* properties)
+{
+	struct ll_404_graph* g = __get_ll_bin_graph(file_name, 404, flags, properties);
+	if(g != NULL)
+		print_ll_400_graph((struct ll_400_graph*)g);
+
+	return g;
+}
+
+struct ll_800_graph* get_ll_800_bin_graph(char* file_name, unsigned int* flags, unsigned long* properties)
+{
+	return __get_ll_bin_graph(file_name, 800, flags, properties);
+}
+
+void __release_bin_graph(unsigned int type, unsigned long vertices_count, unsigned long edges_count, void* offsets_list)
+{
+	struct ll_bin_graph_header h;
+	__ll_bin_graph_set_layout(&h, type, vertices_count, edges_count);
+
+	int ret = munmap((char*)offsets_list - h.offsets_section_offset, h.edges_section_offset + h.edges_section_size);
+	assert(ret == 0);
+
+	return;
+}
+
+void release_bin_ll_400_graph(struct ll_400_graph* g)
+{
+	assert(g != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
+	__release_bin_graph(400, g->vertices_count, g->edges_count, g->offsets_list);
+	
+	g->offsets_list = NULL;
+	g->edges_list = NULL;
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
+void release_bin_ll_404_graph(struct ll_404_graph* g)
+{
+	assert(g != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
+	__release_bin_graph(404, g->vertices_count, g->edges_count, g->offsets_list);
+	
+	g->offsets_list = NULL;
+	g->edges_list = NULL;
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
+void release_bin_ll_800_graph(struct ll_800_graph* g)
+{
+	assert(g != NULL);
+	if(graph_release_hook != NULL)
+		graph_release_hook(g);
+	__release_bin_graph(800, g->vertices_count, g->edges_count, g->offsets_list);
+	
+	g->offsets_list = NULL;
+	g->edges_list = NULL;
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
+/*
+	Releases an input graph based on the `flags` set by its loader 
+	(i.e., `get_ll_400_txt_graph()`, `get_ll_400_webgraph()`, or `get_ll_400_bin_graph()`).
+*/
+void release_ll_400_graph(struct ll_400_graph* g, unsigned int read_flags)
+{
+	if(read_flags & 1U<<31)
+		release_shm_ll_400_graph(g);
+	else if(read_flags & 1U<<30)
+		release_bin_ll_400_graph(g);
+	else
+		release_numa_interleaved_ll_400_graph(g);
+
+	return;
+}
+
+void release_ll_404_graph(struct ll_404_graph* g, unsigned int read_flags)
+{
+	if(read_flags & 1U<<31)
+		release_shm_ll_404_graph(g);
+	else if(read_flags & 1U<<30)
+		release_bin_ll_404_graph(g);
+	else
+		release_numa_interleaved_ll_404_graph(g);
+
+	return;
+}
+
 #endif
@@ -0,0 +1,461 @@
+#ifndef __GRAPH_CACHE_C
+#define __GRAPH_CACHE_C
+
+/*
+	A content-addressed cache of derived graphs, i.e., the symmetric, transposed, degree-ordered, and
+	weighted graphs that are created from an input graph. It generalises the caching of random orderings
+	by get_create_fixed_random_ordering() in relabel.c.
+
+	The key of a derived graph is created from the fingerprint of its input graph (`ll_graph_fingerprint()`),
+	the name of the transformation, and the parameters that change the result, e.g.,
+	`ll_gc_<fingerprint>_sym_6` for the graph created by `symmetrize_graph(pe, g, 2U + 4U)`.
+
+	`LL_GRAPH_CACHE` (aux.c) specifies where the derived graphs are stored:
+		bit 0: in /dev/shm as `<key>`, with the layout of `store_shm_ll_400_graph()` and `store_shm_ll_404_graph()`
+		bit 1: on disk in the binary format (graph.c) as `<LL_GRAPH_CACHE_FOLDER>/<key>.llg`
+
+	The cache is checked in the same order. A graph that is found on disk but not in /dev/shm is also
+	copied to /dev/shm.
+
+	The size of each of the two stores is limited to `LL_GRAPH_CACHE_BUDGET_GB`. The modification time of
+	a cached graph is updated on each hit and after storing a new graph, the least recently used graphs
+	are removed until the store fits in the budget. The new graph is not removed, even if it is larger than the budget.
+
+	The `*_cached()` functions return a graph that should be released by `release_ll_400_graph()`
+	(or `release_ll_404_graph()`) using the `flags` set by them: bit 31 for /dev/shm graphs, bit 30 for
+	graphs mapped from disk, and none for the graphs created (or copied) in NUMA-interleaved memory.
+*/
+
+#include <dirent.h>
+
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+
+#define LL_GRAPH_CACHE_PREFIX "ll_gc_"
+
+/*
+	A 64-bit fingerprint of the content of a graph, `edge_size` is the Bytes per edge in `edges_list`.
+*/
+unsigned long ll_graph_fingerprint(unsigned long vertices_count, unsigned long edges_count, unsigned long* offsets_list, void* edges_list, unsigned long edge_size)
+{
+	assert(offsets_list != NULL && (edges_list != NULL || edges_count == 0));
+
+	unsigned long edges_bytes = edges_count * edge_size;
+	unsigned long fp = ll_bin_graph_checksum(offsets_list, sizeof(unsigned long) * (vertices_count + 1), 0);
+	fp += ll_bin_graph_checksum(edges_list, edges_bytes & ~7UL, vertices_count + 1);
+	if(edges_bytes % 8)
+	{
+		unsigned long tail = 0;
+		memcpy(&tail, (char*)edges_list + (edges_bytes & ~7UL), edges_bytes % 8);
+		fp += ll_bin_graph_checksum(&tail, sizeof(unsigned long), vertices_count + 1 + edges_bytes / 8);
+	}
+	fp ^= vertices_count * 0x9e3779b97f4a7c15UL + edges_count;
+
+	return fp;
+}
+
+/*
+	Returns the key of the graph created by `transformation` with `params` from the graph with `fingerprint`.
+	The caller should free() it.
+*/
+char* ll_graph_cache_key(unsigned long fingerprint, char* transformation, unsigned long params)
+{
+	assert(transformation != NULL);
+
+	char* key = malloc(PATH_MAX);
+	assert(key != NULL);
+	sprintf(key, LL_GRAPH_CACHE_PREFIX "%016lx_%s_%lx", fingerprint, transformation, params);
+
+	return key;
+}
+
+/*
+	Removes the least recently modified cached graphs of `folder` until their total size fits in
+	`LL_GRAPH_CACHE_BUDGET_GB`. The file named `keep` is not removed.
+*/
+void __ll_graph_cache_evict(char* folder, char* keep)
+{
+	DIR* dir = opendir(folder);
+	if(dir == NULL)
+		return;
+
+	unsigned long budget = LL_GRAPH_CACHE_BUDGET_GB << 30;
+	unsigned long entries_count = 0;
+	unsigned long entries_size = 0;
+	char** names = NULL;
+	unsigned long* sizes = NULL;
+	unsigned long* mtimes = NULL;
+	unsigned long total_size = 0;
+
+	// (1) Listing the cached graphs
+		char* path = malloc(PATH_MAX);
+		assert(path != NULL);
+		struct dirent* de = NULL;
+		while((de = readdir(dir)) != NULL)
+		{
+			if(strncmp(de->d_name, LL_GRAPH_CACHE_PREFIX, strlen(LL_GRAPH_CACHE_PREFIX)) != 0)
+				continue;
+			if(strstr(de->d_name, ".tmp") != NULL)
+				continue;
+
+			struct stat st;
+			sprintf(path, "%s/%s", folder, de->d_name);
+			if(stat(path, &st) != 0)
+				continue;
+
+			if(entries_count == entries_size)
+			{
+				entries_size = max(16UL, 2 * entries_size);
+				names = realloc(names, sizeof(char*) * entries_size);
+				sizes = realloc(sizes, sizeof(unsigned long) * entries_size);
+				mtimes = realloc(mtimes, sizeof(unsigned long) * entries_size);
+				assert(names != NULL && sizes != NULL && mtimes != NULL);
+			}
+
+			names[entries_count] = strdup(de->d_name);
+			assert(names[entries_count] != NULL);
+			sizes[entries_count] = st.st_size;
+			mtimes[entries_count] = st.st_mtim.tv_sec * 1000000000UL + st.st_mtim.tv_nsec;
+			total_size += st.st_size;
+			entries_count++;
+		}
+		closedir(dir);
+		dir = NULL;
+
+	// (2) Removing the LRU graphs
+		while(total_size > budget)
+		{
+			unsigned long lru = -1UL;
+			for(unsigned long i = 0; i < entries_count; i++)
+				if(names[i] != NULL && strcmp(names[i], keep) != 0)
+					if(lru == -1UL || mtimes[i] < mtimes[lru])
+						lru = i;
+			if(lru == -1UL)
+				break;
+
+			sprintf(path, "%s/%s", folder, names[lru]);
+			if(unlink(path) == 0)
+				printf("Graph cache: removed %s (%'.1f MB)\n", path, sizes[lru] / 1e6);
+			total_size -= sizes[lru];
+			free(names[lru]);
+			names[lru] = NULL;
+		}
+
+	// Releasing memory
+		for(unsigned long i = 0; i < entries_count; i++)
+			if(names[i] != NULL)
+			{
+				free(names[i]);
+				names[i] = NULL;
+			}
+		free(names);
+		names = NULL;
+		free(sizes);
+		sizes = NULL;
+		free(mtimes);
+		mtimes = NULL;
+		free(path);
+		path = NULL;
+
+	return;
+}
+
+/*
+	Stores the derived graph `g` of `type` (400 or 404) with `key` in the stores selected by `LL_GRAPH_CACHE`.
+	The graphs are written to temporary files and then renamed, so a partially written graph is never found.
+*/
+void __ll_graph_cache_put(struct par_env* pe, char* key, unsigned int type, struct ll_400_graph* g, unsigned long properties)
+{
+	assert(key != NULL && g != NULL && (type == 400 || type == 404));
+
+	char* tmp = malloc(PATH_MAX);
+	assert(tmp != NULL);
+	char* path = malloc(PATH_MAX);
+	assert(path != NULL);
+
+	// /dev/shm
+		if(LL_GRAPH_CACHE & 1U)
+		{
+			sprintf(tmp, "%s.tmp", key);
+			int ret = -1;
+			if(type == 400)
+				ret = store_shm_ll_400_graph(pe, tmp, g, 1U);
+			else
+				ret = store_shm_ll_404_graph(pe, tmp, (struct ll_404_graph*)g, 1U);
+
+			if(ret == 0)
+			{
+				char* src = strdup(tmp);
+				assert(src != NULL);
+				sprintf(tmp, "/dev/shm/%s.tmp", key);
+				sprintf(path, "/dev/shm/%s", key);
+				if(rename(tmp, path) != 0)
+				{
+					printf("Graph cache: can't rename %s, %d - %s\n", tmp, errno, strerror(errno));
+					shm_unlink(src);
+				}
+				free(src);
+				src = NULL;
+				__ll_graph_cache_evict("/dev/shm", key);
+			}
+		}
+
+	// Disk
+		if(LL_GRAPH_CACHE & 2U)
+		{
+			struct stat st = {0};
+			if(stat(LL_GRAPH_CACHE_FOLDER, &st) == -1)
+				mkdir(LL_GRAPH_CACHE_FOLDER, 0700);
+
+			sprintf(tmp, "%s/%s.llg.tmp", LL_GRAPH_CACHE_FOLDER, key);
+			sprintf(path, "%s/%s.llg", LL_GRAPH_CACHE_FOLDER, key);
+			if(__store_ll_bin_graph(tmp, type, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list, properties) == 0)
+			{
+				if(rename(tmp, path) != 0)
+				{
+					printf("Graph cache: can't rename %s, %d - %s\n", tmp, errno, strerror(errno));
+					unlink(tmp);
+				}
+				sprintf(tmp, "%s.llg", key);
+				__ll_graph_cache_evict(LL_GRAPH_CACHE_FOLDER, tmp);
+			}
+		}
+
+	free(tmp);
+	tmp = NULL;
+	free(path);
+	path = NULL;
+
+	return;
+}
+
+/*
+	Returns the derived graph with `key` and `type` (400 or 404), or NULL if it is not in the cache.
+	Bits 30 and 31 of `flags` are set as explained at the top of this file.
+*/
+struct ll_400_graph* __ll_graph_cache_get(struct par_env* pe, char* key, unsigned int type, unsigned int* flags)
+{
+	assert(key != NULL && flags != NULL && (type == 400 || type == 404));
+	*flags &= ~(3U << 30);
+
+	unsigned long edge_size = __ll_bin_graph_edge_size(type);
+	struct ll_400_graph* g = NULL;
+	char* path = malloc(PATH_MAX);
+	assert(path != NULL);
+
+	// /dev/shm
+		if(LL_GRAPH_CACHE & 1U)
+		{
+			int shm_fd = shm_open(key, O_RDONLY, 0);
+			if(shm_fd >= 0)
+			{
+				struct stat st;
+				int ret = fstat(shm_fd, &st);
+				assert(ret == 0);
+
+				unsigned long* ul_graph = NULL;
+				if(st.st_size >= 3 * sizeof(unsigned long))
+					ul_graph = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, shm_fd, 0);
+				close(shm_fd);
+				shm_fd = -1;
+
+				if(ul_graph != NULL && ul_graph != MAP_FAILED)
+				{
+					unsigned long graph_size = (2 + ul_graph[0] + 1) * sizeof(unsigned long) + ul_graph[1] * edge_size;
+					if(graph_size == st.st_size)
+					{
+						g = calloc(sizeof(struct ll_400_graph), 1);
+						assert(g != NULL);
+						g->vertices_count = ul_graph[0];
+						g->edges_count = ul_graph[1];
+						g->offsets_list = &ul_graph[2];
+						g->edges_list = (unsigned int*)(&ul_graph[2 + ul_graph[0] + 1]);
+						*flags |= 1U << 31;
+
+						sprintf(path, "/dev/shm/%s", key);
+						utimensat(AT_FDCWD, path, NULL, 0);
+						printf("Graph cache: found %s in /dev/shm\n", key);
+					}
+					else
+						munmap(ul_graph, st.st_size);
+				}
+			}
+		}
+
+	// Disk
+		if(g == NULL && (LL_GRAPH_CACHE & 2U))
+		{
+			sprintf(path, "%s/%s.llg", LL_GRAPH_CACHE_FOLDER, key);
+			if(access(path, F_OK) == 0)
+			{
+				unsigned int bin_flags = 1U;  // interleaving pages
+				g = __get_ll_bin_graph(path, type, &bin_flags, NULL);
+				if(g != NULL)
+				{
+					utimensat(AT_FDCWD, path, NULL, 0);
+					printf("Graph cache: found %s\n", path);
+
+					// Copying to /dev/shm for the next runs
+					if(LL_GRAPH_CACHE & 1U)
+					{
+						unsigned int cache_flags = LL_GRAPH_CACHE;
+						LL_GRAPH_CACHE = 1U;
+						__ll_graph_cache_put(pe, key, type, g, 0);
+						LL_GRAPH_CACHE = cache_flags;
+					}
+
+					*flags |= bin_flags & (1U << 30);
+				}
+			}
+		}
+
+	free(path);
+	path = NULL;
+
+	return g;
+}
+
+/*
+	`symmetrize_graph()` that reuses the cached symmetric graph of `in_graph`
+*/
+struct ll_400_graph* symmetrize_graph_cached(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags, unsigned int* out_flags)
+{
+	assert(pe != NULL && in_graph != NULL && out_flags != NULL);
+	*out_flags &= ~(3U << 30);
+	if(LL_GRAPH_CACHE == 0)
+		return symmetrize_graph(pe, in_graph, flags);
+
+	unsigned long fp = ll_graph_fingerprint(in_graph->vertices_count, in_graph->edges_count, in_graph->offsets_list, in_graph->edges_list, sizeof(unsigned int));
+	char* key = ll_graph_cache_key(fp, "sym", flags & 6U);  // bit 0 (validation) does not change the result
+	struct ll_400_graph* out_graph = __ll_graph_cache_get(pe, key, 400, out_flags);
+	if(out_graph == NULL)
+	{
+		out_graph = symmetrize_graph(pe, in_graph, flags);
+		if(out_graph != NULL)
+		{
+			unsigned long properties = LL_GRAPH_PROPERTY_SYMMETRIC;
+			if(flags & 2U)
+				properties |= LL_GRAPH_PROPERTY_SORTED_NEIGHBOUR_LISTS;
+			if(flags & 4U)
+				properties |= LL_GRAPH_PROPERTY_NO_SELF_EDGES;
+			__ll_graph_cache_put(pe, key, 400, out_graph, properties);
+		}
+	}
+
+	free(key);
+	key = NULL;
+
+	return out_graph;
+}
+
+/*
+	`potra()` that reuses the cached transpose of `in_graph`.
+	The graphs without edges (bit 3 of `flags`) are not cached.
+*/
+struct ll_400_graph* potra_cached(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags, unsigned long* exec_info, unsigned int* out_flags)
+{
+	assert(pe != NULL && in_graph != NULL && out_flags != NULL);
+	*out_flags &= ~(3U << 30);
+	if(LL_GRAPH_CACHE == 0 || (flags & 8U))
+		return potra(pe, in_graph, flags, exec_info);
+
+	unsigned long fp = ll_graph_fingerprint(in_graph->vertices_count, in_graph->edges_count, in_graph->offsets_list, in_graph->edges_list, sizeof(unsigned int));
+	char* key = ll_graph_cache_key(fp, "potra", flags & 6U);  // sorting and removing self-edges
+	struct ll_400_graph* out_graph = __ll_graph_cache_get(pe, key, 400, out_flags);
+	if(out_graph == NULL)
+	{
+		out_graph = potra(pe, in_graph, flags, exec_info);
+		unsigned long properties = LL_GRAPH_PROPERTY_CSC;
+		if(flags & 2U)
+			properties |= LL_GRAPH_PROPERTY_SORTED_NEIGHBOUR_LISTS;
+		if(flags & 4U)
+			properties |= LL_GRAPH_PROPERTY_NO_SELF_EDGES;
+		__ll_graph_cache_put(pe, key, 400, out_graph, properties);
+	}
+
+	free(key);
+	key = NULL;
+
+	return out_graph;
+}
+
+/*
+	Relabels `in_graph` by the degree ordering of `sapco_sort_degree_ordering()` and
+	sorts the neighbour-lists. The result is cached.
+*/
+struct ll_400_graph* degree_ordered_graph_cached(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int* out_flags)
+{
+	assert(pe != NULL && in_graph != NULL && out_flags != NULL);
+	*out_flags &= ~(3U << 30);
+
+	char* key = NULL;
+	struct ll_400_graph* out_graph = NULL;
+	if(LL_GRAPH_CACHE)
+	{
+		unsigned long fp = ll_graph_fingerprint(in_graph->vertices_count, in_graph->edges_count, in_graph->offsets_list, in_graph->edges_list, sizeof(unsigned int));
+		key = ll_graph_cache_key(fp, "sapco", 2U);
+		out_graph = __ll_graph_cache_get(pe, key, 400, out_flags);
+	}
+
+	if(out_graph == NULL)
+	{
+		unsigned long exec_info[20] = {0};
+		unsigned int* RA_n2o = sapco_sort_degree_ordering(pe, in_graph, exec_info, 0);
+		assert(RA_n2o != NULL);
+
+		unsigned int* RA_o2n = numa_alloc_interleaved(sizeof(unsigned int) * in_graph->vertices_count);
+		assert(RA_o2n != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < in_graph->vertices_count; v++)
+			RA_o2n[RA_n2o[v]] = v;
+
+		out_graph = relabel_graph(pe, in_graph, RA_o2n, 2U); // 2: sort neighbour lists
+
+		numa_free(RA_o2n, sizeof(unsigned int) * in_graph->vertices_count);
+		RA_o2n = NULL;
+		numa_free(RA_n2o, sizeof(unsigned int) * in_graph->vertices_count);
+		RA_n2o = NULL;
+
+		if(key != NULL)
+			__ll_graph_cache_put(pe, key, 400, out_graph, LL_GRAPH_PROPERTY_SORTED_NEIGHBOUR_LISTS);
+	}
+
+	if(key != NULL)
+	{
+		free(key);
+		key = NULL;
+	}
+
+	return out_graph;
+}
+
+/*
+	`add_4B_weight_to_ll_400_graph()` that reuses the cached weighted graph of `g`.
+	The weights are repeatable for the same number of partitions (see __add_4B_weight_to_ll_400_graph()), 
+	so they are identified by `max_weight` and the number of partitions, that depends on the number of threads.
+*/
+struct ll_404_graph* add_4B_weight_to_ll_400_graph_cached(struct par_env* pe, struct ll_400_graph* g, unsigned int max_weight, unsigned int flags, unsigned int* out_flags)
+{
+	assert(pe != NULL && g != NULL && out_flags != NULL);
+	*out_flags &= ~(3U << 30);
+	if(LL_GRAPH_CACHE == 0)
+		return add_4B_weight_to_ll_400_graph(pe, g, max_weight, flags);
+
+	unsigned long fp = ll_graph_fingerprint(g->vertices_count, g->edges_count, g->offsets_list, g->edges_list, sizeof(unsigned int));
+	unsigned long partitions_count = pe->threads_count * LL_WEIGHTS_THREAD_PARTITIONS;
+	char* key = ll_graph_cache_key(fp, "w4", (partitions_count << 32) + max_weight);
+	struct ll_404_graph* out_graph = (struct ll_404_graph*)__ll_graph_cache_get(pe, key, 404, out_flags);
+	if(out_graph == NULL)
+	{
+		out_graph = add_4B_weight_to_ll_400_graph(pe, g, max_weight, flags);
+		__ll_graph_cache_put(pe, key, 404, (struct ll_400_graph*)out_graph, LL_GRAPH_PROPERTY_SYMMETRIC);
+	}
+
+	free(key);
+	key = NULL;
+
+	return out_graph;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+	Compile-time specialisation of functions for the width of vertex IDs
+
+	A `*.tpl.c` file contains functions that are written once and compiled for both 4 Bytes
+	and 8 Bytes vertex IDs. It is included twice by its module, e.g., by trans.c:
+
+		#define LL_IDW 4
+		#include "trans.tpl.c"
+		#undef LL_IDW
+		#define LL_IDW 8
+		#include "trans.tpl.c"
+		#undef LL_IDW
+
+	and each `*.tpl.c` file includes this file at its beginning to (re)define the macros below
+	for the current `LL_IDW`. So, this file has no include guard.
+
+		IDW_T:                   type of vertex IDs (also used for degrees and counts of vertices)
+		IDW_NONE:                the invalid vertex ID, i.e., all bits set
+		IDW_FMT:                 printf conversion of IDW_T, used as "%" IDW_FMT or "%'" IDW_FMT
+		IDW_ABS:                 abs() of the difference of two IDs
+		IDW_MAX_VERTICES:        upper bound of |V|
+		IDW_SEED(v):             initializer of the `unsigned int s[2]` seed of rand_xoroshiro64star() for vertex `v`
+		IDW_GRAPH:               the graph struct, `struct ll_400_graph` or `struct ll_800_graph`
+		IDW_FN(name4, name8):    the name of the function for the current width
+
+	and the helpers that the templates use:
+		IDW_BINARY_SEARCH:       uint_binary_search() or ulong_binary_search()
+		IDW_QUICK_SORT:          quick_sort_uint() or quick_sort_ulong()
+		IDW_PRINT_GRAPH:         print_ll_400_graph() or print_ll_800_graph()
+
+	The 4 Bytes specialisations keep the names and the memory footprint of the original
+	ll_400_graph functions. The 8 Bytes specialisations have the `_800` suffix.
+
+	The width of offsets is selected by `LL_OFW` (8 if it is not defined). With `LL_IDW == 4` and 
+	`LL_OFW == 4`, the functions are specialised for `struct ll_400_c32_graph` (|E| < 2^32) and 
+	have the `_c32` suffix:
+
+		IDW_OFF_T:               type of the elements of `offsets_list`
+		IDW_MAX_EDGES:           upper bound of |E|
+		IDW_PTIP(name, reads):   PTIP() of a step that reads `reads` elements of `offsets_list`, 
+		                         the reads are added to the counter of the function
+		IDW_OFFSETS_SAVED_INIT:  declares the counter of reads of `offsets_list`, at the beginning of the function
+		IDW_OFFSETS_SAVED_PRINT: prints the Bytes of offsets not read by using 4 Bytes offsets, once at the end 
+		                         of the function. It is estimated by the counted reads, not measured.
+*/
+
+#undef IDW_T
+#undef IDW_NONE
+#undef IDW_FMT
+#undef IDW_ABS
+#undef IDW_MAX_VERTICES
+#undef IDW_SEED
+#undef IDW_GRAPH
+#undef IDW_FN
+#undef IDW_BINARY_SEARCH
+#undef IDW_QUICK_SORT
+#undef IDW_PRINT_GRAPH
+#undef IDW_OFF_T
+#undef IDW_MAX_EDGES
+#undef IDW_PTIP
+#undef IDW_OFFSETS_SAVED_INIT
+#undef IDW_OFFSETS_SAVED_PRINT
+
+#if LL_IDW == 4 && defined(LL_OFW) && LL_OFW == 4
+	#define IDW_T                     unsigned int
+	#define IDW_NONE                  -1U
+	#define IDW_FMT                   "u"
+	#define IDW_ABS                   abs
+	#define IDW_MAX_VERTICES          (1UL << 32)
+	#define IDW_SEED(__v)             {__v + 1, __v + 2}
+	#define IDW_GRAPH                 struct ll_400_c32_graph
+	#define IDW_FN(__name4, __name8)  __name4 ## _c32
+	#define IDW_BINARY_SEARCH         uint_binary_search
+	#define IDW_QUICK_SORT            quick_sort_uint
+	#define IDW_PRINT_GRAPH           print_ll_400_c32_graph
+#elif LL_IDW == 4
+	#define IDW_T                     unsigned int
+	#define IDW_NONE                  -1U
+	#define IDW_FMT                   "u"
+	#define IDW_ABS                   abs
+	#define IDW_MAX_VERTICES          (1UL << 32)
+	#define IDW_SEED(__v)             {__v + 1, __v + 2}
+	#define IDW_GRAPH                 struct ll_400_graph
+	#define IDW_FN(__name4, __name8)  __name4
+	#define IDW_BINARY_SEARCH         uint_binary_search
+	#define IDW_QUICK_SORT            quick_sort_uint
+	#define IDW_PRINT_GRAPH           print_ll_400_graph
+#elif LL_IDW == 8
+	#define IDW_T                     unsigned long
+	#define IDW_NONE                  -1UL
+	#define IDW_FMT                   "lu"
+	#define IDW_ABS                   labs
+	#define IDW_MAX_VERTICES          -1UL
+	#define IDW_SEED(__v)             {(unsigned int)(__v + 1), (unsigned int)((__v >> 32) + 2)}
+	#define IDW_GRAPH                 struct ll_800_graph
+	#define IDW_FN(__name4, __name8)  __name8
+	#define IDW_BINARY_SEARCH         ulong_binary_search
+	#define IDW_QUICK_SORT            quick_sort_ulong
+	#define IDW_PRINT_GRAPH           print_ll_800_graph
+#else
+	#error "LL_IDW should be defined as 4 or 8 before including id_width.c"
+#endif
+
+#if defined(LL_OFW) && LL_OFW == 4
+	#if LL_IDW != 4
+		#error "4 Bytes offsets (LL_OFW == 4) are only supported for 4 Bytes IDs"
+	#endif
+	#define IDW_OFF_T                 unsigned int
+	#define IDW_MAX_EDGES             (1UL << 32)
+	#define IDW_PTIP(__step_name, __offsets_reads) \
+	{ \
+		PTIP(__step_name); \
+		idw_offsets_reads += (unsigned long)(__offsets_reads); \
+	}
+	#define IDW_OFFSETS_SAVED_INIT    unsigned long idw_offsets_reads = 0
+	#define IDW_OFFSETS_SAVED_PRINT() \
+		printf("Offsets saved (est.):\t\t %'.1f (MB)\n", (sizeof(unsigned long) - sizeof(IDW_OFF_T)) * idw_offsets_reads / 1e6)
+#else
+	#define IDW_OFF_T                 unsigned long
+	#define IDW_MAX_EDGES             -1UL
+	#define IDW_PTIP(__step_name, __offsets_reads) PTIP(__step_name)
+	#define IDW_OFFSETS_SAVED_INIT
+	#define IDW_OFFSETS_SAVED_PRINT()
+#endif
@@ -0,0 +1,412 @@
+#ifndef __MEM_TRACKER_C
+#define __MEM_TRACKER_C
+
+#include <pthread.h>
+#include <numa.h>
+
+/*
+	Memory tracker
+
+	A thin layer over the allocations of libnuma: numa_alloc_interleaved(), numa_alloc_onnode(), numa_realloc(),
+	and numa_free() are redefined (at the end of this file) as macros that call mem_tracker_*() functions.
+	The arrays of numa_alloc_interleaved_huge() (omp.c) are also recorded.
+
+	The tracker records the live Bytes, the peak Bytes, and the Bytes on each NUMA node. Each allocation is tagged
+	by the function that has requested it (`__func__`, i.e., the algorithm or the step) and by the step
+	(the number of PTIP calls before the allocation). The NUMA placement is by the policy of allocation, i.e.,
+	interleaved over all nodes or on the requested node, and the pages that are moved later by
+	numa_bind_memory_range() (LL_NUMA_OWNER_LOCAL and LL_NUMA_HYBRID) are not considered.
+
+		- PTIP calls mem_tracker_step() that prints the high-water mark of the step (if `LL_MEM_TRACKER` is 1).
+		- Algorithms call mem_tracker_region_begin() and mem_tracker_region_end() to find their peak memory,
+		  that is stored in their `exec_info[16]`.
+		- A failed allocation prints the live Bytes of each tag by mem_tracker_print() before returning NULL.
+		- With `LL_MEM_TRACKER=1`, mem_tracker_print() is also called at exit.
+*/
+
+#define __MT_MAX_TAGS 256
+#define __MT_MAX_NODES 64
+#define __MT_MAX_REGIONS 16
+
+struct mem_tracker_record
+{
+	void* mem;
+	unsigned long size;
+	int node;           // -1 for interleaved
+	unsigned int tag;
+	unsigned int step;
+};
+
+struct mem_tracker_tag
+{
+	const char* name;
+	unsigned long live;
+	unsigned long peak;
+	unsigned long allocs_count;
+};
+
+struct mem_tracker
+{
+	pthread_mutex_t lock;
+	unsigned int nodes_count;
+	unsigned int exit_print;
+
+	unsigned long live;
+	unsigned long peak;
+	unsigned long nodes_live[__MT_MAX_NODES];
+	unsigned long untracked_frees;
+
+	// The high-water mark of the current step and the tag with the most live Bytes at that time
+	unsigned int steps_count;
+	unsigned long step_peak;
+	unsigned int step_peak_tag;
+	unsigned long step_peak_tag_bytes;
+
+	// The peaks of nested regions, see mem_tracker_region_begin()
+	unsigned int regions_count;
+	unsigned long regions_peak[__MT_MAX_REGIONS];
+
+	unsigned int tags_count;
+	struct mem_tracker_tag tags[__MT_MAX_TAGS];
+
+	// Live allocations, a hash table with linear probing by `mem`
+	struct mem_tracker_record* records;
+	unsigned long records_capacity;
+	unsigned long records_count;
+};
+
+struct mem_tracker mem_tracker = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+unsigned long __mem_tracker_hash(void* mem, unsigned long capacity)
+{
+	return (((unsigned long)mem >> 12) * 0x9E3779B97F4A7C15UL) & (capacity - 1);
+}
+
+// Returns the Bytes of an allocation of `size` Bytes on node `n`, `node` is -1 for interleaved allocations
+unsigned long __mem_tracker_node_bytes(unsigned long size, int node, unsigned int n)
+{
+	if(node >= 0)
+		return (unsigned int)node % mem_tracker.nodes_count == n ? size : 0;
+
+	return size / mem_tracker.nodes_count + (n < size % mem_tracker.nodes_count ? 1 : 0);
+}
+
+/*
+	Returns the peak resident set size of the process (VmHWM in /proc/self/status) in Bytes
+*/
+unsigned long get_peak_rss()
+{
+	FILE* f = fopen("/proc/self/status", "r");
+	if(f == NULL)
+		return 0;
+
+	unsigned long kb = 0;
+	char line[256];
+	while(fgets(line, sizeof(line), f) != NULL)
+		if(sscanf(line, "VmHWM: %lu kB", &kb) == 1)
+			break;
+	fclose(f);
+	f = NULL;
+
+	return kb * 1024;
+}
+
+unsigned int __mem_tracker_tag_index(const char* name)
+{
+	for(unsigned int t = 0; t < mem_tracker.tags_count; t++)
+		if(mem_tracker.tags[t].name == name || !strcmp(mem_tracker.tags[t].name, name))
+			return t;
+
+	if(mem_tracker.tags_count == __MT_MAX_TAGS)
+		return __MT_MAX_TAGS - 1;
+
+	mem_tracker.tags[mem_tracker.tags_count].name = name;
+	return mem_tracker.tags_count++;
+}
+
+/*
+	Prints the live and peak Bytes of the tags, and the largest live allocations with the step they have been allocated in
+*/
+void mem_tracker_print()
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+
+	printf("\nMemory tracker, live: %'.1f (MB), peak: %'.1f (MB), peak RSS: %'.1f (MB), untracked frees: %'lu\n",
+		mem_tracker.live / 1e6, mem_tracker.peak / 1e6, get_peak_rss() / 1e6, mem_tracker.untracked_frees);
+	printf("  %-40s %14s %14s %10s\n", "Tag", "Live (MB)", "Peak (MB)", "Allocs");
+	for(unsigned int t = 0; t < mem_tracker.tags_count; t++)
+		printf("  %-40s %'14.1f %'14.1f %'10lu\n", mem_tracker.tags[t].name, mem_tracker.tags[t].live / 1e6,
+			mem_tracker.tags[t].peak / 1e6, mem_tracker.tags[t].allocs_count);
+
+	// The 8 largest live allocations
+	struct mem_tracker_record largest[8] = {0};
+	for(unsigned long r = 0; r < mem_tracker.records_capacity; r++)
+	{
+		if(mem_tracker.records[r].mem == NULL || mem_tracker.records[r].size <= largest[7].size)
+			continue;
+		unsigned int l = 7;
+		for(; l > 0 && largest[l - 1].size < mem_tracker.records[r].size; l--)
+			largest[l] = largest[l - 1];
+		largest[l] = mem_tracker.records[r];
+	}
+	for(unsigned int l = 0; l < 8 && largest[l].mem != NULL; l++)
+		printf("  Live allocation %u: %'.1f (MB) by %s in step %u\n", l, largest[l].size / 1e6, mem_tracker.tags[largest[l].tag].name, largest[l].step);
+	printf("\n");
+
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return;
+}
+
+void __mem_tracker_exit()
+{
+	if(LL_MEM_TRACKER)
+		mem_tracker_print();
+
+	return;
+}
+
+void __mem_tracker_insert_record(struct mem_tracker_record* rec)
+{
+	unsigned long i = __mem_tracker_hash(rec->mem, mem_tracker.records_capacity);
+	while(mem_tracker.records[i].mem != NULL)
+		i = (i + 1) & (mem_tracker.records_capacity - 1);
+	mem_tracker.records[i] = *rec;
+
+	return;
+}
+
+/*
+	Records an allocation, `mem_tracker.lock` should be held by the caller
+*/
+void __mem_tracker_add(void* mem, unsigned long size, int node, const char* tag)
+{
+	// (1) Initialization and growing the hash table
+		if(mem_tracker.nodes_count == 0)
+			mem_tracker.nodes_count = min(max(numa_num_configured_nodes(), 1), __MT_MAX_NODES);
+		if(!mem_tracker.exit_print)
+		{
+			mem_tracker.exit_print = 1;
+			atexit(__mem_tracker_exit);
+		}
+
+		if(2 * (mem_tracker.records_count + 1) > mem_tracker.records_capacity)
+		{
+			struct mem_tracker_record* old_records = mem_tracker.records;
+			unsigned long old_capacity = mem_tracker.records_capacity;
+
+			mem_tracker.records_capacity = max(2 * old_capacity, 1024UL);
+			mem_tracker.records = calloc(sizeof(struct mem_tracker_record), mem_tracker.records_capacity);
+			assert(mem_tracker.records != NULL);
+			for(unsigned long r = 0; r < old_capacity; r++)
+				if(old_records[r].mem != NULL)
+					__mem_tracker_insert_record(&old_records[r]);
+
+			free(old_records);
+			old_records = NULL;
+		}
+
+	// (2) Recording
+		struct mem_tracker_record rec = {mem, size, node, __mem_tracker_tag_index(tag), mem_tracker.steps_count};
+		__mem_tracker_insert_record(&rec);
+		mem_tracker.records_count++;
+
+		struct mem_tracker_tag* t = &mem_tracker.tags[rec.tag];
+		t->live += size;
+		t->peak = max(t->peak, t->live);
+		t->allocs_count++;
+
+		mem_tracker.live += size;
+		for(unsigned int n = 0; n < mem_tracker.nodes_count; n++)
+			mem_tracker.nodes_live[n] += __mem_tracker_node_bytes(size, node, n);
+
+	// (3) Peaks
+		mem_tracker.peak = max(mem_tracker.peak, mem_tracker.live);
+		for(unsigned int r = 0; r < mem_tracker.regions_count; r++)
+			mem_tracker.regions_peak[r] = max(mem_tracker.regions_peak[r], mem_tracker.live);
+
+		if(mem_tracker.live > mem_tracker.step_peak)
+		{
+			mem_tracker.step_peak = mem_tracker.live;
+			mem_tracker.step_peak_tag = 0;
+			for(unsigned int t = 1; t < mem_tracker.tags_count; t++)
+				if(mem_tracker.tags[t].live > mem_tracker.tags[mem_tracker.step_peak_tag].live)
+					mem_tracker.step_peak_tag = t;
+			mem_tracker.step_peak_tag_bytes = mem_tracker.tags[mem_tracker.step_peak_tag].live;
+		}
+
+	return;
+}
+
+/*
+	Removes the record of `mem`, `mem_tracker.lock` should be held by the caller.
+	Memory that has not been recorded (e.g., allocated before by libraries) is counted in `untracked_frees`.
+*/
+void __mem_tracker_remove(void* mem)
+{
+	if(mem_tracker.records_count == 0)
+	{
+		mem_tracker.untracked_frees++;
+		return;
+	}
+
+	unsigned long mask = mem_tracker.records_capacity - 1;
+	unsigned long i = __mem_tracker_hash(mem, mem_tracker.records_capacity);
+	while(mem_tracker.records[i].mem != NULL && mem_tracker.records[i].mem != mem)
+		i = (i + 1) & mask;
+	if(mem_tracker.records[i].mem == NULL)
+	{
+		mem_tracker.untracked_frees++;
+		return;
+	}
+
+	// (1) Updating the counters
+		struct mem_tracker_record* rec = &mem_tracker.records[i];
+		mem_tracker.tags[rec->tag].live -= rec->size;
+		mem_tracker.live -= rec->size;
+		for(unsigned int n = 0; n < mem_tracker.nodes_count; n++)
+			mem_tracker.nodes_live[n] -= __mem_tracker_node_bytes(rec->size, rec->node, n);
+
+	// (2) Backward shift deletion
+		unsigned long j = i;
+		while(1)
+		{
+			j = (j + 1) & mask;
+			if(mem_tracker.records[j].mem == NULL)
+				break;
+			unsigned long k = __mem_tracker_hash(mem_tracker.records[j].mem, mem_tracker.records_capacity);
+			if(i <= j ? (i < k && k <= j) : (i < k || k <= j))
+				continue;
+			mem_tracker.records[i] = mem_tracker.records[j];
+			i = j;
+		}
+		mem_tracker.records[i].mem = NULL;
+		mem_tracker.records_count--;
+
+	return;
+}
+
+void* mem_tracker_alloc(unsigned long size, int node, const char* tag)
+{
+	void* mem = node < 0 ? (numa_alloc_interleaved)(size) : (numa_alloc_onnode)(size, node);
+
+	pthread_mutex_lock(&mem_tracker.lock);
+	if(mem != NULL)
+		__mem_tracker_add(mem, size, node, tag);
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	if(mem == NULL && size != 0)
+	{
+		printf("\033[0;31mmem_tracker_alloc()\033[0;37m, allocating %'lu Bytes by %s in step %u failed.\n", size, tag, mem_tracker.steps_count);
+		mem_tracker_print();
+	}
+
+	return mem;
+}
+
+// Records an array that has not been allocated by mem_tracker_alloc(), e.g., by mmap() in numa_alloc_interleaved_huge()
+void mem_tracker_track(void* mem, unsigned long size, int node, const char* tag)
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+	__mem_tracker_add(mem, size, node, tag);
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return;
+}
+
+void mem_tracker_untrack(void* mem)
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+	__mem_tracker_remove(mem);
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return;
+}
+
+void mem_tracker_free(void* mem, unsigned long size)
+{
+	mem_tracker_untrack(mem);
+	(numa_free)(mem, size);
+
+	return;
+}
+
+void* mem_tracker_realloc(void* old_mem, unsigned long old_size, unsigned long new_size, const char* tag)
+{
+	void* mem = (numa_realloc)(old_mem, old_size, new_size);
+	if(mem == NULL)
+	{
+		printf("\033[0;31mmem_tracker_realloc()\033[0;37m, reallocating %'lu Bytes by %s in step %u failed.\n", new_size, tag, mem_tracker.steps_count);
+		mem_tracker_print();
+		return NULL;
+	}
+
+	pthread_mutex_lock(&mem_tracker.lock);
+	__mem_tracker_remove(old_mem);
+	__mem_tracker_add(mem, new_size, -1, tag);
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return mem;
+}
+
+/*
+	Called by PTIP at the end of each step, prints the high-water mark of the step if `LL_MEM_TRACKER` is 1 
+	and starts the next step.
+*/
+void mem_tracker_step()
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+
+	if(LL_MEM_TRACKER)
+	{
+		printf("  Memory high-water mark: %'10.1f (MB)", mem_tracker.step_peak / 1e6);
+		if(mem_tracker.step_peak_tag_bytes)
+			printf(", %s: %'.1f (MB)", mem_tracker.tags[mem_tracker.step_peak_tag].name, mem_tracker.step_peak_tag_bytes / 1e6);
+		printf(", live: %'.1f (MB), nodes:", mem_tracker.live / 1e6);
+		for(unsigned int n = 0; n < mem_tracker.nodes_count; n++)
+			printf(" %'.1f", mem_tracker.nodes_live[n] / 1e6);
+		printf("\n");
+	}
+
+	mem_tracker.steps_count++;
+	mem_tracker.step_peak = mem_tracker.live;
+	mem_tracker.step_peak_tag_bytes = 0;
+
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return;
+}
+
+/*
+	Starts a region to measure its peak memory, e.g., the execution of an algorithm. Regions can be nested and 
+	should be ended in the reverse order. It should be called outside parallel regions.
+*/
+unsigned int mem_tracker_region_begin()
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+	assert(mem_tracker.regions_count < __MT_MAX_REGIONS);
+	unsigned int region = mem_tracker.regions_count++;
+	mem_tracker.regions_peak[region] = mem_tracker.live;
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return region;
+}
+
+// Ends the `region` and returns its peak memory in Bytes
+unsigned long mem_tracker_region_end(unsigned int region)
+{
+	pthread_mutex_lock(&mem_tracker.lock);
+	assert(region + 1 == mem_tracker.regions_count);
+	mem_tracker.regions_count--;
+	unsigned long peak = mem_tracker.regions_peak[region];
+	pthread_mutex_unlock(&mem_tracker.lock);
+
+	return peak;
+}
+
+#define numa_alloc_interleaved(size) mem_tracker_alloc(size, -1, __func__)
+#define numa_alloc_onnode(size, node) mem_tracker_alloc(size, node, __func__)
+#define numa_realloc(old_mem, old_size, new_size) mem_tracker_realloc(old_mem, old_size, new_size, __func__)
+#define numa_free(mem, size) mem_tracker_free(mem, size)
+
+#endif
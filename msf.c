@@ -881,14 +881,26 @@ inline struct sdw_edge* edge_storage_get_one(struct edge_storage* es)
 				[0]: exec time
 				[1-7]: papi events
 				[8]: #iterations
+				[16]: peak memory of tracked allocations in Bytes (see mem_tracker.c)
+				[18-19]: energy of packages and DRAMs (uJ), with _ENERGY_MEASUREMENT (see energy.c)
 */
 
-struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned long* exec_info, unsigned int flags)
+/*
+	The implementation of msf_mastiff() for both layouts of weighted graphs: `g` is the topology (cast from ll_404_graph 
+	or ll_404_soa_graph) and the destination and the weight of edge `e` are `g->edges_list[stride * e]` and `weights[stride * e]`.
+	So, for ll_404_soa_graph (`stride` == 1), the topology-only passes (Pre-1) do not read the weights.
+*/
+struct msf* __msf_mastiff(struct par_env* pe, struct ll_400_graph* g, unsigned int* weights, unsigned int stride, unsigned long* exec_info, unsigned int flags)
 {
 	// Initial checks
 		assert(g != NULL);
 		unsigned long t0 = - get_nano_time();
 		printf("\n\033[3;34mmsf_mastiff\033[0;37m\n");
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			energy_measurement_start(em);
+		#endif
+		unsigned int mem_region = mem_tracker_region_begin();
 
 	// Reset papi
 		#pragma omp parallel 
@@ -900,10 +912,8 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 	// Edge partitioning
 		unsigned int thread_partitions = 64;
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* edge_partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(edge_partitions != NULL);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-		parallel_edge_partitioning((struct ll_400_graph*)g, edge_partitions, partitions_count); 
+		struct dynamic_partitioning* dp = NULL;
+		unsigned int* edge_partitions = partitions_cache_get(pe, g, partitions_count, &dp);
 
 	// Memory allocation 
 		struct msf* forest = msf_alloc(g->vertices_count, pe->threads_count);
@@ -948,7 +958,12 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 		{
 
 			if(g->edges_count > 5 * g->vertices_count)
-				graph_component = cc_thrifty_404(pe, g, 2U, NULL, NULL);
+			{
+				if(stride == 1)
+					graph_component = cc_thrifty_404_soa(pe, (struct ll_404_soa_graph*)g, 2U, NULL, NULL);
+				else
+					graph_component = cc_thrifty_404(pe, (struct ll_404_graph*)g, 2U, NULL, NULL);
+			}
 			else
 			{
 				// JT CC
@@ -973,7 +988,7 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 						for(unsigned int v = edge_partitions[partition]; v < edge_partitions[partition + 1]; v++)
 							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
 							{
-								unsigned int neighbour = g->edges_list[2 * e];
+								unsigned int neighbour = g->edges_list[stride * e];
 								// if(neighbour >= v)
 									// break;
 
@@ -1097,300 +1112,321 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 			PT(temp);
 		}
 
-	// Iterations
-	while(rv_count > graph_ccs)
+	// Iterations, executed by the persistent workers of `rt` (see runtime.c) and separated by its phase barriers, 
+	// the last thread of each step executes the serial part of the step.
+	struct par_runtime* rt = par_runtime_get(pe);
+	par_runtime_reset_stats(rt);
+	unsigned long iter_time = - get_nano_time();
+	unsigned int sym_edges = 0;
+	unsigned int merged_vertices = 0;
+	mt = - get_nano_time();
+	#pragma omp parallel
 	{
-		unsigned long iter_time = - get_nano_time();
-
-		// (1) Finding the lightests edges of active vertex
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
+		unsigned tid = omp_get_thread_num();
+		while(rv_count > graph_ccs)
+		{
+			// (1) Finding the lightests edges of active vertex
+				{
+					ttimes[tid] = - get_nano_time();
 				
-				// Reset edge storage of this thread
-				edge_storage_reset(edge_storages[tid]);
-				// thread lightest edge
-				struct sdw_edge* tle= edge_storage_get_one(edge_storages[tid]);
+					// Reset edge storage of this thread
+					edge_storage_reset(edge_storages[tid]);
+					// thread lightest edge
+					struct sdw_edge* tle= edge_storage_get_one(edge_storages[tid]);
 
-				if(iter == 0)
-				{
-					unsigned int partition = -1U;
-					while(1)
+					if(iter == 0)
 					{
-						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-						if(partition == -1U)
-							break; 
-
-						for(unsigned int v = edge_partitions[partition]; v < edge_partitions[partition + 1]; v++)
+						unsigned int partition = -1U;
+						while(1)
 						{
-							// Inactive vertex
-							if(status[v] != ROOT)
-								continue;
+							partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+							if(partition == -1U)
+								break; 
 
-							tle->source = v;
-							tle->weight = -1U;
-							tle->dest = -1U;
-
-							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							for(unsigned int v = edge_partitions[partition]; v < edge_partitions[partition + 1]; v++)
 							{
-								unsigned int dest = g->edges_list[2 * e];
-								
-								// self-edge
-								if(dest == v)
+								// Inactive vertex
+								if(status[v] != ROOT)
 									continue;
 
-								unsigned int weight = g->edges_list[2 * e + 1];
+								tle->source = v;
+								tle->weight = -1U;
+								tle->dest = -1U;
 
-								// Prevent the same-weight cycles to be added to the forest when edges do not have unique weights:
-								// Select the lightest edge to the neighbour with lowest ID, i.e., component								
-								if( weight < tle->weight || ( weight == tle->weight && dest < tle->dest) )
+								for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
 								{
-									tle->dest = dest;
-									tle->weight = weight;
+									unsigned int dest = g->edges_list[stride * e];
+								
+									// self-edge
+									if(dest == v)
+										continue;
+
+									unsigned int weight = weights[stride * e];
+
+									// Prevent the same-weight cycles to be added to the forest when edges do not have unique weights:
+									// Select the lightest edge to the neighbour with lowest ID, i.e., component								
+									if( weight < tle->weight || ( weight == tle->weight && dest < tle->dest) )
+									{
+										tle->dest = dest;
+										tle->weight = weight;
+									}
 								}
-							}
 
-							// Write the tle to lightests
-							lightests[v] = tle;
-							tle = edge_storage_get_one(edge_storages[tid]);
+								// Write the tle to lightests
+								lightests[v] = tle;
+								tle = edge_storage_get_one(edge_storages[tid]);
 
-							// printf("v:%2u le-dest:%2u le-weight:%2u\n", v, lightests[v]->dest, lightests[v]->weight);
+								// printf("v:%2u le-dest:%2u le-weight:%2u\n", v, lightests[v]->dest, lightests[v]->weight);
+							}
 						}
 					}
-				}
-				else
-				{
-					unsigned int partition = -1U;
-					while(1)
+					else
 					{
-						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-						if(partition == -1U)
-							break; 
-
-						for(unsigned int v = edge_partitions[partition]; v < edge_partitions[partition + 1]; v++)
+						unsigned int partition = -1U;
+						while(1)
 						{
-							unsigned int my_parent = parent[v];
-							if(status[my_parent] != ROOT)
-								continue;
-							
-							tle->source = v;
-							tle->weight = -1U;
-							tle->dest = -1U;
-							unsigned int parent_tle_dest = -1U;
-
-							// unsigned long write_offset = g->offsets_list[v];
-							unsigned long e = g->offsets_list[v];
-							for(; e < g->offsets_list[v + 1]; e++)
+							partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+							if(partition == -1U)
+								break; 
+
+							for(unsigned int v = edge_partitions[partition]; v < edge_partitions[partition + 1]; v++)
 							{
-								unsigned int dest = g->edges_list[2 * e];
-								
-								// A self-edge
-								if(dest == v)
+								unsigned int my_parent = parent[v];
+								if(status[my_parent] != ROOT)
 									continue;
+							
+								tle->source = v;
+								tle->weight = -1U;
+								tle->dest = -1U;
+								unsigned int parent_tle_dest = -1U;
+
+								// unsigned long write_offset = g->offsets_list[v];
+								unsigned long e = g->offsets_list[v];
+								for(; e < g->offsets_list[v + 1]; e++)
+								{
+									unsigned int dest = g->edges_list[stride * e];
 								
-								// no more edge
-								// if(dest == -1U)
-								// 	break;
+									// A self-edge
+									if(dest == v)
+										continue;
+								
+									// no more edge
+									// if(dest == -1U)
+									// 	break;
 
-								unsigned int weight = g->edges_list[2 * e + 1];
+									unsigned int weight = weights[stride * e];
 
-								// An intra-component edge
-								if(parent[dest] == my_parent)
-									continue;
+									// An intra-component edge
+									if(parent[dest] == my_parent)
+										continue;
 
-								// Prevent the same-weight cycles problem
-								if( weight < tle->weight || ( weight == tle->weight && parent[dest] < parent_tle_dest ) )
-								{
-									tle->dest = dest;
-									tle->weight = weight;
-									parent_tle_dest = parent[dest];
-								}
+									// Prevent the same-weight cycles problem
+									if( weight < tle->weight || ( weight == tle->weight && parent[dest] < parent_tle_dest ) )
+									{
+										tle->dest = dest;
+										tle->weight = weight;
+										parent_tle_dest = parent[dest];
+									}
 
-								// Rewriting edgelist 
-								// if(e != write_offset)
-								// {
-								// 	g->edges_list[2 * write_offset] = dest;
-								// 	g->edges_list[2 * write_offset + 1] = weight;
-								// }
-								// write_offset++;
-							}
+									// Rewriting edgelist 
+									// if(e != write_offset)
+									// {
+									// 	g->edges_list[2 * write_offset] = dest;
+									// 	g->edges_list[2 * write_offset + 1] = weight;
+									// }
+									// write_offset++;
+								}
 
-							// if(e > write_offset + 1)
-							// 	g->edges_list[2 * write_offset] = -1U;
+								// if(e > write_offset + 1)
+								// 	g->edges_list[2 * write_offset] = -1U;
 
-							// This vertex has not had any outgoing edges
-							if(tle->dest == -1U)
-								continue;
+								// This vertex has not had any outgoing edges
+								if(tle->dest == -1U)
+									continue;
 
-							// Update the lightest edge of this component
-							while(1)
-							{
-								struct sdw_edge* current = lightests[my_parent];
-								if(current)
+								// Update the lightest edge of this component
+								while(1)
 								{
-									if(current->weight < tle->weight)
-										break;
-									if(current->weight == tle->weight && parent[current->dest] <= parent_tle_dest)
+									struct sdw_edge* current = lightests[my_parent];
+									if(current)
+									{
+										if(current->weight < tle->weight)
+											break;
+										if(current->weight == tle->weight && parent[current->dest] <= parent_tle_dest)
+											break;
+									}
+
+									if(__sync_val_compare_and_swap(&lightests[my_parent], current, tle) == current)
+									{
+										tle = edge_storage_get_one(edge_storages[tid]);
 										break;
+									}
 								}
 
-								if(__sync_val_compare_and_swap(&lightests[my_parent], current, tle) == current)
-								{
-									tle = edge_storage_get_one(edge_storages[tid]);
-									break;
-								}
+								// printf("v:%2u fc: %2u; le-dest:%2u le-weight:%2u\n", v, my_parent, lightests[my_parent]->dest, lightests[my_parent]->weight);
 							}
-
-							// printf("v:%2u fc: %2u; le-dest:%2u le-weight:%2u\n", v, my_parent, lightests[my_parent]->dest, lightests[my_parent]->weight);
 						}
 					}
-				}
 
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			if(flags & 1U)
-				PTIP("    (1) Selecting the lightests");
-
-		// (2) Removing symmetric selected edges (with the same source and destination components)
-		 	mt = - get_nano_time();
-		 	unsigned int sym_edges = 0;
-			#pragma omp parallel reduction(+:sym_edges)
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
+					ttimes[tid] += get_nano_time();
+
+					if(par_runtime_barrier(rt))
+					{
+						mt += get_nano_time();
+						dynamic_partitioning_reset(dp);
+						if(flags & 1U)
+							PTIP("    (1) Selecting the lightests");
 
-				#pragma omp for nowait
-				for(unsigned int v = 0; v < g->vertices_count; v++)
+						mt = - get_nano_time();
+						par_runtime_barrier_release(rt);
+					}
+				}
+
+			// (2) Removing symmetric selected edges (with the same source and destination components)
 				{
-					if(status[v] != ROOT)
-						continue;
+					ttimes[tid] = - get_nano_time();
+					unsigned int thread_sym_edges = 0;
 
-					struct sdw_edge* edge = lightests[v];
-					// inactive component
-					if(edge == NULL)
-						continue;
+					#pragma omp for nowait
+					for(unsigned int v = 0; v < g->vertices_count; v++)
+					{
+						if(status[v] != ROOT)
+							continue;
+
+						struct sdw_edge* edge = lightests[v];
+						// inactive component
+						if(edge == NULL)
+							continue;
 
-					unsigned int dest = parent[edge->dest];
+						unsigned int dest = parent[edge->dest];
 					
-					struct sdw_edge* dest_edge = lightests[dest];
-					if(dest_edge == NULL)
-						continue;
+						struct sdw_edge* dest_edge = lightests[dest];
+						if(dest_edge == NULL)
+							continue;
 					
-					unsigned int dest_dest = parent[dest_edge->dest];
-					if(dest_dest == v && v > dest)
+						unsigned int dest_dest = parent[dest_edge->dest];
+						if(dest_dest == v && v > dest)
+						{
+							lightests[v] = NULL;
+							thread_sym_edges++;
+						}
+					}
+
+					__atomic_add_fetch(&sym_edges, thread_sym_edges, __ATOMIC_RELAXED);
+					ttimes[tid] += get_nano_time();
+
+					if(par_runtime_barrier(rt))
 					{
-						lightests[v] = NULL;
-						sym_edges++;
+						mt += get_nano_time();
+						if(flags & 1U)
+						{
+							char temp[128];
+							sprintf(temp, "    (2) Removing symmetric selected edges (count: %'u)", sym_edges);
+							PTIP(temp);
+						}
+
+						mt = - get_nano_time();
+						par_runtime_barrier_release(rt);
 					}
 				}
 
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			if(flags & 1U)
-			{
-				char temp[128];
-				sprintf(temp, "    (2) Removing symmetric selected edges (count: %'u)", sym_edges);
-				PTIP(temp);
-			}
+			// (3) Adding new edges to the forest and updating its forest component based on the new edges
+				{
+					ttimes[tid] = - get_nano_time();
 
-		// (3) Adding new edges to the forest and updating its forest component based on the new edges
-		 	mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
+					#pragma omp for nowait
+					for(unsigned int v = 0; v < g->vertices_count; v++)
+					{
+						if(status[v] != ROOT)
+							continue;
 
-				#pragma omp for nowait
-				for(unsigned int v = 0; v < g->vertices_count; v++)
-				{
-					if(status[v] != ROOT)
-						continue;
+						struct sdw_edge* edge = lightests[v];
+						// a symmetric edge
+						if(edge == NULL)
+							continue;
 
-					struct sdw_edge* edge = lightests[v];
-					// a symmetric edge
-					if(edge == NULL)
-						continue;
+						msf_add_edge(forest, tid, lightests[v]);
 
-					msf_add_edge(forest, tid, lightests[v]);
+						// reset lightests for the next iteration
+						lightests[v] = NULL;
 
-					// reset lightests for the next iteration
-					lightests[v] = NULL;
+						parent[v] = parent[edge->dest];
+					}
 
-					parent[v] = parent[edge->dest];
-				}
+					ttimes[tid] += get_nano_time();
 
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			if(flags & 1U)
-				PTIP("    (3) Adding edges to the forest");
-
-		// (4) Updating parents and variables 
-			mt = - get_nano_time();
-			unsigned int merged_vertices = 0;
-			#pragma omp parallel  reduction(+:merged_vertices)
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
+					if(par_runtime_barrier(rt))
+					{
+						mt += get_nano_time();
+						if(flags & 1U)
+							PTIP("    (3) Adding edges to the forest");
 
-				#pragma omp for nowait
-				for(unsigned int v = 0; v < g->vertices_count; v++)
+						mt = - get_nano_time();
+						par_runtime_barrier_release(rt);
+					}
+				}
+
+			// (4) Updating parents and variables 
 				{
+					ttimes[tid] = - get_nano_time();
+					unsigned int thread_merged_vertices = 0;
 
-					if(status[v] != ROOT && status[parent[v]] == EXEMPT)
-						continue;
+					#pragma omp for nowait
+					for(unsigned int v = 0; v < g->vertices_count; v++)
+					{
 
-					unsigned int my_parent = parent[v];
+						if(status[v] != ROOT && status[parent[v]] == EXEMPT)
+							continue;
+
+						unsigned int my_parent = parent[v];
 					
-					// Reach the topest parent
-					while(my_parent != parent[my_parent])
-						my_parent = parent[my_parent];
+						// Reach the topest parent
+						while(my_parent != parent[my_parent])
+							my_parent = parent[my_parent];
 
-					// Update all parents
-					unsigned int temp = v;
-					while(parent[temp] != my_parent)
-					{
-						unsigned int temp_parent = parent[temp];
-						parent[temp] = my_parent;
-						temp = temp_parent;
+						// Update all parents
+						unsigned int temp = v;
+						while(parent[temp] != my_parent)
+						{
+							unsigned int temp_parent = parent[temp];
+							parent[temp] = my_parent;
+							temp = temp_parent;
+						}
+
+						// For the recently merged vertices
+						if(my_parent != v && status[v] == ROOT)
+						{
+							status[v] = MERGED;
+							thread_merged_vertices++;
+							__atomic_fetch_add(&cs[my_parent], cs[v], __ATOMIC_RELAXED);
+						}
 					}
 
-					// For the recently merged vertices
-					if(my_parent != v && status[v] == ROOT)
+					__atomic_add_fetch(&merged_vertices, thread_merged_vertices, __ATOMIC_RELAXED);
+					ttimes[tid] += get_nano_time();
+
+					if(par_runtime_barrier(rt))
 					{
-						status[v] = MERGED;
-						merged_vertices++;
-						__atomic_fetch_add(&cs[my_parent], cs[v], __ATOMIC_RELAXED);
-					}
-				}
+						mt += get_nano_time();
+						if(flags & 1U)
+						{
+							char temp[128];
+							sprintf(temp, "    (4) Updating parents (merged_vertices: %'u)", merged_vertices);
+							PTIP(temp);
+						}
 
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			if(flags & 1U)
-			{
-				char temp[128];
-				sprintf(temp, "    (4) Updating parents (merged_vertices: %'u)", merged_vertices);
-				PTIP(temp);
-			}
+						assert(merged_vertices + sym_edges == rv_count - graph_ccs);
+						rv_count -= merged_vertices;
 
-			assert(merged_vertices + sym_edges == rv_count - graph_ccs);
-			rv_count -= merged_vertices;
+						mt = - get_nano_time();
+						par_runtime_barrier_release(rt);
+					}
+				}
 
-		// (5) Updating the exempted components
-			// if(0)
-			{
-				// We temporarily use lightests as `svc_id` array to find the active vertex with the maximum sub-vertices in each graph component 
-				unsigned long* svc_ids = (unsigned long*)lightests;
-				mt = - get_nano_time();
-				#pragma omp parallel
+			// (5) Updating the exempted components
 				{
-					unsigned tid = omp_get_thread_num();
+					// We temporarily use lightests as `svc_id` array to find the active vertex with the maximum sub-vertices in each graph component 
+					unsigned long* svc_ids = (unsigned long*)lightests;
 					ttimes[tid] = - get_nano_time();
 
 					// Find the active vertex with max cs
@@ -1437,28 +1473,40 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 						svc_ids[c] = 0UL;
 					}
 
+					svc_ids = NULL;
 					ttimes[tid] += get_nano_time();
-				}
 
-				svc_ids = NULL;
+					if(par_runtime_barrier(rt))
+					{
+						mt += get_nano_time();
+						if(flags & 1U)
+							PTIP("    (5) Updating convergance ");
+
+						// Timing
+						iter_time += get_nano_time();
+						unsigned long forest_edges = msf_current_edges_count(forest);
+						if(flags & 1U)
+						{
+							double fe_percent = 100.0 * forest_edges / (forest->vertices_count - graph_ccs);
+							double av_percent = 100.0 * rv_count / g->vertices_count;
+							printf("\033[3;34mIt-%u\033[0;37m; time(ms):  %'10.1f ;   |RV|: %'10u (%4.1f%%) ;  Frst.|E|: %'lu (%4.1f%%);\n", 
+								iter, iter_time/1e6, rv_count, av_percent, forest_edges, fe_percent);
+						}
+						iter++;
 
-				mt += get_nano_time();
-				if(flags & 1U)
-					PTIP("    (5) Updating convergance ");
-			}
+						// The next iteration
+						iter_time = - get_nano_time();
+						sym_edges = 0;
+						merged_vertices = 0;
 
-		// Timing
-			iter_time += get_nano_time();
-			unsigned long forest_edges = msf_current_edges_count(forest);
-			if(flags & 1U)
-			{
-				double fe_percent = 100.0 * forest_edges / (forest->vertices_count - graph_ccs);
-				double av_percent = 100.0 * rv_count / g->vertices_count;
-				printf("\033[3;34mIt-%u\033[0;37m; time(ms):  %'10.1f ;   |RV|: %'10u (%4.1f%%) ;  Frst.|E|: %'lu (%4.1f%%);\n", 
-					iter, iter_time/1e6, rv_count, av_percent, forest_edges, fe_percent);
-			}
-			iter++;
+						mt = - get_nano_time();
+						par_runtime_barrier_release(rt);
+					}
+				}
+		}
 	}
+	if(flags & 1U)
+		par_runtime_print_stats(rt);
 
 	msf_finalize(forest);
 
@@ -1486,9 +1534,8 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 
 		free(ttimes);
 		ttimes = NULL;
-		free(edge_partitions);
+		partitions_cache_put(edge_partitions, dp);
 		edge_partitions = NULL;
-		dynamic_partitioning_release(dp);
 		dp = NULL;
 
 	// Saving events
@@ -1504,6 +1551,18 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 			exec_info[8] = iter;
 		}
 		
+	// Peak memory
+		unsigned long peak_mem = mem_tracker_region_end(mem_region);
+		printf("Peak memory:      \t\t %'.1f (MB)\n", peak_mem / 1e6);
+		if(exec_info)
+			exec_info[16] = peak_mem;
+
+	// Energy
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_exec_info(em, g->edges_count, exec_info);
+			em = NULL;
+		#endif
+
 	// Report
 		t0 += get_nano_time();
 		printf("Exec. time: \t\t %'.1f (ms) \n", t0 / 1e6);
@@ -1515,4 +1574,21 @@ struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned lon
 	return forest;	
 }
 
+struct msf* msf_mastiff(struct par_env* pe, struct ll_404_graph* g, unsigned long* exec_info, unsigned int flags)
+{
+	assert(g != NULL);
+
+	return __msf_mastiff(pe, (struct ll_400_graph*)g, g->edges_list + 1, 2, exec_info, flags);
+}
+
+/*
+	MASTIFF for weighted graphs in the structure-of-arrays layout, see `msf_mastiff()`.
+*/
+struct msf* msf_mastiff_soa(struct par_env* pe, struct ll_404_soa_graph* g, unsigned long* exec_info, unsigned int flags)
+{
+	assert(g != NULL);
+
+	return __msf_mastiff(pe, (struct ll_400_graph*)g, g->weights_list, 1, exec_info, flags);
+}
+
 #endif
@@ -11,9 +11,32 @@
 #include <unistd.h>
 #include <numaif.h>
 #include <cpuid.h>
-#include <papi.h>
+#ifdef _PAPI_SUPPORT
+	#include <papi.h>
+#endif
 #include <sched.h>
+#include <linux/io_uring.h>
+
+#include "mem_tracker.c"
+
+#ifndef PAPI_MAX_STR_LEN
+	#define PAPI_MAX_STR_LEN 128
+#endif
+
+#include "perf_events.c"
+
+/*
+	Backends of hw events: PAPI (if built with `_PAPI_SUPPORT`, i.e., `make papi=1` or when papi.h is found) 
+	or perf_event_open() (perf_events.c). The backend is selected by `LL_HW_EVENTS_BACKEND` at runtime and 
+	papi_read(), papi_reset(), and papi_stop() call the functions of the selected backend.
+*/
+#define LL_HW_EVENTS_PAPI 0U
+#define LL_HW_EVENTS_PERF 1U
 
+const char* hw_events_backend_names[] = {"PAPI", "perf_event_open()"};
+unsigned int hw_events_backend = LL_HW_EVENTS_PERF;
+
+#ifdef _PAPI_SUPPORT
 unsigned int papi_events []= {
 	// PAPI_LST_INS,
 	// PAPI_L3_TCM,
@@ -26,13 +49,25 @@ unsigned int papi_events []= {
 	// PAPI_BR_INS,
 	PAPI_TOT_CYC
 };
+#endif
  
-// Print Time and Idle Percentage
+// Print Time and Idle Percentage, followed by the per-step hw events and memory high-water mark (if enabled) and the output 
+// of `ptip_hook` (if set), and record the step by trace_step() (trace.c)
 #define PTIP(step_name) \
-  printf("%-60s\t\t %'10.2f (ms) \t(%5.2f%%)\n",step_name, mt/1e6, get_idle_percentage(mt, ttimes, pe->threads_count));
+{ \
+  printf("%-60s\t\t %'10.2f (ms) \t(%5.2f%%)\n",step_name, mt/1e6, get_idle_percentage(mt, ttimes, pe->threads_count)); \
+  step_hw_events_collect(pe); \
+  mem_tracker_step(); \
+  if(ptip_hook != NULL) \
+    ptip_hook(pe); \
+  trace_step(__func__, step_name, mt, ttimes, pe); \
+}
 
 #define PT(step_name) \
-	printf("%-60s\t\t %'10.2f (ms)\n",step_name, mt/1e6); 
+{ \
+	printf("%-60s\t\t %'10.2f (ms)\n",step_name, mt/1e6); \
+	trace_step(__func__, step_name, mt, NULL, NULL); \
+}
 
 double get_idle_percentage(unsigned long nt, unsigned long* threads_nt, unsigned int threads_count)
 { 
@@ -48,6 +83,7 @@ unsigned long omp_get_thread_num_ulong()
 	return (unsigned long)omp_get_thread_num();
 }
 
+#ifdef _PAPI_SUPPORT
 void papi_init()
 {
 	int ret = PAPI_library_init(PAPI_VER_CURRENT);
@@ -113,6 +149,10 @@ unsigned long papi_start(unsigned int* in_events, unsigned int in_events_count)
 	
 	return (events_count << 32) + event_set;
 }
+#endif
+
+// The number of papi_reset() calls, to detect the resets in reading per-step hw events (see thread_step_hw_events_read())
+unsigned long papi_resets_count = 0;
 
 void papi_reset(unsigned long papi_arg)
 {
@@ -120,9 +160,17 @@ void papi_reset(unsigned long papi_arg)
 	if (events_count == 0)
 		return;
 
-	unsigned int event_set = (unsigned int)papi_arg;
-	int ret = PAPI_reset(event_set);
-	assert( ret == PAPI_OK );
+	if(hw_events_backend == LL_HW_EVENTS_PERF)
+		perf_events_reset(papi_arg);
+	#ifdef _PAPI_SUPPORT
+	else
+	{
+		unsigned int event_set = (unsigned int)papi_arg;
+		int ret = PAPI_reset(event_set);
+		assert( ret == PAPI_OK );
+	}
+	#endif
+	__atomic_add_fetch(&papi_resets_count, 1UL, __ATOMIC_RELAXED);
 	
 	return;
 } 
@@ -133,6 +181,13 @@ void papi_stop(unsigned long papi_arg)
 	if (events_count == 0)
 		return;
 
+	if(hw_events_backend == LL_HW_EVENTS_PERF)
+	{
+		perf_events_stop(papi_arg);
+		return;
+	}
+
+	#ifdef _PAPI_SUPPORT
 	unsigned int event_set = (unsigned int)papi_arg;
 	unsigned long long temp_values[32];
 	assert(events_count <= 32);
@@ -140,6 +195,7 @@ void papi_stop(unsigned long papi_arg)
 	int ret = PAPI_stop(event_set, temp_values);
 	if(ret != PAPI_OK)
 		printf("PAPI can't stop, %d: %s\n", ret, PAPI_strerror(ret));
+	#endif
 
 	return;
 }
@@ -147,11 +203,15 @@ void papi_stop(unsigned long papi_arg)
 int papi_read(unsigned long papi_arg, unsigned long* in_values)
 {
 	assert(in_values != NULL);
-	unsigned int event_set = (unsigned int) papi_arg;
 	unsigned long events_count = (papi_arg >> 32);
 	if(events_count == 0)
 		return -1;
 
+	if(hw_events_backend == LL_HW_EVENTS_PERF)
+		return perf_events_read(papi_arg, in_values);
+
+	#ifdef _PAPI_SUPPORT
+	unsigned int event_set = (unsigned int) papi_arg;
 	unsigned long long temp_values[32];
 	assert(events_count <= 32);
 	int ret = PAPI_read(event_set, temp_values);
@@ -163,6 +223,7 @@ int papi_read(unsigned long papi_arg, unsigned long* in_values)
 
 	for(unsigned int i=0; i<events_count; i++)
 		in_values[i] = temp_values[i];
+	#endif
 
 	return 0;
 }
@@ -208,6 +269,9 @@ struct par_env
 	unsigned int ** node_cpus;
 	unsigned int * node_cpus_length;
 
+	// L3 domain of each cpu, i.e., the ID of the first cpu that shares the L3 cache with it
+	unsigned int * cpu2L3;
+
 	// Sibling groups
 	unsigned int sibling_groups_count;
 	unsigned int * node_sibling_groups_start_ID;  // A node ID is used as index to return the ID of the first sibling group of the node
@@ -222,15 +286,103 @@ struct par_env
 	unsigned int threads_count;
 	unsigned int* thread2node;
 	unsigned int* thread2cpu;
-	unsigned int** threads_next_threads;
+	unsigned int** threads_next_threads;  // LL_STEAL_ORDER_NUMA
+	unsigned int** threads_next_threads_hierarchical;  // LL_STEAL_ORDER_HIERARCHICAL
+
+	// The persistent worker runtime, created by par_runtime_get() in runtime.c
+	struct par_runtime* runtime;
 
 	// papi args
 	unsigned long* papi_args;
 	unsigned int hw_events_count;
 	unsigned long hw_events [32];
 	char hw_events_names[32][PAPI_MAX_STR_LEN];
+
+	// Per-step hw events (LL_STEP_HW_EVENTS), 32 values for each thread, see step_hw_events_collect()
+	unsigned long* step_hw_values;  // the values of the last read
+	unsigned long* step_hw_resets;  // papi_resets_count in the last read
+	unsigned long* step_hw_pending; // the changes since the last step
+	unsigned long* step_hw_deltas;  // the changes in the last step
 };
 
+/*
+	Called by PTIP after printing a step, e.g., to print the scheduler telemetry of the step
+	(see `_DP_TELEMETRY` in partitioning.c).
+*/
+void (*ptip_hook)(struct par_env* pe) = NULL;
+
+/*
+	Per-step hw events, enabled by `LL_STEP_HW_EVENTS=1`: PTIP calls step_hw_events_collect() that 
+	reads the hw events of each thread without stopping or resetting its event set and prints the changes 
+	since the previous step (the total, and the min and the max of threads). The per-thread changes are stored 
+	in `pe->step_hw_deltas` and recorded by trace_step() (trace.c).
+
+	The event set of a thread can only be read by that thread, so step_hw_events_collect() uses a parallel region 
+	to read them. In a parallel region, i.e., when PTIP is called in the serial part of par_runtime_barrier() 
+	(runtime.c), the threads read their events by thread_step_hw_events_read() before arriving at the barrier.
+*/
+void thread_step_hw_events_read(struct par_env* pe)
+{
+	unsigned int tid = omp_get_thread_num();
+	unsigned long values[32] = {0};
+	if(pe->step_hw_values == NULL || papi_read(pe->papi_args[tid], values) != 0)
+		return;
+
+	// After a papi_reset(), the values are the changes
+	unsigned long resets = __atomic_load_n(&papi_resets_count, __ATOMIC_RELAXED);
+	unsigned int reset = resets != pe->step_hw_resets[tid];
+	pe->step_hw_resets[tid] = resets;
+
+	unsigned long* last = pe->step_hw_values + 32 * tid;
+	unsigned long* pending = pe->step_hw_pending + 32 * tid;
+	for(unsigned int e = 0; e < pe->hw_events_count; e++)
+	{
+		pending[e] += reset || values[e] < last[e] ? values[e] : values[e] - last[e];
+		last[e] = values[e];
+	}
+
+	return;
+}
+
+void step_hw_events_collect(struct par_env* pe)
+{
+	if(pe->step_hw_values == NULL)
+		return;
+
+	if(!omp_in_parallel())
+	{
+		#pragma omp parallel num_threads(pe->threads_count)
+		{
+			thread_step_hw_events_read(pe);
+		}
+	}
+
+	for(unsigned int e = 0; e < pe->hw_events_count; e++)
+	{
+		unsigned long total = 0;
+		unsigned long min_val = -1UL;
+		unsigned long max_val = 0;
+		unsigned int max_thread = 0;
+		for(unsigned int t = 0; t < pe->threads_count; t++)
+		{
+			unsigned long val = pe->step_hw_pending[32 * t + e];
+			pe->step_hw_deltas[32 * t + e] = val;
+			pe->step_hw_pending[32 * t + e] = 0;
+
+			total += val;
+			min_val = min(min_val, val);
+			if(val > max_val)
+			{
+				max_val = val;
+				max_thread = t;
+			}
+		}
+		printf("  %-20s: %'20lu \t(min: %'lu, max: %'lu by thread %u)\n", pe->hw_events_names[e], total, min_val, max_val, max_thread);
+	}
+
+	return;
+}
+
 int thread_papi_read(struct par_env* pe)
 {
 	unsigned long temp_vals[32]={0};
@@ -289,6 +441,63 @@ void copy_reset_hw_events(struct par_env* pe, unsigned long* ev, unsigned int it
 	return;
 }
 
+/*
+	Stealing orders of threads, pe->threads_next_threads and pe->threads_next_threads_hierarchical,
+	see dynamic_partitioning_set_steal_order() in partitioning.c 
+*/
+#define LL_STEAL_ORDER_NUMA         0U
+#define LL_STEAL_ORDER_HIERARCHICAL 1U
+
+const char* steal_order_names[] = {"numa", "hierarchical"};
+
+// Returns the ID of the sibling group (physical core) of `cpu`
+unsigned int get_sibling_group(struct par_env* pe, unsigned int cpu)
+{
+	for(unsigned int g = 0; g < pe->node_sibling_groups_start_ID[pe->nodes_count]; g++)
+		for(unsigned int co = pe->sibling_group_cpus_start_offsets[g]; co < pe->sibling_group_cpus_start_offsets[g+1]; co++)
+			if(pe->sibling_groups_cpus[co] == cpu)
+				return g;
+
+	return -1U;
+}
+
+void print_steal_order(struct par_env* pe, unsigned int** threads_next_threads, char* title)
+{
+	printf("\033[1;35m%s \033[;37m:\n", title);
+	for(unsigned int t=0; t<pe->threads_count; t++)
+	{
+		printf("#\033[1;35m%3u\033[0;37m: ",t);
+
+		printf("%u",threads_next_threads[t][0]);
+		unsigned int last = threads_next_threads[t][0];
+		unsigned int prev_print = threads_next_threads[t][0];
+
+		for(unsigned int t2=1; t2<pe->threads_count - 1; t2++)	
+		{		
+			if(last == threads_next_threads[t][t2] - 1)
+			{
+				last++;
+				continue;
+			}
+
+			if(prev_print == last)
+				printf(", %u", threads_next_threads[t][t2]);
+			else
+				printf("-%u, %u", last, threads_next_threads[t][t2]);
+			last = threads_next_threads[t][t2];
+			prev_print = last;
+		}
+
+		if(last + 1 == threads_next_threads[t][pe->threads_count - 1])
+			printf("-%u\n", threads_next_threads[t][pe->threads_count - 1]);
+		else
+			printf("-%u, %u\n", last, threads_next_threads[t][pe->threads_count - 1]);
+	}
+	printf("\n");
+
+	return;
+}
+
 struct par_env* initialize_omp_par_env()
 {
 	// NUMA Initialization
@@ -634,6 +843,54 @@ struct par_env* initialize_omp_par_env()
 		}
 		printf("\n");
 
+	// Reading L3 domains of cpus
+		pe->cpu2L3 = calloc(sizeof(unsigned int), pe->cpus_count);
+		assert(pe->cpu2L3 != NULL);
+		for(unsigned int c = 0; c < pe->cpus_count; c++)
+		{
+			// The cpus without an L3 cache (or its sysfs entry) are considered as separate domains 
+			pe->cpu2L3[c] = c;
+			if(pe->available_cpus[c] == 0)
+				continue;
+
+			for(int i=0; i<=3; i++)
+			{
+				char file_name[255];
+				char temp[255];
+
+				sprintf(file_name, "/sys/devices/system/cpu/cpu%u/cache/index%d/level", c, i);
+				if(access(file_name, F_OK) != 0)
+					continue;
+				int count = get_file_contents(file_name, temp, 255);
+				if(count <= 0 || atoi(temp) != 3)
+					continue;
+
+				// e.g., "0-7,64-71"
+				sprintf(file_name, "/sys/devices/system/cpu/cpu%u/cache/index%d/shared_cpu_list", c, i);
+				count = get_file_contents(file_name, temp, 255);
+				if(count > 0)
+					pe->cpu2L3[c] = atoi(temp);
+				break;
+			}
+		}
+
+		printf("\033[1;34mL3 Domains\033[;37m:\n");
+		for(unsigned int n=0; n<pe->nodes_count; n++)
+		{
+			printf("\033[3;34mNode %u\033[0;37m: ",n);
+			for(unsigned int ci = 0; ci < pe->node_cpus_length[n]; ci++)
+			{
+				unsigned int c = pe->node_cpus[n][ci];
+				if(ci == 0 || pe->cpu2L3[c] != pe->cpu2L3[pe->node_cpus[n][ci - 1]])
+					printf("%s[L3 %u: ", ci == 0 ? "" : "], ", pe->cpu2L3[c]);
+				else
+					printf(",");
+				printf("%u", c);
+			}
+			printf("]\n");
+		}
+		printf("\n");
+
 	// OMP env vars
 		printf("\033[1;31m%-40s\033[0;37m: %s\n","OMP_NUM_THREADS",getenv("OMP_NUM_THREADS"));
 		printf("\033[1;31m%-40s\033[0;37m: %s\n","OMP_DYNAMIC",getenv("OMP_DYNAMIC"));
@@ -819,55 +1076,98 @@ struct par_env* initialize_omp_par_env()
 			assert(nindex == pe->threads_count);
 		}
 
-		printf("\033[1;35mThread stealing order \033[;37m:\n");
-		for(unsigned int t=0; t<pe->threads_count; t++)
+		// The hierarchical order: the thread, its SMT siblings, the threads sharing its L3 cache, the threads 
+		// on its NUMA node and the threads on other nodes. It is created by a stable sort of the NUMA order by these levels.
+		pe->threads_next_threads_hierarchical = calloc(sizeof(unsigned int*), pe->threads_count);
+		assert(pe->threads_next_threads_hierarchical != NULL);
+		#pragma omp parallel num_threads(pe->threads_count)
 		{
-			printf("#\033[1;35m%3u\033[0;37m: ",t);
-
-			printf("%u",pe->threads_next_threads[t][0]);
-			unsigned int last = pe->threads_next_threads[t][0];
-			unsigned int prev_print = pe->threads_next_threads[t][0];
+			unsigned tid = omp_get_thread_num();
+			unsigned int* order = calloc(sizeof(unsigned int), pe->threads_count);
+			assert(order != NULL);
 
-			for(unsigned int t2=1; t2<pe->threads_count - 1; t2++)	
-			{		
-				if(last == pe->threads_next_threads[t][t2] - 1)
+			unsigned int cpu = pe->thread2cpu[tid];
+			unsigned int nindex = 0;
+			for(unsigned int level = 0; level < 5; level++)
+				for(unsigned int ti = 0; ti < pe->threads_count; ti++)
 				{
-					last++;
-					continue;
+					unsigned int thread = pe->threads_next_threads[tid][ti];
+					unsigned int thread_cpu = pe->thread2cpu[thread];
+					unsigned int thread_level = 4;
+					if(thread == tid)
+						thread_level = 0;
+					else if(thread_cpu == cpu || get_sibling_group(pe, thread_cpu) == get_sibling_group(pe, cpu))
+						thread_level = 1;
+					else if(pe->cpu2L3[thread_cpu] == pe->cpu2L3[cpu])
+						thread_level = 2;
+					else if(pe->thread2node[thread] == pe->thread2node[tid])
+						thread_level = 3;
+
+					if(thread_level == level)
+						order[nindex++] = thread;
 				}
+			assert(nindex == pe->threads_count);
 
-				if(prev_print == last)
-					printf(", %u", pe->threads_next_threads[t][t2]);
-				else
-					printf("-%u, %u", last, pe->threads_next_threads[t][t2]);
-				last = pe->threads_next_threads[t][t2];
-				prev_print = last;
-			}
-
-			if(last + 1 == pe->threads_next_threads[t][pe->threads_count - 1])
-				printf("-%u\n", pe->threads_next_threads[t][pe->threads_count - 1]);
-			else
-				printf("-%u, %u\n", last, pe->threads_next_threads[t][pe->threads_count - 1]);
+			pe->threads_next_threads_hierarchical[tid] = order;
+			order = NULL;
 		}
-		printf("\n");
 
-	// Initialzing PAPI on threads
-		printf("Using \033[1;31mPAPI\033[0;37m  for measurements.\n");
-		assert(sizeof(papi_events)/sizeof(papi_events[0]) <= 32);
-		papi_init();
+		print_steal_order(pe, pe->threads_next_threads, "Thread stealing order (NUMA)");
+		print_steal_order(pe, pe->threads_next_threads_hierarchical, "Thread stealing order (SMT, L3, NUMA)");
+
+	// Initialzing hw events (PAPI or perf_event_open()) on threads
+		#ifdef _PAPI_SUPPORT
+			hw_events_backend = LL_HW_EVENTS_PAPI;
+		#endif
+		if(LL_HW_EVENTS_BACKEND != NULL && !strcmp(LL_HW_EVENTS_BACKEND, "perf"))
+			hw_events_backend = LL_HW_EVENTS_PERF;
+		#ifndef _PAPI_SUPPORT
+			if(LL_HW_EVENTS_BACKEND != NULL && !strcmp(LL_HW_EVENTS_BACKEND, "papi"))
+				printf("LL_HW_EVENTS_BACKEND: not compiled with PAPI (`make papi=1`), using perf_event_open().\n");
+		#endif
+		printf("Using \033[1;31m%s\033[0;37m  for measurements.\n", hw_events_backend_names[hw_events_backend]);
+
+		#ifdef _PAPI_SUPPORT
+			if(hw_events_backend == LL_HW_EVENTS_PAPI)
+			{
+				assert(sizeof(papi_events)/sizeof(papi_events[0]) <= 32);
+				papi_init();
+			}
+		#endif
+		if(hw_events_backend == LL_HW_EVENTS_PERF)
+			perf_events_init(pe->threads_count);
+
 		pe->papi_args = calloc(sizeof(unsigned long), pe->threads_count);
 		assert(pe->papi_args != NULL);
 		#pragma omp parallel num_threads(pe->threads_count)
 		{
 			unsigned int tid = omp_get_thread_num();
-			pe->papi_args[tid] = papi_start(papi_events, sizeof(papi_events)/sizeof(papi_events[0]));
+			if(hw_events_backend == LL_HW_EVENTS_PERF)
+				pe->papi_args[tid] = perf_events_start(tid);
+			#ifdef _PAPI_SUPPORT
+			else
+				pe->papi_args[tid] = papi_start(papi_events, sizeof(papi_events)/sizeof(papi_events[0]));
+			#endif
+		}
+
+		if(LL_STEP_HW_EVENTS)
+		{
+			pe->step_hw_values = calloc(sizeof(unsigned long), 32 * pe->threads_count);
+			pe->step_hw_resets = calloc(sizeof(unsigned long), pe->threads_count);
+			pe->step_hw_pending = calloc(sizeof(unsigned long), 32 * pe->threads_count);
+			pe->step_hw_deltas = calloc(sizeof(unsigned long), 32 * pe->threads_count);
+			assert(pe->step_hw_values != NULL && pe->step_hw_resets != NULL && pe->step_hw_pending != NULL && pe->step_hw_deltas != NULL);
 		}
 			
 
+		pe->hw_events_count = (pe->papi_args[0] >> 32);
+		if(hw_events_backend == LL_HW_EVENTS_PERF)
+			perf_events_names(pe->papi_args[0], pe->hw_events_names);
+		#ifdef _PAPI_SUPPORT
+		else
 		{
 			unsigned long papi_arg = pe->papi_args[0];
 			unsigned int event_set = (unsigned int) papi_arg;
-			pe->hw_events_count = (papi_arg >> 32);
 			
 			unsigned int temp_count = pe->hw_events_count;
 			unsigned int temp_events[32];
@@ -884,6 +1184,7 @@ struct par_env* initialize_omp_par_env()
 				// printf("%s\n", pe->hw_events_names[i]);
 			}
 		}
+		#endif
 
 		printf("\n\n");
 
@@ -909,6 +1210,248 @@ void numa_interleave_allocated_memory(void* addr, unsigned long mem_size)
 	return;
 }
 
+/*
+	NUMA placement policies of the arrays that are processed by partitions,
+	see numa_place_graph() and numa_place_vertex_array() in partitioning.tpl.c
+
+		LL_NUMA_INTERLEAVE:   pages are interleaved over all nodes (the placement of numa_alloc_interleaved())
+		LL_NUMA_OWNER_LOCAL:  pages of each partition are bound to the node of the thread that owns the partition
+		LL_NUMA_HYBRID:       the graph (offsets_list and edges_list) is owner-local and the vertex arrays
+		                      that are randomly accessed through neighbours (e.g., cc labels) are interleaved
+*/
+#define LL_NUMA_INTERLEAVE  0U
+#define LL_NUMA_OWNER_LOCAL 1U
+#define LL_NUMA_HYBRID      2U
+
+const char* numa_placement_names[] = {"interleave", "owner-local", "hybrid"};
+
+/*
+	Binds the pages of [addr, addr + mem_size) to NUMA node `node`.
+	Pages that have been already allocated are migrated to the node (MPOL_MF_MOVE).
+	`addr` should be page-aligned.
+	Returns 0 on success.
+*/
+int numa_bind_memory_range(void* addr, unsigned long mem_size, unsigned int node)
+{
+	unsigned long maxnode = 64;
+	assert(node < maxnode);
+	assert(((unsigned long)addr & 4095UL) == 0);
+
+	if(mem_size == 0)
+		return 0;
+
+	unsigned long nodemask = 1UL << node;
+	long res = mbind(addr, mem_size, MPOL_BIND, &nodemask, maxnode, MPOL_MF_MOVE);
+	if(res != 0)
+	{
+		printf("numa_bind_memory_range(), can't mbind to node %u: %d %s\n", node, errno, strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+	Interleaves the pages of [addr, addr + mem_size) over all nodes, i.e., the placement of numa_alloc_interleaved(), 
+	after numa_bind_memory_range(). Pages that have been already allocated are migrated (MPOL_MF_MOVE).
+	The range is extended to the borders of its pages.
+	Returns 0 on success.
+*/
+int numa_interleave_memory_range(void* addr, unsigned long mem_size)
+{
+	if(mem_size == 0)
+		return 0;
+
+	unsigned long maxnode = 64;
+	int num_nodes = numa_num_configured_nodes();
+	assert(num_nodes <= maxnode);
+
+	unsigned long nodemask = 0UL;
+	for(int n=0; n < num_nodes; n++)
+		nodemask += (1UL << n);
+
+	unsigned long start = (unsigned long)addr & ~4095UL;
+	unsigned long end = ((unsigned long)addr + mem_size + 4095UL) & ~4095UL;
+	long res = mbind((void*)start, end - start, MPOL_INTERLEAVE, &nodemask, maxnode, MPOL_MF_MOVE);
+	if(res != 0)
+	{
+		printf("numa_interleave_memory_range(), can't mbind: %d %s\n", errno, strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+	Huge pages backing of large arrays, see numa_alloc_interleaved_huge()
+
+		LL_HUGE_PAGES_NONE:  4 KB pages, i.e., numa_alloc_interleaved()
+		LL_HUGE_PAGES_THP:   2 MB-aligned anonymous memory advised by MADV_HUGEPAGE (transparent huge pages)
+		LL_HUGE_PAGES_2M:    explicit 2 MB huge pages (MAP_HUGETLB)
+		LL_HUGE_PAGES_1G:    explicit 1 GB huge pages (MAP_HUGETLB)
+
+	Explicit huge pages should be reserved before, e.g., by
+	`echo 1024 | sudo tee /sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages`.
+*/
+#define LL_HUGE_PAGES_NONE 0U
+#define LL_HUGE_PAGES_THP  1U
+#define LL_HUGE_PAGES_2M   2U
+#define LL_HUGE_PAGES_1G   3U
+
+#ifndef MAP_HUGE_SHIFT
+	#define MAP_HUGE_SHIFT 26
+#endif
+
+const char* huge_pages_names[] = {"4KB", "THP", "2MB", "1GB"};
+
+int is_thp_enabled()
+{
+	FILE* f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+	if(f == NULL)
+		return 0;
+
+	char temp[128] = {0};
+	char* ret = fgets(temp, sizeof(temp) - 1, f);
+	fclose(f);
+	f = NULL;
+
+	if(ret == NULL || strstr(temp, "[never]") != NULL)
+		return 0;
+
+	return 1;
+}
+
+/*
+	Allocates `mem_size` Bytes interleaved over NUMA nodes and backed by the `huge_pages` kind (LL_HUGE_PAGES_*).
+	If a kind is not available, the next smaller kind is tried, i.e., 1 GB, 2 MB, THP, and 4 KB pages.
+	The obtained kind is written to `*obtained` and the memory should be released by numa_free_huge().
+
+	The THP and 4 KB allocations are not rounded up to the huge page size and they can also be released by
+	numa_free(). So, arrays that are returned to the callers (and released by numa_free()) should not
+	request explicit huge pages.
+
+	The arrays are recorded by the memory tracker (mem_tracker.c) with the `tag` of the caller.
+*/
+void* __numa_alloc_interleaved_huge(unsigned long mem_size, unsigned int huge_pages, unsigned int* obtained, const char* tag)
+{
+	assert(mem_size > 0 && huge_pages <= LL_HUGE_PAGES_1G && obtained != NULL);
+
+	// Explicit huge pages
+	for(unsigned int hp = huge_pages; hp >= LL_HUGE_PAGES_2M; hp--)
+	{
+		unsigned int page_bits = hp == LL_HUGE_PAGES_1G ? 30 : 21;
+		unsigned long length = ((mem_size - 1) >> page_bits) + 1;
+		length <<= page_bits;
+
+		void* mem = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (page_bits << MAP_HUGE_SHIFT), -1, 0);
+		if(mem != MAP_FAILED)
+		{
+			numa_interleave_allocated_memory(mem, length);
+			mem_tracker_track(mem, length, -1, tag);
+			*obtained = hp;
+			return mem;
+		}
+	}
+
+	// Transparent huge pages
+	if(huge_pages != LL_HUGE_PAGES_NONE && is_thp_enabled())
+	{
+		unsigned long page_size = 2UL << 20;
+		unsigned long length = (mem_size + 4095UL) & ~4095UL;
+
+		char* mem = mmap(NULL, length + page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(mem != MAP_FAILED)
+		{
+			// Trimming to a 2 MB-aligned range
+			char* aligned_mem = (char*)(((unsigned long)mem + page_size - 1) & ~(page_size - 1));
+			if(aligned_mem != mem)
+				munmap(mem, aligned_mem - mem);
+			if(mem + length + page_size != aligned_mem + length)
+				munmap(aligned_mem + length, mem + length + page_size - (aligned_mem + length));
+			mem = NULL;
+
+			if(madvise(aligned_mem, length, MADV_HUGEPAGE) == 0)
+			{
+				numa_interleave_allocated_memory(aligned_mem, length);
+				mem_tracker_track(aligned_mem, length, -1, tag);
+				*obtained = LL_HUGE_PAGES_THP;
+				return aligned_mem;
+			}
+			munmap(aligned_mem, length);
+		}
+	}
+
+	*obtained = LL_HUGE_PAGES_NONE;
+	return mem_tracker_alloc(mem_size, -1, tag);
+}
+
+#define numa_alloc_interleaved_huge(mem_size, huge_pages, obtained) __numa_alloc_interleaved_huge(mem_size, huge_pages, obtained, __func__)
+
+void numa_free_huge(void* mem, unsigned long mem_size, unsigned int huge_pages)
+{
+	assert(mem != NULL && huge_pages <= LL_HUGE_PAGES_1G);
+
+	if(huge_pages >= LL_HUGE_PAGES_2M)
+	{
+		unsigned int page_bits = huge_pages == LL_HUGE_PAGES_1G ? 30 : 21;
+		unsigned long length = ((mem_size - 1) >> page_bits) + 1;
+		mem_tracker_untrack(mem);
+		munmap(mem, length << page_bits);
+	}
+	else
+		numa_free(mem, mem_size);
+
+	return;
+}
+
+/*
+	Returns the number of Bytes of [mem, mem + mem_size) that are backed by transparent huge pages,
+	using the AnonHugePages of the memory areas in /proc/self/smaps.
+*/
+unsigned long get_thp_bytes(void* mem, unsigned long mem_size)
+{
+	FILE* f = fopen("/proc/self/smaps", "r");
+	if(f == NULL)
+		return 0;
+
+	unsigned long start = (unsigned long)mem;
+	unsigned long end = start + mem_size;
+	unsigned long thp_bytes = 0;
+	int in_range = 0;
+	char line[512];
+	while(fgets(line, sizeof(line), f) != NULL)
+	{
+		unsigned long vma_start, vma_end, kb;
+		if(sscanf(line, "%lx-%lx ", &vma_start, &vma_end) == 2)
+			in_range = vma_start < end && vma_end > start;
+		else if(in_range && sscanf(line, "AnonHugePages: %lu kB", &kb) == 1)
+			thp_bytes += kb * 1024;
+	}
+	fclose(f);
+	f = NULL;
+
+	return min(thp_bytes, mem_size);
+}
+
+/*
+	Prints the kind of pages of an array allocated by numa_alloc_interleaved_huge(),
+	for THP the Bytes that are really backed by huge pages are also printed.
+*/
+void print_huge_pages_stats(char* name, void* mem, unsigned long mem_size, unsigned int huge_pages)
+{
+	assert(huge_pages <= LL_HUGE_PAGES_1G);
+
+	if(huge_pages == LL_HUGE_PAGES_THP)
+	{
+		unsigned long thp_bytes = get_thp_bytes(mem, mem_size);
+		printf("Pages of %-16s %s, %'.1f of %'.1f MB in huge pages\n", name, huge_pages_names[huge_pages], thp_bytes/1e6, mem_size/1e6);
+	}
+	else
+		printf("Pages of %-16s %s, %'.1f MB\n", name, huge_pages_names[huge_pages], mem_size/1e6);
+
+	return;
+}
+
 unsigned long get_swap_size()
 {
 	char temp[256];
@@ -931,8 +1474,437 @@ unsigned long get_free_mem()
 	return total_free_mem;
 }
 
+/*
+	A minimal io_uring (without liburing) for the asynchronous reads of par_read_file().
+
+	ll_io_uring_initialize() returns NULL if io_uring is not supported by the kernel (or is disabled, e.g., by
+	seccomp). The SQEs are prepared by ll_io_uring_prep_read() and submitted by ll_io_uring_submit_and_wait(). 
+	If buffers are registered by ll_io_uring_register_buffers(), the reads of the `buf_index`-th buffer
+	are issued as IORING_OP_READ_FIXED, so the kernel does not map and pin the pages of each request.
+	The registered buffers are pinned and accounted to RLIMIT_MEMLOCK, so only a few staging buffers are registered.
+*/
+struct ll_io_uring
+{
+	int ring_fd;
+	unsigned int entries;
+	unsigned int to_submit;
+	unsigned int registered_buffers;
+
+	void* sq_ptr;
+	unsigned long sq_size;
+	void* cq_ptr;
+	unsigned long cq_size;
+	struct io_uring_sqe* sqes;
+	unsigned long sqes_size;
+
+	unsigned int* sq_head;
+	unsigned int* sq_tail;
+	unsigned int* sq_mask;
+	unsigned int* sq_array;
+	unsigned int* cq_head;
+	unsigned int* cq_tail;
+	unsigned int* cq_mask;
+	struct io_uring_cqe* cqes;
+};
+
+void ll_io_uring_release(struct ll_io_uring* ring)
+{
+	assert(ring != NULL);
+
+	if(ring->sqes != NULL)
+		munmap(ring->sqes, ring->sqes_size);
+	ring->sqes = NULL;
+	if(ring->cq_ptr != NULL && ring->cq_ptr != ring->sq_ptr)
+		munmap(ring->cq_ptr, ring->cq_size);
+	ring->cq_ptr = NULL;
+	if(ring->sq_ptr != NULL)
+		munmap(ring->sq_ptr, ring->sq_size);
+	ring->sq_ptr = NULL;
+
+	// Closing the ring also unregisters the buffers
+	close(ring->ring_fd);
+	ring->ring_fd = -1;
+	free(ring);
+
+	return;
+}
+
+struct ll_io_uring* ll_io_uring_initialize(unsigned int queue_depth)
+{
+	assert(queue_depth > 0);
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	int ring_fd = syscall(__NR_io_uring_setup, queue_depth, &params);
+	if(ring_fd < 0)
+		return NULL;
+
+	struct ll_io_uring* ring = calloc(sizeof(struct ll_io_uring), 1);
+	assert(ring != NULL);
+	ring->ring_fd = ring_fd;
+	ring->entries = params.sq_entries;
+
+	// Mapping the rings
+	ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if(params.features & IORING_FEAT_SINGLE_MMAP)
+		ring->sq_size = ring->cq_size = max(ring->sq_size, ring->cq_size);
+
+	ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if(ring->sq_ptr == MAP_FAILED)
+	{
+		ring->sq_ptr = NULL;
+		ll_io_uring_release(ring);
+		return NULL;
+	}
+
+	if(params.features & IORING_FEAT_SINGLE_MMAP)
+		ring->cq_ptr = ring->sq_ptr;
+	else
+	{
+		ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if(ring->cq_ptr == MAP_FAILED)
+		{
+			ring->cq_ptr = NULL;
+			ll_io_uring_release(ring);
+			return NULL;
+		}
+	}
+
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if(ring->sqes == MAP_FAILED)
+	{
+		ring->sqes = NULL;
+		ll_io_uring_release(ring);
+		return NULL;
+	}
+
+	ring->sq_head = ring->sq_ptr + params.sq_off.head;
+	ring->sq_tail = ring->sq_ptr + params.sq_off.tail;
+	ring->sq_mask = ring->sq_ptr + params.sq_off.ring_mask;
+	ring->sq_array = ring->sq_ptr + params.sq_off.array;
+	ring->cq_head = ring->cq_ptr + params.cq_off.head;
+	ring->cq_tail = ring->cq_ptr + params.cq_off.tail;
+	ring->cq_mask = ring->cq_ptr + params.cq_off.ring_mask;
+	ring->cqes = ring->cq_ptr + params.cq_off.cqes;
+
+	return ring;
+}
+
+/*
+	Registers `count` buffers. Returns 0 on success, or -1 if they cannot be registered 
+	(e.g., because of RLIMIT_MEMLOCK or too many buffers). 
+*/
+int ll_io_uring_register_buffers(struct ll_io_uring* ring, struct iovec* buffers, unsigned int count)
+{
+	assert(ring != NULL && buffers != NULL);
+
+	int ret = syscall(__NR_io_uring_register, ring->ring_fd, IORING_REGISTER_BUFFERS, buffers, count);
+	if(ret < 0)
+		return -1;
+
+	ring->registered_buffers = count;
+
+	return 0;
+}
+
+/*
+	Prepares the read of `length` Bytes from `offset` of `fd` into `mem`. If `buf_index` is not -1U, `mem` 
+	should be in the `buf_index`-th registered buffer.
+	The caller should not have more than `ring->entries` prepared and inflight requests. 
+*/
+void ll_io_uring_prep_read(struct ll_io_uring* ring, int fd, char* mem, unsigned int length, unsigned long offset, 
+	unsigned long user_data, unsigned int buf_index)
+{
+	unsigned int tail = *ring->sq_tail;
+	unsigned int index = tail & *ring->sq_mask;
+	assert(tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) < ring->entries);
+
+	struct io_uring_sqe* sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->fd = fd;
+	sqe->addr = (unsigned long)mem;
+	sqe->len = length;
+	sqe->off = offset;
+	sqe->user_data = user_data;
+	if(buf_index != -1U && buf_index < ring->registered_buffers)
+	{
+		sqe->opcode = IORING_OP_READ_FIXED;
+		sqe->buf_index = buf_index;
+	}
+	else
+		sqe->opcode = IORING_OP_READ;
+
+	ring->sq_array[index] = index;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->to_submit++;
+
+	return;
+}
+
+// Submits the prepared requests and waits for at least `wait_nr` completions
+void ll_io_uring_submit_and_wait(struct ll_io_uring* ring, unsigned int wait_nr)
+{
+	while(1)
+	{
+		int ret = syscall(__NR_io_uring_enter, ring->ring_fd, ring->to_submit, wait_nr, IORING_ENTER_GETEVENTS, NULL, 0);
+		if(ret < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			printf("io_uring_enter() failed: %d, %s\n", errno, strerror(errno));
+			assert(ret >= 0);
+		}
+
+		assert(ret <= ring->to_submit);
+		ring->to_submit -= ret;
+		if(ring->to_submit == 0)
+			break;
+	}
+
+	return;
+}
+
+// Returns 1 and sets `user_data` and `res` if a completion is available, otherwise 0
+int ll_io_uring_get_completion(struct ll_io_uring* ring, unsigned long* user_data, int* res)
+{
+	unsigned int head = *ring->cq_head;
+	if(head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+		return 0;
+
+	struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+	*user_data = cqe->user_data;
+	*res = cqe->res;
+	__atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/*
+	The io_uring of par_read_file() is created by the first call of __par_read_file_io_uring() and is used until 
+	the exit of the process. At its creation, LL_IO_STAGING_SIZE Bytes are divided into one staging buffer per entry 
+	of the ring and are registered as fixed buffers, so the blocks are read by IORING_OP_READ_FIXED into the staging 
+	buffers and copied to the destination. If the buffers cannot be registered (e.g., because of RLIMIT_MEMLOCK), 
+	the blocks (LL_IO_BLOCK_SIZE Bytes each) are read directly into the destination by IORING_OP_READ.
+	par_read_file() is called by one thread at a time, so the ring is not protected by a lock.
+*/
+#define LL_IO_BLOCK_SIZE (1UL << 20)
+#define LL_IO_STAGING_SIZE (8UL << 20)
+
+struct ll_io_uring* ll_io_ring = NULL;
+unsigned int ll_io_ring_state = 0;          // 0: not initialized, 1: available, 2: not available
+char* ll_io_staging_buffers = NULL;         // NULL if the staging buffers are not registered
+unsigned long ll_io_staging_buffer_size = 0;
+
+void __ll_io_ring_release()
+{
+	if(ll_io_ring != NULL)
+		ll_io_uring_release(ll_io_ring);
+	ll_io_ring = NULL;
+	if(ll_io_staging_buffers != NULL)
+		free(ll_io_staging_buffers);
+	ll_io_staging_buffers = NULL;
+	ll_io_staging_buffer_size = 0;
+	ll_io_ring_state = 0;
+
+	return;
+}
+
+// Returns the ring of par_read_file(), or NULL if io_uring is not available
+struct ll_io_uring* __ll_io_ring_get()
+{
+	if(ll_io_ring_state != 0)
+		return ll_io_ring;
+
+	ll_io_ring_state = 2;
+	ll_io_ring = ll_io_uring_initialize(LL_IO_QUEUE_DEPTH);
+	if(ll_io_ring == NULL)
+	{
+		printf("io_uring is not available, files are read by pread().\n");
+		return NULL;
+	}
+	ll_io_ring_state = 1;
+	atexit(__ll_io_ring_release);
+
+	// Registering the staging buffers, one per entry of the ring (at most 1024, UIO_MAXIOV, of at least 4 KB)
+	unsigned int buffers_count = min(ll_io_ring->entries, 1024U);
+	ll_io_staging_buffer_size = min(LL_IO_BLOCK_SIZE, max(4096UL, (LL_IO_STAGING_SIZE / buffers_count) & ~4095UL));
+	ll_io_staging_buffers = aligned_alloc(4096, ll_io_staging_buffer_size * buffers_count);
+	assert(ll_io_staging_buffers != NULL);
+	struct iovec* buffers = calloc(sizeof(struct iovec), buffers_count);
+	assert(buffers != NULL);
+	for(unsigned int b = 0; b < buffers_count; b++)
+	{
+		buffers[b].iov_base = ll_io_staging_buffers + b * ll_io_staging_buffer_size;
+		buffers[b].iov_len = ll_io_staging_buffer_size;
+	}
+	if(ll_io_uring_register_buffers(ll_io_ring, buffers, buffers_count) != 0)
+	{
+		printf("io_uring: %u fixed buffers of %lu KB cannot be registered (%d, %s), using unregistered reads.\n", 
+			buffers_count, ll_io_staging_buffer_size >> 10, errno, strerror(errno));
+		free(ll_io_staging_buffers);
+		ll_io_staging_buffers = NULL;
+	}
+	free(buffers);
+	buffers = NULL;
+
+	return ll_io_ring;
+}
+
+/*
+	Reads [start_offset, end_offset) of the file to `mem` using io_uring with LL_IO_QUEUE_DEPTH inflight requests 
+	(of the size of staging buffers if they are registered, otherwise LL_IO_BLOCK_SIZE Bytes). The first `head_bytes` 
+	and the unaligned tail are read by a buffered fd and the other blocks by an O_DIRECT fd. 
+
+	Returns 0 on success and -1 if io_uring is not available (nothing has been read).
+*/
+int __par_read_file_io_uring(char* file_name, unsigned long start_offset, unsigned long end_offset, char* mem, unsigned long head_bytes)
+{
+	struct ll_io_uring* ring = __ll_io_ring_get();
+	if(ring == NULL)
+		return -1;
+
+	int fd = open(file_name, O_RDONLY);
+	assert(fd > 0);
+	int direct_fd = open(file_name, O_RDONLY | O_DIRECT);
+	if(direct_fd < 0)
+		direct_fd = fd;     // e.g., tmpfs does not support O_DIRECT
+
+	// Creating requests
+	unsigned long block_size = ll_io_staging_buffers != NULL ? ll_io_staging_buffer_size : LL_IO_BLOCK_SIZE;
+	head_bytes = min(head_bytes, end_offset - start_offset);
+	unsigned long requests_count = (head_bytes != 0) + (end_offset - start_offset - head_bytes + block_size - 1) / block_size;
+	struct iovec* requests = calloc(sizeof(struct iovec), requests_count);
+	unsigned long* requests_offset = calloc(sizeof(unsigned long), requests_count);
+	assert(requests != NULL && requests_offset != NULL);
+	{
+		unsigned long r = 0;
+		unsigned long offset = start_offset;
+		while(offset < end_offset)
+		{
+			unsigned long length = r == 0 && head_bytes != 0 ? head_bytes : min(block_size, end_offset - offset);
+			requests[r].iov_base = mem + offset - start_offset;
+			requests[r].iov_len = length;
+			requests_offset[r] = offset;
+			offset += length;
+			r++;
+		}
+		assert(r == requests_count);
+	}
+
+	// The free staging buffers, a request is read into a staging buffer if they have been registered
+	unsigned int staging_count = ll_io_staging_buffers != NULL ? ring->registered_buffers : 0;
+	unsigned int* free_staging = calloc(sizeof(unsigned int), max(staging_count, 1U));
+	assert(free_staging != NULL);
+	unsigned int free_staging_count = staging_count;
+	for(unsigned int s = 0; s < staging_count; s++)
+		free_staging[s] = s;
+	unsigned int max_inflight = staging_count ? min(staging_count, ring->entries) : ring->entries;
+
+	// Reading, `requests_read[r]` is the number of Bytes of request `r` that have been read
+	unsigned long* requests_read = calloc(sizeof(unsigned long), requests_count);
+	assert(requests_read != NULL);
+
+	// user_data: (request << 16) + staging buffer
+	#define __LL_IO_SUBMIT(__r) \
+	{ \
+		unsigned long __offset = requests_offset[__r] + requests_read[__r]; \
+		unsigned long __length = requests[__r].iov_len - requests_read[__r]; \
+		int __fd = __offset % 4096 == 0 && __length % 4096 == 0 ? direct_fd : fd; \
+		if(staging_count) \
+		{ \
+			assert(free_staging_count > 0); \
+			unsigned int __s = free_staging[--free_staging_count]; \
+			ll_io_uring_prep_read(ring, __fd, ll_io_staging_buffers + __s * ll_io_staging_buffer_size, __length, __offset, (__r << 16) + __s, __s); \
+		} \
+		else \
+			ll_io_uring_prep_read(ring, __fd, (char*)requests[__r].iov_base + requests_read[__r], __length, __offset, __r << 16, -1U); \
+		inflight++; \
+	}
+
+	unsigned long next_request = 0;
+	unsigned long completed_requests = 0;
+	unsigned long total_read_bytes = 0;
+	unsigned int inflight = 0;
+	while(completed_requests < requests_count)
+	{
+		while(inflight < max_inflight && next_request < requests_count)
+		{
+			__LL_IO_SUBMIT(next_request);
+			next_request++;
+		}
+
+		ll_io_uring_submit_and_wait(ring, 1);
+
+		unsigned long user_data = 0;
+		int res = 0;
+		while(ll_io_uring_get_completion(ring, &user_data, &res))
+		{
+			unsigned long r = user_data >> 16;
+			inflight--;
+			if(staging_count)
+			{
+				unsigned int s = user_data & 0xffffU;
+				if(res > 0)
+					memcpy((char*)requests[r].iov_base + requests_read[r], ll_io_staging_buffers + s * ll_io_staging_buffer_size, res);
+				free_staging[free_staging_count++] = s;
+			}
+
+			if(res == -EINTR || res == -EAGAIN)
+			{
+				__LL_IO_SUBMIT(r);
+				continue;
+			}
+			if(res <= 0)
+			{
+				printf("Reading \"%s\" failed: %d, %s\n", file_name, -res, res == 0 ? "end of file" : strerror(-res));
+				assert(res > 0);
+			}
+
+			total_read_bytes += res;
+			requests_read[r] += res;
+			if(requests_read[r] == requests[r].iov_len)
+				completed_requests++;
+			else
+			{
+				// A short read, the remaining bytes are read by a new request
+				__LL_IO_SUBMIT(r);
+			}
+		}
+	}
+	#undef __LL_IO_SUBMIT
+
+	assert(inflight == 0);
+	if(total_read_bytes != end_offset - start_offset)
+	{
+		printf("%lu %lu\n", total_read_bytes, end_offset - start_offset);
+		assert(total_read_bytes == end_offset - start_offset);
+	}
+
+	// Releasing, the ring is kept for the next calls
+	if(direct_fd != fd)
+		close(direct_fd);
+	direct_fd = -1;
+	close(fd);
+	fd = -1;
+	free(requests);
+	requests = NULL;
+	free(requests_offset);
+	requests_offset = NULL;
+	free(requests_read);
+	requests_read = NULL;
+	free(free_staging);
+	free_staging = NULL;
+	ring = NULL;
+
+	return 0;
+}
+
 // This function reads the file from disk in parallel using O_DIRECT (without caching)
 // It is required that main_mem has 2 * 4096 bytes more space than end_offset - start_offset
+// If LL_IO_QUEUE_DEPTH is not zero, io_uring is used and otherwise (or if io_uring is not available) 
+// the blocks are read by blocking pread() calls of the OpenMP threads.
 
 char* par_read_file(char* file_name, unsigned long start_offset, unsigned long end_offset, char* main_mem)
 {
@@ -977,29 +1949,31 @@ char* par_read_file(char* file_name, unsigned long start_offset, unsigned long e
 
 	// printf("%lu %lu", start_offset, start_bytes_before_4096);
 
+	// Asynchronous reading
+	if(LL_IO_QUEUE_DEPTH > 0 && __par_read_file_io_uring(file_name, start_offset, end_offset, mem, start_bytes_before_4096) == 0)
+		return mem;
+
 	unsigned long total_read_bytes = 0;
 
+	// The fds are shared by the threads and pread() is used 
+	int fd = open(file_name, O_RDONLY); 
+	assert(fd > 0);
+	int direct_fd = open(file_name, O_RDONLY | O_DIRECT); 
+	if(direct_fd < 0)
+		direct_fd = fd;
+
 	// Reading the start_bytes_before_4096
 	if(start_bytes_before_4096)
 	{
-		int fd = open(file_name, O_RDONLY); 
-		assert(fd > 0);
-
-		unsigned long new_offset = lseek(fd, start_offset, SEEK_SET);
-		assert(new_offset == start_offset);
-
 		unsigned long read_bytes = 0;
 		while(read_bytes < start_bytes_before_4096)
 		{
-			long ret = read(fd, mem + read_bytes, start_bytes_before_4096 - read_bytes);
-			assert(ret != -1);
+			long ret = pread(fd, mem + read_bytes, start_bytes_before_4096 - read_bytes, start_offset + read_bytes);
+			assert(ret > 0);
 			read_bytes += ret;
 		}
 		
 		total_read_bytes += read_bytes;	
-
-		close(fd);
-		fd = -1;
 	}
 
 	// Reading the blocks
@@ -1013,32 +1987,30 @@ char* par_read_file(char* file_name, unsigned long start_offset, unsigned long e
 		unsigned long start_byte = start_offset + start_bytes_before_4096 + r * read_size;
 
 		unsigned long length = read_size;
-		int fd = -1; 
+		int rfd = direct_fd; 
 		if(r == number_of_reads - 1)
 		{
 			length = end_offset - start_byte;
-			fd = open(file_name, O_RDONLY); 
+			rfd = fd; 
 		}
-		else
-			fd = open(file_name, O_RDONLY | O_DIRECT); 
-		assert(fd > 0);
-
-		unsigned long new_offset = lseek(fd, start_byte, SEEK_SET);
-		assert(new_offset == start_byte);
 
 		unsigned long read_bytes = 0;
 		while(read_bytes < length)
 		{
-			long ret = read(fd, mem + start_byte - start_offset + read_bytes , length - read_bytes);
-			assert(ret != -1);
+			long ret = pread(rfd, mem + start_byte - start_offset + read_bytes , length - read_bytes, start_byte + read_bytes);
+			assert(ret > 0);
 			read_bytes += ret;
 		}
 		
 		total_read_bytes += read_bytes;	
-		close(fd);
-		fd = -1;
 	}
 
+	if(direct_fd != fd)
+		close(direct_fd);
+	direct_fd = -1;
+	close(fd);
+	fd = -1;
+
 	if(total_read_bytes != end_offset - start_offset)
 	{
 		printf("%lu %lu\n", total_read_bytes, end_offset - start_offset);
@@ -1047,4 +2019,7 @@ char* par_read_file(char* file_name, unsigned long start_offset, unsigned long e
 
 	return mem;
 }
+#include "trace.c"
+#include "energy.c"
+
 #endif
@@ -74,124 +74,315 @@ int serial_edge_partitioning(struct ll_400_graph* g, unsigned int* borders, int
 	return 0;
 }
 
-int parallel_edge_partitioning(struct ll_400_graph* g, unsigned int* borders, int partitions)
+/*
+	Adds the partial count `val` of a split vertex `v` of edge tiles (see parallel_edge_tiling()), 
+	e.g., the number of edges of a tile, to `counts[v]`.
+*/
+void edge_tiles_reduce_add(unsigned long* counts, unsigned long v, unsigned long val)
 {
-	assert(partitions > 0 && g->vertices_count > 0);
+	__atomic_add_fetch(&counts[v], val, __ATOMIC_RELAXED);
 
-	borders[0] = 0;
-	borders[partitions] = g->vertices_count;
+	return;
+}
 
-	if(g->vertices_count <= 4 * partitions)
+/*
+	Partition planner: chooses the number of partitions per thread of an algorithm for a graph 
+	when `LL_PARTITIONS_PLANNER` is 1 (otherwise, the `default_thread_partitions` of the algorithm is used).
+	
+	The plan is created by partitions_plan_create() (partitioning.tpl.c) using the degree statistics of the graph: 
+		- If the degrees are uniform (coefficient of variation < 1) and no vertex has more edges than 
+		1/4 of a default partition, `default_thread_partitions / 4` partitions are used (at least 16) 
+		as the dispensing is the only overhead of extra partitions.
+		- If a vertex has more edges than a default partition or the coefficient of variation is > 10, 
+		`4 * default_thread_partitions` partitions are used (at most 1024), so that the other threads 
+		process (and steal) the remaining partitions while the partition of the hub is processed.
+		- If a previous execution of the algorithm for a graph with the same |V| and |E| has been recorded
+		in this process (by partitions_plan_release()), its partitions per thread is doubled if its idle 
+		percentage has been > 10% and is halved if it has been < 2%.
+	
+	Algorithms call partitions_plan_add_step() after each step processed by the partitions, with the times
+	used by PTIP, and the idle percentage of all steps is recorded by partitions_plan_release().
+	The algorithms store `thread_partitions` of the plan in their `exec_info`.
+*/
+struct partitions_plan
+{
+	char* algorithm;
+	unsigned long vertices_count;
+	unsigned long edges_count;
+
+	unsigned int default_thread_partitions;
+	unsigned int thread_partitions;
+	
+	unsigned long max_degree;
+	double degree_cv;            // coefficient of variation of degrees
+	double prev_idle_percentage; // -1 if no previous execution
+
+	unsigned long steps_time;
+	double steps_idle_time;
+};
+
+#define LL_PARTITIONS_PLAN_HISTORY 32
+struct partitions_plan partitions_plan_history[LL_PARTITIONS_PLAN_HISTORY];
+unsigned int partitions_plan_history_count = 0;
+
+void partitions_plan_decide(struct par_env* pe, struct partitions_plan* pp)
+{
+	unsigned int tp = pp->default_thread_partitions;
+	pp->prev_idle_percentage = -1;
+
+	if(LL_PARTITIONS_PLANNER)
 	{
-		unsigned int remained_vertices = g->vertices_count;
-		unsigned int remained_partitions = partitions;
-		for(int i=1;i<partitions;i++)
-		{
-			if(remained_vertices > 0)
-			{
-				unsigned int q = max(1,remained_vertices/remained_partitions);
-				borders[i] = borders[i-1] + q;
-				remained_vertices -= q;
-			}
-			else
-				borders[i] = g->vertices_count;
+		unsigned long default_partition_edges = (pp->edges_count + pp->vertices_count) / (pe->threads_count * pp->default_thread_partitions);
+		if(pp->max_degree > default_partition_edges || pp->degree_cv > 10)
+			tp = min(1024U, 4 * tp);
+		else if(pp->degree_cv < 1 && pp->max_degree <= default_partition_edges / 4)
+			tp = max(16U, tp / 4);
 
-			//printf("%d %d %d\n",i,borders[i], remained_vertices);
-			remained_partitions--;
+		for(unsigned int h = 0; h < partitions_plan_history_count; h++)
+		{
+			struct partitions_plan* prev = &partitions_plan_history[h];
+			if(strcmp(prev->algorithm, pp->algorithm) || prev->vertices_count != pp->vertices_count || prev->edges_count != pp->edges_count)
+				continue;
+
+			pp->prev_idle_percentage = prev->prev_idle_percentage;
+			tp = prev->thread_partitions;
+			if(pp->prev_idle_percentage > 10)
+				tp = min(1024U, 2 * tp);
+			else if(pp->prev_idle_percentage < 2)
+				tp = max(8U, tp / 2);
+			break;
 		}
 	}
-	else
+	pp->thread_partitions = tp;
+
+	if(LL_PARTITIONS_PLANNER)
 	{
-		unsigned long edges_per_thread = (g->edges_count + g->vertices_count) / partitions;
-		
-		#pragma omp parallel for
-		for(unsigned int t = 1; t < partitions; t++)
-		{
-			unsigned long start = 0;
-			unsigned long end = g->vertices_count;
-			unsigned long target = t * edges_per_thread;
-			unsigned long m = (start + end)/2;
-			while(1)
-			{
-				unsigned long m_val = g->offsets_list[m] + m;
-				if( m_val == target )
-					break;
+		char prev_idle[32] = "-";
+		if(pp->prev_idle_percentage >= 0)
+			sprintf(prev_idle, "%.2f%%", pp->prev_idle_percentage);
+		printf("Partitions plan (%s): \t\t max-degree: %'lu, degree CV: %.2f, prev. idle: %s, partitions per thread: %u\n",
+			pp->algorithm, pp->max_degree, pp->degree_cv, prev_idle, pp->thread_partitions);
+	}
 
-				unsigned long b_val = g->offsets_list[m - 1] + m - 1;
-				if( b_val < target && m_val > target )
-					break;
+	return;
+}
 
-				if(m_val > target)
-					end = m;
-				if(m_val < target)
-					start = m;
+void partitions_plan_add_step(struct partitions_plan* pp, unsigned long mt, unsigned long* ttimes, unsigned int threads_count)
+{
+	pp->steps_time += mt;
+	pp->steps_idle_time += mt * get_idle_percentage(mt, ttimes, threads_count) / 100.0;
 
-				unsigned long new_m = (start + end)/2;
-				if(new_m == m)
-					break;
-				m = new_m;
-			}
-			assert( m <= g->vertices_count );
-			
-			borders[t] = m;
-		}	
+	return;
+}
 
-		unsigned int last_m = 0;
-		for(unsigned int t = 1; t < partitions; t++)
+/*
+	Records the idle percentage of the steps in the history and releases `pp`.
+*/
+void partitions_plan_release(struct partitions_plan* pp)
+{
+	assert(pp != NULL);
+
+	if(pp->steps_time > 0)
+	{
+		double idle_percentage = 100.0 * pp->steps_idle_time / pp->steps_time;
+		if(LL_PARTITIONS_PLANNER)
+			printf("Partitions plan (%s): \t\t partitions per thread: %u, idle: %.2f%%\n", pp->algorithm, pp->thread_partitions, idle_percentage);
+
+		unsigned int h = 0;
+		for(; h < partitions_plan_history_count; h++)
+			if(!strcmp(partitions_plan_history[h].algorithm, pp->algorithm) && partitions_plan_history[h].vertices_count == pp->vertices_count 
+				&& partitions_plan_history[h].edges_count == pp->edges_count)
+				break;
+		if(h == partitions_plan_history_count)
 		{
-			if(borders[t] <= last_m)
-				borders[t] = last_m + 1;
-			if(borders[t] > g->vertices_count)
-				borders[t] = g->vertices_count;
-			
-			last_m = borders[t];
+			if(partitions_plan_history_count < LL_PARTITIONS_PLAN_HISTORY)
+				partitions_plan_history_count++;
+			else
+				h = 0;
 		}
+
+		partitions_plan_history[h] = *pp;
+		partitions_plan_history[h].prev_idle_percentage = idle_percentage;
 	}
 
-	//verify_serial_edge_partitioning(g, borders, partitions);
+	free(pp);
+	pp = NULL;
 
-	return 0;
+	return;
 }
 
+/*
+	Dynamic partitioning: each thread is assigned a contiguous range of partitions that it processes in
+	the ascending order and after finishing it, the thread steals from the ranges of other threads in the
+	stealing order of `dp->threads_next_threads` (by default, `pe->threads_next_threads` that visits the threads of the same 
+	NUMA node first, see dynamic_partitioning_set_steal_order()).
+
+	The remaining range of each thread, [begin, end), is stored in a single 8 Bytes word 
+	(`begin` in the low 24 bits, `end` in the next 24 bits, and the epoch of the range in the high 16 bits) 
+	in a separate cacheline:
+		- The owner claims a partition by a `fetch_add` of 1 on the word, i.e., incrementing `begin`,
+		that succeeds if the returned `begin` is smaller than `end`. After the range is emptied, 
+		`begin` may be incremented past `end`, which still represents an empty range.
+		- A thief splits the range by a CAS that decreases `end` by half of the remaining partitions, 
+		i.e., the last partitions of the victim are stolen to prevent interrupting normal order of the victim. 
+		The thief processes the first stolen partition and stores the rest as its own range, so that they 
+		may be stolen again by other threads.
+
+	A non-empty word always contains the partitions that are not claimed yet, so a successful CAS on 
+	a word that has been changed and restored to the same value by other threads is still correct.
+
+	dynamic_partitioning_reset() only increments `dp->epoch`. A range with an older epoch is replaced by the 
+	initial range of its thread (by a CAS) when it is read for the first time in the new epoch, either by its 
+	owner or by a thief. As each thread reads its own range in each epoch, a range is at most one epoch old 
+	(unless the partitions are not processed after a number of resets that is a multiple of 2^16).
+*/
+
+#define __DP_RANGE(__begin, __end, __epoch) (((unsigned long)(__epoch) << 48) + ((unsigned long)(__end) << 24) + (unsigned long)(__begin))
+#define __DP_RANGE_BEGIN(__range) ((unsigned int)((__range) & 0xFFFFFFUL))
+#define __DP_RANGE_END(__range) ((unsigned int)(((__range) >> 24) & 0xFFFFFFUL))
+#define __DP_RANGE_EPOCH(__range) ((unsigned int)((__range) >> 48))
+#define __DP_EPOCH(__dp) ((__dp)->epoch & 0xFFFFU)
+#define __DP_CURSOR_ULONGS (64 / sizeof(unsigned long))
+
+/*
+	Scheduler telemetry, compiled with `-D_DP_TELEMETRY` (`make ... dp_telemetry=1`): 
+	dynamic_partitioning_get_next_partition() counts the partitions claimed from the range of each thread, 
+	the partitions stolen by the distance of the victim (sharing the L3 cache, on the same NUMA node, or on 
+	another node), and the failed CAS operations of stealing. It also measures the elapsed time of each 
+	partition from its claim to the next call of the thread. 
+	The counters are printed and cleared by PTIP (through `ptip_hook` of omp.c) for each dp that has 
+	been used in the step (see dynamic_partitioning_print_telemetry()).
+*/
+#define __DP_TM_LOCAL         0
+#define __DP_TM_STOLEN_L3     1
+#define __DP_TM_STOLEN_NODE   2
+#define __DP_TM_STOLEN_REMOTE 3
+#define __DP_TM_FAILED_CAS    4
+#define __DP_TM_BUSY_TIME     5
+#define __DP_TM_MAX_TIME      6
+#define __DP_TM_MAX_PARTITION 7
+#define __DP_TM_CLAIM_TIME    8
+#define __DP_TM_ULONGS        16  // 128 Bytes for each thread
+
+#ifdef _DP_TELEMETRY
+	#define __DP_TM_ADD(__dp, __thread_id, __counter) ((__dp)->threads_telemetry[(__thread_id) * __DP_TM_ULONGS + (__counter)]++)
+	#define __DP_TM_CLAIM(__dp, __thread_id, __counter) \
+	{ \
+		__DP_TM_ADD(__dp, __thread_id, __counter); \
+		(__dp)->threads_telemetry[(__thread_id) * __DP_TM_ULONGS + __DP_TM_CLAIM_TIME] = get_nano_time(); \
+	}
+#else
+	#define __DP_TM_ADD(__dp, __thread_id, __counter)
+	#define __DP_TM_CLAIM(__dp, __thread_id, __counter)
+#endif
+
 struct dynamic_partitioning
 {
 	struct par_env* pe;
 
 	unsigned int partitions_count;
-	unsigned int partitions_remained;
 	unsigned int threads_count;
+	unsigned int epoch;
 
 	unsigned int* threads_partitions_start;
 	unsigned int* threads_partitions_end;
-	unsigned int* threads_partitions_remained;
 
-	unsigned int* threads_last_steal_offset;
-	
-	unsigned char* partitions_status;
+	unsigned int** threads_next_threads;
+
+	// A 64 Bytes cursor for each thread, [0]: the remaining range, [1]: the offset in the stealing order
+	unsigned long* threads_cursors;
+	unsigned long* threads_cursors_not_aligned;
+
+	#ifdef _DP_TELEMETRY
+		// __DP_TM_ULONGS counters for each thread and the elapsed time of the last processing of each partition (ns)
+		unsigned long* threads_telemetry;
+		unsigned long* threads_telemetry_not_aligned;
+		unsigned long* partitions_time;
+	#endif
 };
 
+#ifdef _DP_TELEMETRY
+#define __DP_TELEMETRY_MAX_DPS 64
+struct dynamic_partitioning* dp_telemetry_dps[__DP_TELEMETRY_MAX_DPS];
+
+/*
+	Prints the scheduler telemetry of `dp` since the previous print (if any partition has been claimed) and 
+	clears it. It is called by PTIP and should be called when the threads are not processing the partitions.
+*/
+void dynamic_partitioning_print_telemetry(struct dynamic_partitioning* dp)
+{
+	unsigned long totals[__DP_TM_ULONGS] = {0};
+	unsigned int max_thread = 0;
+	for(unsigned int t = 0; t < dp->threads_count; t++)
+	{
+		unsigned long* tm = dp->threads_telemetry + t * __DP_TM_ULONGS;
+		for(unsigned int c = __DP_TM_LOCAL; c <= __DP_TM_BUSY_TIME; c++)
+			totals[c] += tm[c];
+		if(tm[__DP_TM_MAX_TIME] > totals[__DP_TM_MAX_TIME])
+		{
+			totals[__DP_TM_MAX_TIME] = tm[__DP_TM_MAX_TIME];
+			totals[__DP_TM_MAX_PARTITION] = tm[__DP_TM_MAX_PARTITION];
+			max_thread = t;
+		}
+	}
+
+	unsigned long claims = totals[__DP_TM_LOCAL] + totals[__DP_TM_STOLEN_L3] + totals[__DP_TM_STOLEN_NODE] + totals[__DP_TM_STOLEN_REMOTE];
+	if(claims == 0)
+		return;
+
+	printf("  Scheduler (%'u partitions): local: %'lu, stolen (L3/node/remote): %'lu/%'lu/%'lu, failed CAS: %'lu, partition time avg: %'.2f (us), max: %'.2f (us) (partition %'lu, thread %u)\n",
+		dp->partitions_count, totals[__DP_TM_LOCAL], totals[__DP_TM_STOLEN_L3], totals[__DP_TM_STOLEN_NODE], totals[__DP_TM_STOLEN_REMOTE],
+		totals[__DP_TM_FAILED_CAS], totals[__DP_TM_BUSY_TIME] / 1e3 / claims, totals[__DP_TM_MAX_TIME] / 1e3, totals[__DP_TM_MAX_PARTITION], max_thread
+	);
+	for(unsigned int t = 0; t < dp->threads_count; t++)
+	{
+		unsigned long* tm = dp->threads_telemetry + t * __DP_TM_ULONGS;
+		printf("    Thread %3u: local: %'6lu, stolen: %'5lu/%'5lu/%'5lu, failed CAS: %'5lu, busy: %'10.2f (ms), max partition: %'8.2f (us)\n",
+			t, tm[__DP_TM_LOCAL], tm[__DP_TM_STOLEN_L3], tm[__DP_TM_STOLEN_NODE], tm[__DP_TM_STOLEN_REMOTE], tm[__DP_TM_FAILED_CAS], 
+			tm[__DP_TM_BUSY_TIME] / 1e6, tm[__DP_TM_MAX_TIME] / 1e3
+		);
+		for(unsigned int c = 0; c < __DP_TM_ULONGS; c++)
+			tm[c] = 0;
+	}
+
+	return;
+}
+
+void __dynamic_partitioning_ptip_hook(struct par_env* pe)
+{
+	for(unsigned int d = 0; d < __DP_TELEMETRY_MAX_DPS; d++)
+		if(dp_telemetry_dps[d] != NULL && dp_telemetry_dps[d]->pe == pe)
+			dynamic_partitioning_print_telemetry(dp_telemetry_dps[d]);
+
+	return;
+}
+#endif
+
 struct dynamic_partitioning* dynamic_partitioning_initialize(struct par_env* pe, unsigned int partitions_count)
 {
 	assert(partitions_count > 0 && pe != NULL);
+	assert(partitions_count < (1U << 24) - pe->threads_count);  // `begin` of an emptied range may pass `end`
 	
 	struct dynamic_partitioning* dp = calloc(sizeof(struct dynamic_partitioning), 1);
 	assert(dp != NULL);
 	dp->partitions_count = partitions_count;
 	dp->pe = pe;
 	dp->threads_count = pe->threads_count;
+	dp->threads_next_threads = pe->threads_next_threads;
 
 	dp->threads_partitions_start = calloc(pe->threads_count ,sizeof(unsigned int));
 	dp->threads_partitions_end = calloc(pe->threads_count ,sizeof(unsigned int));
-	dp->threads_partitions_remained = calloc(pe->threads_count,sizeof(unsigned int));
-	assert(dp->threads_partitions_start != NULL && dp->threads_partitions_end != NULL && dp->threads_partitions_remained != NULL);
+	assert(dp->threads_partitions_start != NULL && dp->threads_partitions_end != NULL);
 
-	dp->threads_last_steal_offset = calloc(pe->threads_count ,sizeof(unsigned int));
-	assert(dp->threads_last_steal_offset != NULL);
-
-	dp->partitions_status = calloc(dp->partitions_count, sizeof(unsigned char));
-	assert(dp->partitions_status != NULL);
-
-	dp->partitions_remained = partitions_count;
+	dp->threads_cursors = calloc((pe->threads_count + 1) * __DP_CURSOR_ULONGS, sizeof(unsigned long));
+	assert(dp->threads_cursors != NULL);
+	dp->threads_cursors_not_aligned = dp->threads_cursors;
+	// 64 Bytes alignment
+	if((unsigned long)dp->threads_cursors % 64 != 0)
+	{
+		unsigned long addr = (unsigned long)dp->threads_cursors;
+		dp->threads_cursors = (unsigned long*)(addr + 64 - addr % 64);
+	}
 
 	// Partitioning for nodes and threads
 	unsigned int remained_threads = pe->threads_count;
@@ -204,24 +395,84 @@ struct dynamic_partitioning* dynamic_partitioning_initialize(struct par_env* pe,
 		unsigned int quota = remained_partitions/remained_threads;
 		offset += quota;
 		dp->threads_partitions_end[t] = offset;
-		dp->threads_partitions_remained[t] = quota;
 
 		remained_threads--;
 		remained_partitions -= quota;
 
-		dp->threads_last_steal_offset[t] = 0;
+		dp->threads_cursors[t * __DP_CURSOR_ULONGS] = __DP_RANGE(dp->threads_partitions_start[t], dp->threads_partitions_end[t], __DP_EPOCH(dp));
+		dp->threads_cursors[t * __DP_CURSOR_ULONGS + 1] = 0;
 
 		// printf("\t\tPartitions for thread %u: %'u - %'u\n",t, dp->threads_partitions_start[t], dp->threads_partitions_end[t]);
 	}
 
+	#ifdef _DP_TELEMETRY
+	{
+		dp->threads_telemetry = calloc((pe->threads_count + 1) * __DP_TM_ULONGS, sizeof(unsigned long));
+		dp->partitions_time = calloc(partitions_count, sizeof(unsigned long));
+		assert(dp->threads_telemetry != NULL && dp->partitions_time != NULL);
+		dp->threads_telemetry_not_aligned = dp->threads_telemetry;
+		if((unsigned long)dp->threads_telemetry % 64 != 0)
+		{
+			unsigned long addr = (unsigned long)dp->threads_telemetry;
+			dp->threads_telemetry = (unsigned long*)(addr + 64 - addr % 64);
+		}
+
+		for(unsigned int d = 0; d < __DP_TELEMETRY_MAX_DPS; d++)
+			if(dp_telemetry_dps[d] == NULL)
+			{
+				dp_telemetry_dps[d] = dp;
+				break;
+			}
+		ptip_hook = __dynamic_partitioning_ptip_hook;
+	}
+	#endif
+
 	return dp;
 }
 
+/*
+	Sets the order of victims of threads in stealing: 
+		LL_STEAL_ORDER_NUMA (default): the threads on the same NUMA node and then the threads on other nodes
+		LL_STEAL_ORDER_HIERARCHICAL: the SMT siblings, the threads sharing the L3 cache, the threads on the same 
+			NUMA node and then the threads on other nodes (see initialize_omp_par_env())
+	It should be called before processing the partitions.
+*/
+void dynamic_partitioning_set_steal_order(struct dynamic_partitioning* dp, unsigned int steal_order)
+{
+	assert(dp != NULL && (steal_order == LL_STEAL_ORDER_NUMA || steal_order == LL_STEAL_ORDER_HIERARCHICAL));
+
+	if(steal_order == LL_STEAL_ORDER_HIERARCHICAL)
+		dp->threads_next_threads = dp->pe->threads_next_threads_hierarchical;
+	else
+		dp->threads_next_threads = dp->pe->threads_next_threads;
+
+	return;
+}
+
+/*
+	Returns an array that maps each partition to the thread that owns it in `dp`, i.e., the thread that
+	processes it if no partition is stolen. It is the `partition_owner` argument of numa_place_graph()
+	and numa_place_vertex_array(). The caller should free() it.
+*/
+unsigned int* dynamic_partitioning_get_partition_owners(struct dynamic_partitioning* dp)
+{
+	assert(dp != NULL);
+
+	unsigned int* partition_owner = calloc(sizeof(unsigned int), dp->partitions_count);
+	assert(partition_owner != NULL);
+
+	for(unsigned int t = 0; t < dp->threads_count; t++)
+		for(unsigned int p = dp->threads_partitions_start[t]; p < dp->threads_partitions_end[t]; p++)
+			partition_owner[p] = t;
+
+	return partition_owner;
+}
 
 void dynamic_partitioning_release(struct dynamic_partitioning* dp)
 {
 	assert(dp != NULL);
 	dp->pe = NULL;
+	dp->threads_next_threads = NULL;
 
 	free(dp->threads_partitions_start);
 	dp->threads_partitions_start = NULL;
@@ -229,106 +480,343 @@ void dynamic_partitioning_release(struct dynamic_partitioning* dp)
 	free(dp->threads_partitions_end);
 	dp->threads_partitions_end = NULL;
 
-	free(dp->threads_partitions_remained);
-	dp->threads_partitions_remained = NULL;
-
-	free(dp->partitions_status);
-	dp->partitions_status = NULL;
+	free(dp->threads_cursors_not_aligned);
+	dp->threads_cursors_not_aligned = NULL;
+	dp->threads_cursors = NULL;
 
-	free(dp->threads_last_steal_offset);
-	dp->threads_last_steal_offset = NULL;
+	#ifdef _DP_TELEMETRY
+	{
+		for(unsigned int d = 0; d < __DP_TELEMETRY_MAX_DPS; d++)
+			if(dp_telemetry_dps[d] == dp)
+				dp_telemetry_dps[d] = NULL;
+
+		free(dp->threads_telemetry_not_aligned);
+		dp->threads_telemetry_not_aligned = NULL;
+		dp->threads_telemetry = NULL;
+		free(dp->partitions_time);
+		dp->partitions_time = NULL;
+	}
+	#endif
 
 	free(dp);
 
 	return;
 }
 
+/*
+	Starts a new epoch of processing the partitions, see __dynamic_partitioning_load_range().
+	It is called by a single thread after all threads have finished processing the partitions.
+*/
 void dynamic_partitioning_reset(struct dynamic_partitioning* dp)
 {
-	assert(dp->partitions_remained == 0);
-	dp->partitions_remained =  dp->partitions_count;
-	
-	#pragma omp parallel for
-	for(unsigned int i=0; i<dp->partitions_count; i++)
+	dp->epoch++;
+
+	return;
+}
+
+/*
+	Returns the range of `thread_id` in the current epoch. A range of an older epoch is replaced by the initial 
+	range of the thread. If the CAS fails, another thread has replaced it or a thief has stolen from the replaced range, 
+	so the new value is in the current epoch.
+*/
+static inline unsigned long __dynamic_partitioning_load_range(struct dynamic_partitioning* dp, unsigned int thread_id)
+{
+	unsigned long* cursor = dp->threads_cursors + thread_id * __DP_CURSOR_ULONGS;
+	unsigned long range = __atomic_load_n(cursor, __ATOMIC_ACQUIRE);
+	if(__DP_RANGE_EPOCH(range) != __DP_EPOCH(dp))
 	{
-		assert(dp->partitions_status[i] == 1);
-		dp->partitions_status[i] = 0;
+		unsigned long new_range = __DP_RANGE(dp->threads_partitions_start[thread_id], dp->threads_partitions_end[thread_id], __DP_EPOCH(dp));
+		if(__atomic_compare_exchange_n(cursor, &range, new_range, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			range = new_range;
 	}
 
-	for(unsigned int t=0; t<dp->threads_count; t++)
+	return range;
+}
+
+#ifdef _DP_TELEMETRY
+/*
+	Records the elapsed time of `partition` that has been claimed by `thread_id`.
+*/
+static inline void __dynamic_partitioning_telemetry_finish(struct dynamic_partitioning* dp, unsigned int thread_id, unsigned int partition)
+{
+	unsigned long* tm = dp->threads_telemetry + thread_id * __DP_TM_ULONGS;
+	unsigned long elapsed = get_nano_time() - tm[__DP_TM_CLAIM_TIME];
+	tm[__DP_TM_BUSY_TIME] += elapsed;
+	if(elapsed > tm[__DP_TM_MAX_TIME])
 	{
-		assert(dp->threads_partitions_remained[t] == 0);
-		dp->threads_partitions_remained[t] =  dp->threads_partitions_end[t] - dp->threads_partitions_start[t];
-		dp->threads_last_steal_offset[t] = 0;
+		tm[__DP_TM_MAX_TIME] = elapsed;
+		tm[__DP_TM_MAX_PARTITION] = partition;
 	}
+	dp->partitions_time[partition] = elapsed;
 
 	return;
 }
 
+/*
+	Returns the counter of stealing by `thread_id` from `victim_id` based on their distance.
+*/
+static inline unsigned int __dynamic_partitioning_telemetry_steal_counter(struct dynamic_partitioning* dp, unsigned int thread_id, unsigned int victim_id)
+{
+	struct par_env* pe = dp->pe;
+	if(pe->cpu2L3[pe->thread2cpu[thread_id]] == pe->cpu2L3[pe->thread2cpu[victim_id]])
+		return __DP_TM_STOLEN_L3;
+	if(pe->thread2node[thread_id] == pe->thread2node[victim_id])
+		return __DP_TM_STOLEN_NODE;
+
+	return __DP_TM_STOLEN_REMOTE;
+}
+#endif
 
 unsigned int dynamic_partitioning_get_next_partition(struct dynamic_partitioning* dp, unsigned int thread_id, unsigned int prev_partition)
 {
-	#define CHECK_AND_GET_PARTITION(__p, __thread_id) \
-		if(__sync_bool_compare_and_swap(&dp->partitions_status[__p], 0, 1))	\
-		{ \
-			while(1) \
-			{ \
-				unsigned int temp = __atomic_load_n(&dp->partitions_remained, __ATOMIC_SEQ_CST); \
-				if(__sync_bool_compare_and_swap(&dp->partitions_remained, temp, temp-1)) \
-					break; \
-			} \
-			while(1) \
-			{ \
-				unsigned int temp = __atomic_load_n(&dp->threads_partitions_remained[__thread_id], __ATOMIC_SEQ_CST); \
-				if(__sync_bool_compare_and_swap(&dp->threads_partitions_remained[__thread_id], temp, temp-1)) \
-					break; \
-			} \
-			return p; \
+	unsigned long* cursor = dp->threads_cursors + thread_id * __DP_CURSOR_ULONGS;
+
+	#ifdef _DP_TELEMETRY
+		if(prev_partition != -1U)
+			__dynamic_partitioning_telemetry_finish(dp, thread_id, prev_partition);
+	#endif
+
+	// (1) Claiming from the range of this thread
+		unsigned long range = __dynamic_partitioning_load_range(dp, thread_id);
+		if(__DP_RANGE_BEGIN(range) < __DP_RANGE_END(range))
+		{
+			range = __atomic_fetch_add(cursor, 1UL, __ATOMIC_ACQ_REL);
+			if(__DP_RANGE_BEGIN(range) < __DP_RANGE_END(range))
+			{
+				__DP_TM_CLAIM(dp, thread_id, __DP_TM_LOCAL);
+				return __DP_RANGE_BEGIN(range);
+			}
 		}
 
-	if( __atomic_load_n(&dp->partitions_remained, __ATOMIC_SEQ_CST) == 0)
-		return -1U;
+	// (2) Stealing half of the remaining range of a victim
+		if(prev_partition == -1U)
+			cursor[1] = 0;
 
-	unsigned int start_partition = prev_partition + 1;
-	if(prev_partition == -1U)
+		// As the stolen ranges are moved to the thieves, a victim that has been visited may have a new range.
+		// So, the stealing order is visited once more before returning -1U.
+		for(unsigned int pass = 0; pass < 2; pass++)
+		{
+			while(cursor[1] < dp->threads_count)
+			{
+				unsigned int target_thread_id = dp->threads_next_threads[thread_id][cursor[1]];
+				unsigned long* target_cursor = dp->threads_cursors + target_thread_id * __DP_CURSOR_ULONGS;
+				
+				range = __dynamic_partitioning_load_range(dp, target_thread_id);
+				while(target_thread_id != thread_id && __DP_RANGE_BEGIN(range) < __DP_RANGE_END(range))
+				{
+					unsigned int begin = __DP_RANGE_BEGIN(range);
+					unsigned int end = __DP_RANGE_END(range);
+					unsigned int stolen = (end - begin + 1) / 2;
+
+					if(__atomic_compare_exchange_n(target_cursor, &range, __DP_RANGE(begin, end - stolen, __DP_EPOCH(dp)), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+					{
+						// The range of this thread is empty and is not changed by other threads
+						__atomic_store_n(cursor, __DP_RANGE(end - stolen + 1, end, __DP_EPOCH(dp)), __ATOMIC_RELEASE);
+						__DP_TM_CLAIM(dp, thread_id, __dynamic_partitioning_telemetry_steal_counter(dp, thread_id, target_thread_id));
+						return end - stolen;
+					}
+					__DP_TM_ADD(dp, thread_id, __DP_TM_FAILED_CAS);
+				}
+
+				cursor[1]++;
+			}
+
+			if(pass == 0)
+				cursor[1] = 0;
+		}
+	
+	return -1U;
+}
+
+/*
+	Partitions cache: the borders of parallel_edge_partitioning() and the dynamic_partitioning of `partitions_count` 
+	partitions of a graph are created by the first algorithm that processes the graph with `partitions_count` partitions 
+	and are reused by the next ones, e.g., sort_neighbor_lists() and cc_thrifty() after symmetrize_graph() 
+	with the same partitions per thread.
+
+	partitions_cache_get() (partitioning.tpl.c) returns the borders and sets `*dp` that are returned to 
+	the cache by partitions_cache_put() after processing. The borders should not be modified.
+	An entry is used by one caller at a time. If it is in use (e.g., by a function that calls another function 
+	for the same graph) or the cache is disabled by `LL_PARTITIONS_CACHE=0`, new borders and dp are created and 
+	partitions_cache_put() releases them.
+
+	A graph is identified by its address, its offsets_list, |V|, and |E|. The entries of a graph are released by 
+	the release functions of the graph (using `graph_release_hook` of graph.c) and the least recently used entry 
+	is released when the cache is full.
+*/
+struct partitions_cache_entry
+{
+	struct par_env* pe;
+	void* graph;
+	void* offsets_list;
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned int partitions_count;
+	unsigned int id_bytes;      // the size of each element of `borders`
+
+	void* borders;
+	struct dynamic_partitioning* dp;
+
+	unsigned int in_use;
+	unsigned long last_use;
+};
+
+#define LL_PARTITIONS_CACHE_SIZE 32
+struct partitions_cache_entry partitions_cache[LL_PARTITIONS_CACHE_SIZE];
+unsigned long partitions_cache_clock = 0;
+unsigned long partitions_cache_hits = 0;
+unsigned long partitions_cache_misses = 0;
+
+void __partitions_cache_release_entry(struct partitions_cache_entry* e)
+{
+	assert(e->in_use == 0);
+
+	if(e->borders != NULL)
 	{
-		start_partition = dp->threads_partitions_start[thread_id];
-		dp->threads_last_steal_offset[thread_id] = 0;
+		free(e->borders);
+		e->borders = NULL;
 	}
-
-	while(dp->threads_last_steal_offset[thread_id] < dp->threads_count)
+	if(e->dp != NULL)
 	{
-		unsigned int target_thread_id = dp->pe->threads_next_threads[thread_id][dp->threads_last_steal_offset[thread_id]];
+		dynamic_partitioning_release(e->dp);
+		e->dp = NULL;
+	}
+	e->graph = NULL;
+	e->offsets_list = NULL;
+	e->pe = NULL;
 
-		if( __atomic_load_n(&dp->threads_partitions_remained[target_thread_id], __ATOMIC_SEQ_CST) == 0)
-		{
-			dp->threads_last_steal_offset[thread_id]++;
-			continue;
-		}
+	return;
+}
 
-		if(target_thread_id == thread_id)
+/*
+	Releases the entries of graph `g`, called by the release functions of graphs.
+*/
+void partitions_cache_release_graph(void* g)
+{
+	for(unsigned int c = 0; c < LL_PARTITIONS_CACHE_SIZE; c++)
+		if(partitions_cache[c].graph == g)
+			__partitions_cache_release_entry(&partitions_cache[c]);
+
+	return;
+}
+
+/*
+	Returns the entry of the graph for `partitions_count` and marks it as in use. For a new entry,
+	`borders` is NULL and the caller creates the borders and the dp. Returns NULL if the entry is in use 
+	or the cache is disabled.
+*/
+struct partitions_cache_entry* __partitions_cache_acquire(struct par_env* pe, void* g, void* offsets_list, 
+	unsigned long vertices_count, unsigned long edges_count, unsigned int partitions_count, unsigned int id_bytes)
+{
+	if(!LL_PARTITIONS_CACHE)
+		return NULL;
+
+	graph_release_hook = partitions_cache_release_graph;
+	partitions_cache_clock++;
+
+	// (1) Searching
+		struct partitions_cache_entry* lru = NULL;
+		for(unsigned int c = 0; c < LL_PARTITIONS_CACHE_SIZE; c++)
 		{
-			// We are processing our partitions therefore go in the ascending order
-			for(unsigned int p=start_partition; p<dp->threads_partitions_end[target_thread_id]; p++)
-				CHECK_AND_GET_PARTITION(p, target_thread_id);
+			struct partitions_cache_entry* e = &partitions_cache[c];
+			if(e->graph == g && e->offsets_list == offsets_list && e->vertices_count == vertices_count && e->edges_count == edges_count
+				&& e->pe == pe && e->partitions_count == partitions_count && e->id_bytes == id_bytes)
+			{
+				if(e->in_use)
+					return NULL;
+
+				// The previous processing has finished and the steal order may have been changed by the previous algorithm
+				dynamic_partitioning_reset(e->dp);
+				dynamic_partitioning_set_steal_order(e->dp, LL_STEAL_ORDER_NUMA);
+				e->in_use = 1;
+				e->last_use = partitions_cache_clock;
+				partitions_cache_hits++;
+
+				return e;
+			}
+
+			if(e->in_use)
+				continue;
+			if(lru == NULL || (lru->graph != NULL && (e->graph == NULL || e->last_use < lru->last_use)))
+				lru = e;
 		}
-		else
-		{
-			start_partition = prev_partition - 1;
-			// We are processing partitions of other threads, so we start from the last partition of each victim thread
-			// To prevent interrupting normal order of the victim
 
-			if(start_partition >= dp->threads_partitions_end[target_thread_id] || start_partition < dp->threads_partitions_start[target_thread_id])
-				start_partition = dp->threads_partitions_end[target_thread_id] - 1;
+	// (2) Replacing the least recently used entry
+		if(lru == NULL)
+			return NULL;
+		if(lru->graph != NULL)
+			__partitions_cache_release_entry(lru);
+
+		lru->pe = pe;
+		lru->graph = g;
+		lru->offsets_list = offsets_list;
+		lru->vertices_count = vertices_count;
+		lru->edges_count = edges_count;
+		lru->partitions_count = partitions_count;
+		lru->id_bytes = id_bytes;
+		lru->in_use = 1;
+		lru->last_use = partitions_cache_clock;
+		partitions_cache_misses++;
+
+	return lru;
+}
+
+/*
+	Returns `borders` and `dp` of partitions_cache_get() to the cache, or releases them if they are not cached.
+*/
+void partitions_cache_put(void* borders, struct dynamic_partitioning* dp)
+{
+	assert(borders != NULL && dp != NULL);
+
+	for(unsigned int c = 0; c < LL_PARTITIONS_CACHE_SIZE; c++)
+		if(partitions_cache[c].in_use && partitions_cache[c].borders == borders)
+		{
+			assert(partitions_cache[c].dp == dp);
+			partitions_cache[c].in_use = 0;
 
-			for(unsigned int p=start_partition; p>=dp->threads_partitions_start[target_thread_id] && p != -1U; p--)
-				CHECK_AND_GET_PARTITION(p, target_thread_id);
+			return;
 		}
 
-		dp->threads_last_steal_offset[thread_id]++;
-	}	
-	
-	return -1U;
+	free(borders);
+	borders = NULL;
+	dynamic_partitioning_release(dp);
+	dp = NULL;
+
+	return;
 }
 
+#define LL_IDW 4
+#include "partitioning.tpl.c"
+#undef LL_IDW
+#define LL_IDW 8
+#include "partitioning.tpl.c"
+#undef LL_IDW
+#define LL_IDW 4
+#define LL_OFW 4
+#include "partitioning.tpl.c"
+#undef LL_OFW
+#undef LL_IDW
+
+/*
+	Selects the specialisation of parallel_edge_partitioning() by the type of the graph at compile time,
+	e.g., parallel_edge_partitioning_c32() for a `struct ll_400_c32_graph*`.
+	Other graph types (cast to `struct ll_400_graph*` by the callers) use the 4 Bytes version.
+*/
+#define parallel_edge_partitioning(__g, ...) \
+	_Generic((__g), \
+		struct ll_800_graph*: parallel_edge_partitioning_800, \
+		struct ll_400_c32_graph*: parallel_edge_partitioning_c32, \
+		default: parallel_edge_partitioning \
+	)(__g, __VA_ARGS__)
+
+/*
+	Selects the specialisation of partitions_cache_get() by the type of the graph, similar to parallel_edge_partitioning().
+*/
+#define partitions_cache_get(__pe, __g, ...) \
+	_Generic((__g), \
+		struct ll_800_graph*: partitions_cache_get_800, \
+		struct ll_400_c32_graph*: partitions_cache_get_c32, \
+		default: partitions_cache_get \
+	)(__pe, __g, __VA_ARGS__)
+
 #endif 
\ No newline at end of file
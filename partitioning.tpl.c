@@ -0,0 +1,338 @@
+// Edge partitioning specialised for the width of vertex IDs, included by partitioning.c (see id_width.c)
+
+#include "id_width.c"
+
+int IDW_FN(parallel_edge_partitioning, parallel_edge_partitioning_800)(IDW_GRAPH* g, IDW_T* borders, int partitions)
+{
+	assert(partitions > 0 && g->vertices_count > 0);
+
+	borders[0] = 0;
+	borders[partitions] = g->vertices_count;
+
+	if(g->vertices_count <= 4 * partitions)
+	{
+		IDW_T remained_vertices = g->vertices_count;
+		unsigned int remained_partitions = partitions;
+		for(int i=1;i<partitions;i++)
+		{
+			if(remained_vertices > 0)
+			{
+				IDW_T q = max(1,remained_vertices/remained_partitions);
+				borders[i] = borders[i-1] + q;
+				remained_vertices -= q;
+			}
+			else
+				borders[i] = g->vertices_count;
+
+			//printf("%d %d %d\n",i,borders[i], remained_vertices);
+			remained_partitions--;
+		}
+	}
+	else
+	{
+		unsigned long edges_per_thread = (g->edges_count + g->vertices_count) / partitions;
+		
+		#pragma omp parallel for
+		for(unsigned int t = 1; t < partitions; t++)
+		{
+			unsigned long start = 0;
+			unsigned long end = g->vertices_count;
+			unsigned long target = t * edges_per_thread;
+			unsigned long m = (start + end)/2;
+			while(1)
+			{
+				unsigned long m_val = g->offsets_list[m] + m;
+				if( m_val == target )
+					break;
+
+				unsigned long b_val = g->offsets_list[m - 1] + m - 1;
+				if( b_val < target && m_val > target )
+					break;
+
+				if(m_val > target)
+					end = m;
+				if(m_val < target)
+					start = m;
+
+				unsigned long new_m = (start + end)/2;
+				if(new_m == m)
+					break;
+				m = new_m;
+			}
+			assert( m <= g->vertices_count );
+			
+			borders[t] = m;
+		}	
+
+		IDW_T last_m = 0;
+		for(unsigned int t = 1; t < partitions; t++)
+		{
+			if(borders[t] <= last_m)
+				borders[t] = last_m + 1;
+			if(borders[t] > g->vertices_count)
+				borders[t] = g->vertices_count;
+			
+			last_m = borders[t];
+		}
+	}
+
+	//verify_serial_edge_partitioning(g, borders, partitions);
+
+	return 0;
+}
+
+/*
+	Edge tiling: divides the vertices and edges of `g` to `tiles_count` tiles with almost equal |edges| + |vertices|.
+	Unlike parallel_edge_partitioning(), a vertex with more edges than a tile (a hub) is split across multiple tiles.
+
+	Tile `t` starts from the edge `tiles_edges[t]` of vertex `tiles_vertices[t]`, i.e., 
+	offsets_list[tiles_vertices[t]] <= tiles_edges[t] <= offsets_list[tiles_vertices[t] + 1], and 
+	`tiles_vertices[tiles_count] = |V|` and `tiles_edges[tiles_count] = |E|`. 
+	A tile processes the (vertex, edge_start, edge_end) triples of its vertices as in the following: 
+
+		for(IDW_T v = tiles_vertices[t]; v <= tiles_vertices[t + 1] && v < g->vertices_count; v++)
+		{
+			unsigned long e_start = v == tiles_vertices[t] ? tiles_edges[t] : g->offsets_list[v];
+			unsigned long e_end = v == tiles_vertices[t + 1] ? tiles_edges[t + 1] : g->offsets_list[v + 1];
+			if(v == tiles_vertices[t + 1] && e_end == g->offsets_list[v])
+				break;
+			int split = e_start != g->offsets_list[v] || e_end != g->offsets_list[v + 1];
+			...
+		}
+
+	The results of a split vertex (`split == 1`) are partial and should be combined with the results of other tiles, 
+	e.g., by edge_tiles_reduce_min() and edge_tiles_reduce_add().
+	Tiles should be processed by the same number of partitions in dynamic_partitioning_initialize().
+*/
+int IDW_FN(parallel_edge_tiling, parallel_edge_tiling_800)(IDW_GRAPH* g, IDW_T* tiles_vertices, unsigned long* tiles_edges, unsigned int tiles_count)
+{
+	assert(g != NULL && tiles_vertices != NULL && tiles_edges != NULL && tiles_count > 0 && g->vertices_count > 0);
+
+	tiles_vertices[0] = 0;
+	tiles_edges[0] = 0;
+	tiles_vertices[tiles_count] = g->vertices_count;
+	tiles_edges[tiles_count] = g->edges_count;
+
+	unsigned long total_work = g->edges_count + g->vertices_count;
+	unsigned long tile_size = total_work / tiles_count;
+
+	#pragma omp parallel for
+	for(unsigned int t = 1; t < tiles_count; t++)
+	{
+		// Finding the vertex `m` with offsets_list[m] + m <= target < offsets_list[m + 1] + m + 1
+		unsigned long target = t * total_work / tiles_count;
+		unsigned long start = 0;
+		unsigned long end = g->vertices_count;
+		while(end - start > 1)
+		{
+			unsigned long m = (start + end) / 2;
+			if(g->offsets_list[m] + m <= target)
+				start = m;
+			else
+				end = m;
+		}
+		unsigned long m = start;
+		unsigned long degree = g->offsets_list[m + 1] - g->offsets_list[m];
+
+		tiles_vertices[t] = m;
+		tiles_edges[t] = g->offsets_list[m];
+		if(degree > 0 && degree >= tile_size)
+		{
+			// A hub, cut at the target edge, and a cut at the end of the hub is moved to the start of the next vertex
+			tiles_edges[t] += min(degree, target - g->offsets_list[m] - m);
+			if(tiles_edges[t] == g->offsets_list[m + 1])
+				tiles_vertices[t] = m + 1;
+		}
+	}
+
+	// The tiles of consecutive targets with the same non-hub vertex are empty
+	for(unsigned int t = 1; t < tiles_count; t++)
+	{
+		assert(tiles_vertices[t] >= tiles_vertices[t - 1]);
+		if(tiles_vertices[t] == tiles_vertices[t - 1])
+			assert(tiles_edges[t] >= tiles_edges[t - 1]);
+	}
+
+	return 0;
+}
+
+/*
+	Reduces the partial minimum `val` of a split vertex `v` of edge tiles into `vals[v]`.
+	Returns 1 if `vals[v]` has been reduced.
+*/
+int IDW_FN(edge_tiles_reduce_min, edge_tiles_reduce_min_800)(IDW_T* vals, IDW_T v, IDW_T val)
+{
+	IDW_T prev_val = __atomic_load_n(&vals[v], __ATOMIC_RELAXED);
+	while(val < prev_val)
+		if(__atomic_compare_exchange_n(&vals[v], &prev_val, val, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return 1;
+
+	return 0;
+}
+
+/*
+	Creates the partitions plan of `algorithm` for `g` (see partitions_plan_decide() in partitioning.c). 
+	`algorithm` should be a string literal. The plan should be released by partitions_plan_release().
+*/
+struct partitions_plan* IDW_FN(partitions_plan_create, partitions_plan_create_800)(struct par_env* pe, IDW_GRAPH* g, char* algorithm, unsigned int default_thread_partitions)
+{
+	assert(pe != NULL && g != NULL && algorithm != NULL && default_thread_partitions > 0);
+
+	struct partitions_plan* pp = calloc(sizeof(struct partitions_plan), 1);
+	assert(pp != NULL);
+	pp->algorithm = algorithm;
+	pp->vertices_count = g->vertices_count;
+	pp->edges_count = g->edges_count;
+	pp->default_thread_partitions = default_thread_partitions;
+
+	// Degree statistics
+	if(LL_PARTITIONS_PLANNER && g->vertices_count > 0)
+	{
+		unsigned long max_degree = 0;
+		double sum_squares = 0;
+		#pragma omp parallel for reduction(max:max_degree) reduction(+:sum_squares)
+		for(IDW_T v = 0; v < g->vertices_count; v++)
+		{
+			unsigned long degree = g->offsets_list[v + 1] - g->offsets_list[v];
+			if(degree > max_degree)
+				max_degree = degree;
+			sum_squares += 1.0 * degree * degree;
+		}
+
+		double avg = 1.0 * g->edges_count / g->vertices_count;
+		pp->max_degree = max_degree;
+		if(avg > 0)
+			pp->degree_cv = sqrt(max(0.0, sum_squares / g->vertices_count - avg * avg)) / avg;
+	}
+
+	partitions_plan_decide(pe, pp);
+
+	return pp;
+}
+
+/*
+	Returns the borders of `partitions_count` partitions of `g` by parallel_edge_partitioning() and sets `*dp` 
+	to a dynamic_partitioning of `partitions_count` partitions with the default steal order, from the partitions 
+	cache (see partitions_cache_put() in partitioning.c). They should be returned by partitions_cache_put().
+*/
+IDW_T* IDW_FN(partitions_cache_get, partitions_cache_get_800)(struct par_env* pe, IDW_GRAPH* g, unsigned int partitions_count, struct dynamic_partitioning** dp)
+{
+	assert(pe != NULL && g != NULL && dp != NULL);
+
+	struct partitions_cache_entry* e = __partitions_cache_acquire(pe, g, g->offsets_list, g->vertices_count, g->edges_count, partitions_count, sizeof(IDW_T));
+	if(e != NULL && e->borders != NULL)
+	{
+		*dp = e->dp;
+		return (IDW_T*)e->borders;
+	}
+
+	IDW_T* borders = calloc(sizeof(IDW_T), partitions_count + 1);
+	assert(borders != NULL);
+	IDW_FN(parallel_edge_partitioning, parallel_edge_partitioning_800)(g, borders, partitions_count);
+	*dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	if(e != NULL)
+	{
+		e->borders = borders;
+		e->dp = *dp;
+	}
+
+	return borders;
+}
+
+/*
+	Binds the pages of `mem`, an array of `elem_size` Bytes elements, to the NUMA nodes of the threads
+	that own the partitions. `partition_owner[p]` is the thread of partition `p` (see
+	dynamic_partitioning_get_partition_owners()) and the elements of partition `p` are 
+	[partitions[p], partitions[p + 1]) for a vertex-indexed array (`offsets_list == NULL`), or
+	[offsets_list[partitions[p]], offsets_list[partitions[p + 1]]) for an edge-indexed array.
+
+	Consecutive partitions of the same node are bound together and a page that is shared by two
+	partitions goes to the node of the partition containing its first byte.
+	Returns 0 on success.
+*/
+int IDW_FN(numa_place_partitioned_array, numa_place_partitioned_array_800)(struct par_env* pe, void* mem, unsigned long elem_size, IDW_OFF_T* offsets_list, IDW_T* partitions, unsigned int partitions_count, unsigned int* partition_owner)
+{
+	assert(pe != NULL && mem != NULL && partitions != NULL && partition_owner != NULL && partitions_count > 0);
+
+	int ret = 0;
+	unsigned long segment_start = 0;
+	unsigned int segment_node = pe->thread2node[partition_owner[0]];
+	for(unsigned int p = 1; p <= partitions_count; p++)
+	{
+		unsigned int node = -1U;
+		if(p < partitions_count)
+			node = pe->thread2node[partition_owner[p]];
+		if(node == segment_node)
+			continue;
+
+		unsigned long border = partitions[p];
+		if(offsets_list != NULL)
+			border = offsets_list[border];
+		border *= elem_size;
+		if(p < partitions_count)
+			border &= ~4095UL;
+		else
+			border = (border + 4095UL) & ~4095UL;
+
+		if(border > segment_start)
+		{
+			ret |= numa_bind_memory_range((char*)mem + segment_start, border - segment_start, segment_node);
+			segment_start = border;
+		}
+		segment_node = node;
+	}
+
+	return ret;
+}
+
+/*
+	Places `offsets_list` and `edges_list` of `g` based on the `policy` (LL_NUMA_INTERLEAVE, LL_NUMA_OWNER_LOCAL or 
+	LL_NUMA_HYBRID, see omp.c). The graph is partitioned by `partitions` and `partition_owner[p]` is 
+	the thread that processes partition `p`.
+	For LL_NUMA_INTERLEAVE, the arrays are not touched as they have been allocated interleaved.
+
+	The pages of the graph of the caller are migrated and remain bound after the call, so the caller should 
+	call numa_restore_graph() before the graph is processed by other algorithms.
+*/
+int IDW_FN(numa_place_graph, numa_place_graph_800)(struct par_env* pe, unsigned int policy, IDW_GRAPH* g, IDW_T* partitions, unsigned int partitions_count, unsigned int* partition_owner)
+{
+	assert(policy <= LL_NUMA_HYBRID);
+	if(policy == LL_NUMA_INTERLEAVE)
+		return 0;
+
+	int ret = IDW_FN(numa_place_partitioned_array, numa_place_partitioned_array_800)(pe, g->offsets_list, sizeof(IDW_OFF_T), NULL, partitions, partitions_count, partition_owner);
+	if(g->edges_count)
+		ret |= IDW_FN(numa_place_partitioned_array, numa_place_partitioned_array_800)(pe, g->edges_list, sizeof(IDW_T), g->offsets_list, partitions, partitions_count, partition_owner);
+
+	return ret;
+}
+
+/*
+	Restores the interleaved placement of `offsets_list` and `edges_list` of `g` after numa_place_graph() with `policy`.
+*/
+int IDW_FN(numa_restore_graph, numa_restore_graph_800)(unsigned int policy, IDW_GRAPH* g)
+{
+	assert(policy <= LL_NUMA_HYBRID);
+	if(policy == LL_NUMA_INTERLEAVE)
+		return 0;
+
+	int ret = numa_interleave_memory_range(g->offsets_list, sizeof(IDW_OFF_T) * (g->vertices_count + 1));
+	ret |= numa_interleave_memory_range(g->edges_list, sizeof(IDW_T) * g->edges_count);
+
+	return ret;
+}
+
+/*
+	Places a vertex-indexed array based on the `policy`. Only LL_NUMA_OWNER_LOCAL binds the array to 
+	the owner nodes. For LL_NUMA_HYBRID, the array remains interleaved since vertex arrays are 
+	mostly accessed through neighbours of the owned vertices.
+*/
+int IDW_FN(numa_place_vertex_array, numa_place_vertex_array_800)(struct par_env* pe, unsigned int policy, void* mem, unsigned long elem_size, IDW_T* partitions, unsigned int partitions_count, unsigned int* partition_owner)
+{
+	assert(policy <= LL_NUMA_HYBRID);
+	if(policy != LL_NUMA_OWNER_LOCAL)
+		return 0;
+
+	return IDW_FN(numa_place_partitioned_array, numa_place_partitioned_array_800)(pe, mem, elem_size, NULL, partitions, partitions_count, partition_owner);
+}
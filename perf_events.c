@@ -0,0 +1,174 @@
+#ifndef __PERF_EVENTS_C
+#define __PERF_EVENTS_C
+
+#include <linux/perf_event.h>
+
+/*
+	perf_event_open() backend of hw events, used when PAPI is not available (built without `_PAPI_SUPPORT`)
+	or when `LL_HW_EVENTS_BACKEND` is `perf`.
+
+	Each thread opens the events of `perf_events[]` as a group that counts the user-space events of the thread.
+	The first opened event is the group leader, so the events of a thread are read together by a single read()
+	of the leader (PERF_FORMAT_GROUP) and are reset by a single ioctl(). The events that cannot be opened
+	(e.g., not supported by the CPU) are skipped. If `/proc/sys/kernel/perf_event_paranoid` is larger than 2,
+	no events can be opened.
+
+	The names of events are the names of their PAPI presets (without the "PAPI_" prefix), so the reports
+	of both backends have the same columns.
+
+	The `papi_args` of a thread (see papi_start() in omp.c) is `(events_count << 32) + group` and papi_read(),
+	papi_reset(), and papi_stop() call the perf_events_*() functions for this backend.
+*/
+
+struct perf_event_desc
+{
+	char* name;
+	unsigned int type;
+	unsigned long config;
+};
+
+#define __PERF_HW_CACHE(cache, op, result) ((cache) | ((op) << 8) | ((result) << 16))
+
+struct perf_event_desc perf_events[] = {
+	{"TOT_INS", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{"TLB_DM",  PERF_TYPE_HW_CACHE, __PERF_HW_CACHE(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"TOT_CYC", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{"L3_TCM",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+	{"LD_INS",  PERF_TYPE_HW_CACHE, __PERF_HW_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"SR_INS",  PERF_TYPE_HW_CACHE, __PERF_HW_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_WRITE, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	// {"BR_MSP",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+	// {"BR_INS",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+};
+
+struct perf_events_group
+{
+	unsigned int events_count;
+	int fds[32];
+	unsigned int events[32];  // indexes in perf_events[]
+};
+
+struct perf_events_group* perf_groups = NULL;
+unsigned int perf_groups_count = 0;
+
+void perf_events_init(unsigned int groups_count)
+{
+	assert(sizeof(perf_events)/sizeof(perf_events[0]) <= 32);
+
+	perf_groups = calloc(sizeof(struct perf_events_group), groups_count);
+	assert(perf_groups != NULL);
+	perf_groups_count = groups_count;
+
+	char paranoid[16] = {0};
+	if(get_file_contents("/proc/sys/kernel/perf_event_paranoid", paranoid, sizeof(paranoid) - 1) > 0)
+		printf("perf_event_paranoid: %d\n", atoi(paranoid));
+
+	return;
+}
+
+/*
+	Opens the events of the calling thread as `group` and starts counting.
+	Returns the papi_args of the thread, 0 if no events can be opened.
+*/
+unsigned long perf_events_start(unsigned int group)
+{
+	assert(group < perf_groups_count);
+	struct perf_events_group* g = &perf_groups[group];
+	g->events_count = 0;
+
+	for(unsigned int e = 0; e < sizeof(perf_events)/sizeof(perf_events[0]); e++)
+	{
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = perf_events[e].type;
+		attr.config = perf_events[e].config;
+		attr.disabled = g->events_count == 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP;
+
+		// The calling thread on any CPU
+		int fd = syscall(SYS_perf_event_open, &attr, 0, -1, g->events_count ? g->fds[0] : -1, 0);
+		if(fd < 0)
+		{
+			if(group == 0)
+				printf("perf_event_open() error for index %u, event %s, %d: %s\n", e, perf_events[e].name, errno, strerror(errno));
+			continue;
+		}
+
+		if(group == 0)
+			printf("perf_event_open() index: %u, events_count %u, %s, added.\n", e, g->events_count, perf_events[e].name);
+		g->fds[g->events_count] = fd;
+		g->events[g->events_count] = e;
+		g->events_count++;
+	}
+
+	if(g->events_count == 0)
+		return 0UL;
+
+	if(ioctl(g->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) || ioctl(g->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP))
+	{
+		printf("perf_event_open() can't start, %d: %s\n", errno, strerror(errno));
+		exit(-1);
+	}
+
+	return ((unsigned long)g->events_count << 32) + group;
+}
+
+void perf_events_reset(unsigned long papi_arg)
+{
+	struct perf_events_group* g = &perf_groups[(unsigned int)papi_arg];
+	int ret = ioctl(g->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	assert(ret == 0);
+
+	return;
+}
+
+void perf_events_stop(unsigned long papi_arg)
+{
+	struct perf_events_group* g = &perf_groups[(unsigned int)papi_arg];
+	if(ioctl(g->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP))
+		printf("perf_event_open() can't stop, %d: %s\n", errno, strerror(errno));
+
+	// Members are closed before the leader
+	for(int e = g->events_count - 1; e >= 0; e--)
+	{
+		close(g->fds[e]);
+		g->fds[e] = -1;
+	}
+	g->events_count = 0;
+
+	return;
+}
+
+int perf_events_read(unsigned long papi_arg, unsigned long* in_values)
+{
+	struct perf_events_group* g = &perf_groups[(unsigned int)papi_arg];
+
+	// PERF_FORMAT_GROUP: the number of events followed by the values
+	unsigned long temp_values[1 + 32];
+	long size = sizeof(unsigned long) * (1 + g->events_count);
+	long ret = read(g->fds[0], temp_values, size);
+	if(ret != size || temp_values[0] != g->events_count)
+	{
+		printf("perf_event_open() can't read, %d: %s\n", errno, strerror(errno));
+		return -1;
+	}
+
+	for(unsigned int i = 0; i < g->events_count; i++)
+		in_values[i] = temp_values[1 + i];
+
+	return 0;
+}
+
+// Writes the names of events of `papi_arg` to `names`
+void perf_events_names(unsigned long papi_arg, char names[][PAPI_MAX_STR_LEN])
+{
+	struct perf_events_group* g = &perf_groups[(unsigned int)papi_arg];
+	for(unsigned int i = 0; i < g->events_count; i++)
+		sprintf(names[i], "%s", perf_events[g->events[i]].name);
+
+	return;
+}
+
+#endif
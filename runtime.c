@@ -0,0 +1,212 @@
+#ifndef __RUNTIME_C
+#define __RUNTIME_C
+
+/*
+	Persistent worker runtime
+
+	An algorithm that executes a sequence of short steps (e.g., the later iterations of thrifty or mastiff
+	that process a few vertices) pays for a fork/join of an OpenMP parallel region and a serial part
+	in each step. With the runtime, the OpenMP threads of a single parallel region are used as persistent
+	workers for all steps and the steps are separated by phase barriers:
+
+		#pragma omp parallel
+		{
+			unsigned int tid = omp_get_thread_num();
+			do
+			{
+				// parallel part of the step
+				...
+				if(par_runtime_barrier(rt))
+				{
+					// serial part of the step, executed by the last arriving thread,
+					// e.g., dynamic_partitioning_reset(), printing the step and updating the loop condition
+					...
+					par_runtime_barrier_release(rt);
+				}
+			}while(...);
+		}
+
+	The threads that are not the last to arrive at the barrier wait until par_runtime_barrier_release()
+	is called by the last thread, so the serial part is visible to all threads in the next phase.
+
+	Waiting threads spin `spin_count` times (by _mm_pause()) and then park on a futex. The spin count
+	is set by the `LL_RUNTIME_SPINS` env var: 0 parks immediately and -1 (i.e., -1U) never parks.
+
+	If there are more threads than available CPUs, a spinning thread takes the CPU of a thread that has
+	not arrived, so the waiting threads yield the CPU (sched_yield()) in each spin and the spin count is 
+	limited to __RT_OVERSUBSCRIBED_SPINS (unless it is -1U).
+
+	The runtime is bound to `pe` and is created by the first call to par_runtime_get().
+*/
+
+struct par_runtime
+{
+	struct par_env* pe;
+	unsigned int threads_count;
+	unsigned int spin_count;
+	unsigned int oversubscribed;  // 1 if threads_count > available CPUs
+
+	// [0]: arrived threads, [16]: epoch (the futex word), [32]: parked threads, in separate cachelines
+	unsigned int* barrier;
+	unsigned int* barrier_not_aligned;
+
+	// The time of the last release, to measure the wake-up latency of waiting threads
+	unsigned long release_time;
+
+	// Stats
+	unsigned long phases_count;
+	unsigned long parks_count;
+	unsigned long serial_time;
+	unsigned long wake_time;
+	unsigned long wakes_count;
+};
+
+#define __RT_ARRIVED(__rt) (&(__rt)->barrier[0])
+#define __RT_EPOCH(__rt) (&(__rt)->barrier[16])
+#define __RT_PARKED(__rt) (&(__rt)->barrier[32])
+#define __RT_OVERSUBSCRIBED_SPINS 16U
+
+struct par_runtime* par_runtime_initialize(struct par_env* pe, unsigned int spin_count)
+{
+	assert(pe != NULL);
+
+	struct par_runtime* rt = calloc(sizeof(struct par_runtime), 1);
+	assert(rt != NULL);
+	rt->pe = pe;
+	rt->threads_count = pe->threads_count;
+	rt->spin_count = spin_count;
+	if(pe->threads_count > pe->available_cpus_count)
+	{
+		rt->oversubscribed = 1;
+		if(rt->spin_count != -1U)
+			rt->spin_count = min(rt->spin_count, __RT_OVERSUBSCRIBED_SPINS);
+		printf("Runtime: %u threads on %u CPUs, waiting threads yield the CPU and spin %d times.\n", 
+			pe->threads_count, pe->available_cpus_count, (int)rt->spin_count);
+	}
+
+	rt->barrier = calloc(16 * 4, sizeof(unsigned int));
+	assert(rt->barrier != NULL);
+	rt->barrier_not_aligned = rt->barrier;
+	// 64 Bytes alignment
+	if((unsigned long)rt->barrier % 64 != 0)
+	{
+		unsigned long addr = (unsigned long)rt->barrier;
+		rt->barrier = (unsigned int*)(addr + 64 - addr % 64);
+	}
+
+	return rt;
+}
+
+void par_runtime_release(struct par_runtime* rt)
+{
+	assert(rt != NULL);
+	rt->pe = NULL;
+	free(rt->barrier_not_aligned);
+	rt->barrier_not_aligned = NULL;
+	rt->barrier = NULL;
+	free(rt);
+
+	return;
+}
+
+/*
+	Returns the runtime of `pe` and creates it on the first call.
+	It should be called outside parallel regions.
+*/
+struct par_runtime* par_runtime_get(struct par_env* pe)
+{
+	assert(pe != NULL);
+	if(pe->runtime == NULL)
+		pe->runtime = par_runtime_initialize(pe, LL_RUNTIME_SPINS);
+
+	return pe->runtime;
+}
+
+void par_runtime_reset_stats(struct par_runtime* rt)
+{
+	rt->phases_count = 0;
+	rt->parks_count = 0;
+	rt->serial_time = 0;
+	rt->wake_time = 0;
+	rt->wakes_count = 0;
+
+	return;
+}
+
+/*
+	The phase barrier. Returns 1 to the last arriving thread that should execute the serial part and then call
+	par_runtime_barrier_release(), and returns 0 to other threads after the release.
+*/
+int par_runtime_barrier(struct par_runtime* rt)
+{
+	// The per-step hw events of this thread should be read before arriving, see step_hw_events_collect() in omp.c
+	if(rt->pe->step_hw_values != NULL)
+		thread_step_hw_events_read(rt->pe);
+
+	// The epoch should be read before arriving, as the last thread may release the barrier immediately after that
+	unsigned int epoch = __atomic_load_n(__RT_EPOCH(rt), __ATOMIC_ACQUIRE);
+	if(__atomic_add_fetch(__RT_ARRIVED(rt), 1U, __ATOMIC_ACQ_REL) == rt->threads_count)
+	{
+		__atomic_store_n(__RT_ARRIVED(rt), 0U, __ATOMIC_RELAXED);
+		rt->phases_count++;
+		rt->serial_time -= get_nano_time();
+
+		return 1;
+	}
+
+	// (1) Spinning
+		unsigned int s = 0;
+		for(; s < rt->spin_count; s++)
+		{
+			if(__atomic_load_n(__RT_EPOCH(rt), __ATOMIC_ACQUIRE) != epoch)
+				break;
+			if(rt->oversubscribed)
+				sched_yield();
+			else
+				_mm_pause();
+		}
+
+	// (2) Parking
+		if(s == rt->spin_count)
+		{
+			// SEQ_CST orders the increment of `parked` before reading the epoch, see par_runtime_barrier_release()
+			__atomic_add_fetch(__RT_PARKED(rt), 1U, __ATOMIC_SEQ_CST);
+			while(__atomic_load_n(__RT_EPOCH(rt), __ATOMIC_SEQ_CST) == epoch)
+				syscall(SYS_futex, __RT_EPOCH(rt), FUTEX_WAIT_PRIVATE, epoch, NULL, NULL, 0);
+			__atomic_sub_fetch(__RT_PARKED(rt), 1U, __ATOMIC_RELAXED);
+			__atomic_add_fetch(&rt->parks_count, 1UL, __ATOMIC_RELAXED);
+		}
+
+	__atomic_add_fetch(&rt->wake_time, get_nano_time() - rt->release_time, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&rt->wakes_count, 1UL, __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+/*
+	Releases the threads waiting in the barrier, called by the thread that par_runtime_barrier() has returned 1 to.
+*/
+void par_runtime_barrier_release(struct par_runtime* rt)
+{
+	rt->release_time = get_nano_time();
+	rt->serial_time += rt->release_time;
+
+	// A thread that increments `parked` after reading it here, reads the new epoch and does not sleep
+	__atomic_add_fetch(__RT_EPOCH(rt), 1U, __ATOMIC_SEQ_CST);
+	if(__atomic_load_n(__RT_PARKED(rt), __ATOMIC_SEQ_CST))
+		syscall(SYS_futex, __RT_EPOCH(rt), FUTEX_WAKE_PRIVATE, rt->threads_count, NULL, NULL, 0);
+
+	return;
+}
+
+void par_runtime_print_stats(struct par_runtime* rt)
+{
+	printf("Runtime phases: %'lu, parks: %'lu, avg. serial time: %'.2f (us), avg. wake-up latency: %'.2f (us)\n",
+		rt->phases_count, rt->parks_count, rt->phases_count ? rt->serial_time / 1e3 / rt->phases_count : 0.0,
+		rt->wakes_count ? rt->wake_time / 1e3 / rt->wakes_count : 0.0
+	);
+
+	return;
+}
+
+#endif
@@ -0,0 +1,519 @@
+#ifndef __STREAM_C
+#define __STREAM_C
+
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "paragrapher.h"
+#include "omp.c"
+#include "graph.c"
+
+/*
+	Processing the edge blocks of a WebGraph while it is being decompressed
+
+	`stream_ll_400_webgraph()` passes each edge block that ParaGrapher decompresses to a list of consumers,
+	concurrently with the decompression of the next blocks. So, the total time of loading and processing
+	approaches max(load, compute) rather than load + compute.
+
+	A consumer has three functions:
+		init():      called once by the main thread before reading the edges, with |V|, |E|, and the offsets_list
+		block():     called concurrently by the ParaGrapher threads for each edge block, so it should be thread-safe
+		finalize():  called once by the main thread after all blocks have been consumed, it may use OpenMP
+
+	Consumers (e.g., `struct ll_stream_degrees` and `struct ll_stream_cc`) have `struct ll_stream_consumer` as their
+	first member which is passed to `stream_ll_400_webgraph()` and to the consumer functions.
+*/
+
+struct ll_edge_block
+{
+	unsigned long start_vertex;    // source of the first edge of the block
+	unsigned long start_edge;      // index of the first edge of the block in the edges list of the graph
+	unsigned long edges_count;
+	unsigned long* offsets_list;   // offsets_list of the whole graph
+	unsigned long* edges;          // `edges[i]` is the destination of edge `start_edge + i`
+};
+
+struct ll_stream_consumer
+{
+	void (*init)(struct ll_stream_consumer* sc, unsigned long vertices_count, unsigned long edges_count, unsigned long* offsets_list);
+	void (*block)(struct ll_stream_consumer* sc, struct ll_edge_block* eb);
+	void (*finalize)(struct ll_stream_consumer* sc);
+};
+
+void __ll_400_stream_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+{
+	void** args = (void**) in_args;
+	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
+	unsigned int* graph_edges = (unsigned int*)args[1];
+	struct ll_stream_consumer** consumers = (struct ll_stream_consumer**)args[2];
+	unsigned int consumers_count = *(unsigned int*)args[3];
+	unsigned long* offsets_list = (unsigned long*)args[4];
+
+	unsigned long* offsets = (unsigned long*)in_offsets;
+	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
+	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
+	unsigned long* ul_in_edges = (unsigned long*)in_edges;
+
+	// Keeping the graph
+	if(graph_edges != NULL)
+		for(unsigned long e = 0; e < ec; e++)
+			graph_edges[dest_off + e] = (unsigned int)ul_in_edges[e];
+
+	// Passing the block to the consumers
+	struct ll_edge_block leb = {eb->start_vertex, dest_off, ec, offsets_list, ul_in_edges};
+	for(unsigned int c = 0; c < consumers_count; c++)
+		consumers[c]->block(consumers[c], &leb);
+
+	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
+
+	__atomic_add_fetch(completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+
+	return;
+}
+
+/*
+	Reads a WebGraph with 4 Bytes IDs (similar to `get_ll_400_webgraph()`) and passes its edge blocks
+	to the `consumers` as soon as they are decompressed. The copy in /dev/shm is not used.
+
+	flags:
+		bit 0: keep the graph, i.e., write the edges to a NUMA-interleaved graph and return it. The graph should be
+			released by `release_numa_interleaved_ll_400_graph()`. Otherwise, NULL is returned.
+*/
+struct ll_400_graph* stream_ll_400_webgraph(char* file_name, char* type, struct ll_stream_consumer** consumers, unsigned int consumers_count, unsigned int flags)
+{
+	// Opening the graph
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;35mstream_ll_400_webgraph\033[0;37m with \033[3;35m%u\033[0;37m consumers.\n", consumers_count);
+		assert(consumers != NULL || consumers_count == 0);
+
+		int ret = paragrapher_init();
+		assert(ret == 0);
+
+		paragrapher_graph_type pgt;
+		if(!strcmp(type, "PARAGRAPHER_CSX_WG_400_AP") || !strcmp(type, "PARAGRAPHER_CSX_WG_800_AP"))
+			pgt = PARAGRAPHER_CSX_WG_800_AP;
+		else
+		{
+			assert(0 && "stream_ll_400_webgraph does not work for this type of graph.");
+			return NULL;
+		}
+		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, NULL, 0);
+		assert(graph != NULL);
+
+		unsigned long vertices_count = 0;
+		unsigned long edges_count = 0;
+		{
+			void* op_args []= {&vertices_count, &edges_count};
+
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_VERTICES_COUNT, op_args, 1);
+			assert (ret == 0);
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_EDGES_COUNT, op_args + 1, 1);
+			assert (ret == 0);
+			printf("Vertices: %'lu\n",vertices_count);
+			printf("Edges: %'lu\n",edges_count);
+
+			if(vertices_count >= (1UL << 32))
+			{
+				assert(0 && "stream_ll_400_webgraph() supports reading webgraphs with 4 Bytes ID per vertex.\n");
+				return NULL;
+			}
+		}
+
+	// Allocating memory and reading offsets
+		struct ll_400_graph* g = NULL;
+		unsigned long* offsets_list = NULL;
+		{
+			unsigned long* offsets = (unsigned long*)paragrapher_csx_get_offsets(graph, NULL, 0, -1UL, NULL, 0);
+			assert(offsets != NULL);
+
+			offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + vertices_count));
+			assert(offsets_list != NULL);
+			#pragma omp parallel for
+			for(unsigned long v = 0; v <= vertices_count; v++)
+				offsets_list[v] = offsets[v];
+
+			paragrapher_csx_release_offsets_weights_arrays(graph, offsets);
+			offsets = NULL;
+
+			if(flags & 1U)
+			{
+				g = calloc(sizeof(struct ll_400_graph), 1);
+				assert(g != NULL);
+				g->vertices_count = vertices_count;
+				g->edges_count = edges_count;
+				g->offsets_list = offsets_list;
+				g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * max(edges_count, 1UL));
+				assert(g->edges_list != NULL);
+			}
+		}
+
+	// Initializing consumers
+		for(unsigned int c = 0; c < consumers_count; c++)
+			consumers[c]->init(consumers[c], vertices_count, edges_count, offsets_list);
+
+	// Reading and consuming edges
+		unsigned long rt = - get_nano_time();
+		{
+			unsigned long completed_callbacks_count = 0;
+			void* callback_args[] = {(void*)&completed_callbacks_count, g == NULL ? NULL : (void*)g->edges_list, (void*)consumers,
+				(void*)&consumers_count, (void*)offsets_list};
+			paragrapher_edge_block eb;
+			eb.start_vertex = 0;
+			eb.start_edge=0;
+			eb.end_vertex = -1UL;
+			eb.end_edge= -1UL;
+
+			paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_400_stream_callback, (void*)callback_args, NULL, 0);
+			assert(req != NULL);
+
+			struct timespec ts = {0, 50 * 1000 * 1000};
+			long status = 0;
+			unsigned long read_edges = 0;
+			unsigned long callbacks_count = 0;
+			void* op0_args []= {req, &status};
+			void* op1_args []= {req, &read_edges};
+			void* op2_args []= {req, &callbacks_count};
+			unsigned long next_edge_limit_print = 0;
+			do
+			{
+				nanosleep(&ts, NULL);
+
+				ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
+				assert (ret == 0);
+				ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_EDGES, op1_args, 2);
+				assert (ret == 0);
+				if(callbacks_count == 0)
+				{
+					ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_TOTAL_CALLBACKS, op2_args, 2);
+					assert (ret == 0);
+				}
+
+				if(read_edges >= next_edge_limit_print)
+				{
+					printf("  Streaming ..., status: %'ld, read_edges: %'15lu (%.1f%%), completed callbacks: %'lu/%'lu .\n", status, read_edges, 100.0 *read_edges/max(edges_count, 1UL), completed_callbacks_count, callbacks_count);
+
+					next_edge_limit_print = read_edges + 0.05 * edges_count;
+				}
+			}
+			while(status == 0);
+
+			// Waiting for all buffers to be consumed
+			while(__atomic_load_n(&completed_callbacks_count, __ATOMIC_SEQ_CST) < callbacks_count)
+				nanosleep(&ts, NULL);
+
+			paragrapher_csx_release_read_request(req);
+			req = NULL;
+		}
+		rt += get_nano_time();
+
+	// Releasing the paragrapher graph
+		ret = paragrapher_release_graph(graph, NULL, 0);
+		assert(ret == 0);
+		graph = NULL;
+
+	// Finalizing consumers
+		unsigned long ft = - get_nano_time();
+		for(unsigned int c = 0; c < consumers_count; c++)
+			consumers[c]->finalize(consumers[c]);
+		ft += get_nano_time();
+
+	// Releasing memory
+		if(g == NULL)
+		{
+			numa_free(offsets_list, sizeof(unsigned long) * (1 + vertices_count));
+			offsets_list = NULL;
+		}
+		else
+			print_ll_400_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	t0 += get_nano_time();
+	printf("Reading and consuming blocks: \t %'.3f (s)\n", rt/1e9);
+	printf("Finalizing consumers: \t\t %'.3f (s)\n", ft/1e9);
+	printf("Total time: \t\t\t %'.3f (s)\n\n", t0/1e9);
+
+	return g;
+}
+
+/*
+	Streaming degree histogram
+
+	In-degrees of vertices are counted by atomic increments as the blocks arrive and out-degrees are
+	calculated from the offsets_list. After finalize(), `in_degrees_histogram[i]` and `out_degrees_histogram[i]`
+	are the number of vertices with a degree in [2^(i-1), 2^i), and [0] is the number of zero-degree vertices.
+*/
+struct ll_stream_degrees
+{
+	struct ll_stream_consumer consumer;
+	unsigned long vertices_count;
+	unsigned int* in_degrees;
+	unsigned long* offsets_list;
+	unsigned long max_in_degree;
+	unsigned long max_out_degree;
+	unsigned long in_degrees_histogram[65];
+	unsigned long out_degrees_histogram[65];
+};
+
+unsigned int __ll_degree_bin(unsigned long degree)
+{
+	if(degree == 0)
+		return 0;
+
+	return 64 - __builtin_clzl(degree);
+}
+
+void __ll_stream_degrees_init(struct ll_stream_consumer* sc, unsigned long vertices_count, unsigned long edges_count, unsigned long* offsets_list)
+{
+	struct ll_stream_degrees* sd = (struct ll_stream_degrees*)sc;
+	sd->vertices_count = vertices_count;
+	sd->offsets_list = offsets_list;
+	sd->in_degrees = numa_alloc_interleaved(sizeof(unsigned int) * max(vertices_count, 1UL));
+	assert(sd->in_degrees != NULL);
+
+	#pragma omp parallel for
+	for(unsigned long v = 0; v < vertices_count; v++)
+		sd->in_degrees[v] = 0;
+
+	return;
+}
+
+void __ll_stream_degrees_block(struct ll_stream_consumer* sc, struct ll_edge_block* eb)
+{
+	struct ll_stream_degrees* sd = (struct ll_stream_degrees*)sc;
+
+	for(unsigned long e = 0; e < eb->edges_count; e++)
+		__atomic_add_fetch(&sd->in_degrees[eb->edges[e]], 1U, __ATOMIC_RELAXED);
+
+	return;
+}
+
+void __ll_stream_degrees_finalize(struct ll_stream_consumer* sc)
+{
+	struct ll_stream_degrees* sd = (struct ll_stream_degrees*)sc;
+
+	#pragma omp parallel
+	{
+		unsigned long in_histogram[65] = {0};
+		unsigned long out_histogram[65] = {0};
+		unsigned long max_in = 0;
+		unsigned long max_out = 0;
+
+		#pragma omp for nowait
+		for(unsigned long v = 0; v < sd->vertices_count; v++)
+		{
+			unsigned long in_degree = sd->in_degrees[v];
+			unsigned long out_degree = sd->offsets_list[v + 1] - sd->offsets_list[v];
+			in_histogram[__ll_degree_bin(in_degree)]++;
+			out_histogram[__ll_degree_bin(out_degree)]++;
+			if(in_degree > max_in)
+				max_in = in_degree;
+			if(out_degree > max_out)
+				max_out = out_degree;
+		}
+
+		for(unsigned int i = 0; i < 65; i++)
+		{
+			if(in_histogram[i])
+				__atomic_add_fetch(&sd->in_degrees_histogram[i], in_histogram[i], __ATOMIC_RELAXED);
+			if(out_histogram[i])
+				__atomic_add_fetch(&sd->out_degrees_histogram[i], out_histogram[i], __ATOMIC_RELAXED);
+		}
+
+		#pragma omp critical
+		{
+			if(max_in > sd->max_in_degree)
+				sd->max_in_degree = max_in;
+			if(max_out > sd->max_out_degree)
+				sd->max_out_degree = max_out;
+		}
+	}
+
+	// The offsets_list belongs to the stream
+	sd->offsets_list = NULL;
+
+	return;
+}
+
+struct ll_stream_degrees* stream_degrees_initialize()
+{
+	struct ll_stream_degrees* sd = calloc(sizeof(struct ll_stream_degrees), 1);
+	assert(sd != NULL);
+	sd->consumer.init = __ll_stream_degrees_init;
+	sd->consumer.block = __ll_stream_degrees_block;
+	sd->consumer.finalize = __ll_stream_degrees_finalize;
+
+	return sd;
+}
+
+void stream_degrees_print(struct ll_stream_degrees* sd)
+{
+	assert(sd != NULL);
+
+	printf("Max. in-degree: %'lu, max. out-degree: %'lu\n", sd->max_in_degree, sd->max_out_degree);
+	printf("%-24s %16s %16s\n", "Degree", "In-degree", "Out-degree");
+	for(unsigned int i = 0; i < 65; i++)
+	{
+		if(sd->in_degrees_histogram[i] == 0 && sd->out_degrees_histogram[i] == 0)
+			continue;
+
+		char temp[64];
+		if(i == 0)
+			sprintf(temp, "0");
+		else
+			sprintf(temp, "[%'lu, %'lu)", 1UL << (i - 1), i == 64 ? -1UL : 1UL << i);
+		printf("%-24s %'16lu %'16lu\n", temp, sd->in_degrees_histogram[i], sd->out_degrees_histogram[i]);
+	}
+	printf("\n");
+
+	return;
+}
+
+void stream_degrees_release(struct ll_stream_degrees* sd)
+{
+	assert(sd != NULL);
+
+	if(sd->in_degrees != NULL)
+	{
+		numa_free(sd->in_degrees, sizeof(unsigned int) * max(sd->vertices_count, 1UL));
+		sd->in_degrees = NULL;
+	}
+
+	free(sd);
+	sd = NULL;
+
+	return;
+}
+
+/*
+	Streaming union-find Connected Components
+
+	Edges are processed as the blocks arrive using the concurrent disjoint-set union of `cc_jt()`, i.e.,
+	the root with the larger ID is linked to the root with the smaller ID by CAS. As the union of an edge
+	is symmetric, the input graph does not need to be symmetrized and the weakly connected components
+	are identified. After finalize(), `cc[v]` is the minimum vertex ID of the component of `v`
+	(similar to `cc_pull()`) and `ccs` is the number of components.
+*/
+struct ll_stream_cc
+{
+	struct ll_stream_consumer consumer;
+	unsigned long vertices_count;
+	unsigned int* cc;
+	unsigned long ccs;
+};
+
+void __ll_stream_cc_init(struct ll_stream_consumer* sc, unsigned long vertices_count, unsigned long edges_count, unsigned long* offsets_list)
+{
+	struct ll_stream_cc* scc = (struct ll_stream_cc*)sc;
+	scc->vertices_count = vertices_count;
+	scc->cc = numa_alloc_interleaved(sizeof(unsigned int) * max(vertices_count, 1UL));
+	assert(scc->cc != NULL);
+
+	#pragma omp parallel for
+	for(unsigned long v = 0; v < vertices_count; v++)
+		scc->cc[v] = v;
+
+	return;
+}
+
+void __ll_stream_cc_block(struct ll_stream_consumer* sc, struct ll_edge_block* eb)
+{
+	struct ll_stream_cc* scc = (struct ll_stream_cc*)sc;
+	unsigned int* cc = scc->cc;
+
+	unsigned long v = eb->start_vertex;
+	for(unsigned long i = 0; i < eb->edges_count; i++)
+	{
+		unsigned long e = eb->start_edge + i;
+		while(eb->offsets_list[v + 1] <= e)
+			v++;
+
+		unsigned int x = v;
+		unsigned int y = eb->edges[i];
+		if(x == y)
+			continue;
+
+		while(1)
+		{
+			while(x != cc[x])
+				x = cc[x];
+
+			while(y != cc[y])
+				y = cc[y];
+
+			if(x == y)
+				break;
+
+			if(x < y)
+			{
+				if(__sync_bool_compare_and_swap(&cc[y], y, x))
+					break;
+			}
+			else
+			{
+				if(__sync_bool_compare_and_swap(&cc[x], x, y))
+					break;
+			}
+		}
+	}
+
+	return;
+}
+
+void __ll_stream_cc_finalize(struct ll_stream_consumer* sc)
+{
+	struct ll_stream_cc* scc = (struct ll_stream_cc*)sc;
+	unsigned int* cc = scc->cc;
+
+	// Pointer jumping
+	#pragma omp parallel for
+	for(unsigned long v = 0; v < scc->vertices_count; v++)
+		while(cc[cc[v]] != cc[v])
+			cc[v] = cc[cc[v]];
+
+	// Counting components
+	unsigned long ccs = 0;
+	#pragma omp parallel for reduction(+:ccs)
+	for(unsigned long v = 0; v < scc->vertices_count; v++)
+		if(cc[v] == v)
+			ccs++;
+	scc->ccs = ccs;
+	printf("|CCs| (streaming): \t\t%'lu\n", ccs);
+
+	return;
+}
+
+struct ll_stream_cc* stream_cc_initialize()
+{
+	struct ll_stream_cc* scc = calloc(sizeof(struct ll_stream_cc), 1);
+	assert(scc != NULL);
+	scc->consumer.init = __ll_stream_cc_init;
+	scc->consumer.block = __ll_stream_cc_block;
+	scc->consumer.finalize = __ll_stream_cc_finalize;
+
+	return scc;
+}
+
+void stream_cc_release(struct ll_stream_cc* scc)
+{
+	assert(scc != NULL);
+
+	if(scc->cc != NULL)
+	{
+		numa_free(scc->cc, sizeof(unsigned int) * max(scc->vertices_count, 1UL));
+		scc->cc = NULL;
+	}
+
+	free(scc);
+	scc = NULL;
+
+	return;
+}
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef __TRACE_C
+#define __TRACE_C
+
+/*
+	Trace sink: records each step printed by PTIP (and PT) as a structured event in `LL_TRACE_PATH`
+	in the format selected by `LL_TRACE_FORMAT`:
+		json (default): a JSON object in each line, appended to the file
+		csv: a line for each step, appended to the file (the header is written to an empty file)
+		chrome: the Trace Event Format of Chrome (chrome://tracing) and Perfetto (ui.perfetto.dev), the file is overwritten.
+			Each step is a complete event on the "Steps" track and the busy time of each thread (`ttimes[t]`) is
+			an event on the track of the thread.
+
+	An event contains the graph (LL_INPUT_GRAPH_BASE_NAME), the algorithm (the function that has called PTIP),
+	the step name, the iteration (the number of previous events of the same algorithm and step), the start time
+	relative to the start of the first step (us), the wall time of the step (`mt`, ns), the idle percentage, the `ttimes[]` vector (ns),
+	and the changes of `pe->hw_events` since the previous event. With `LL_STEP_HW_EVENTS=1`, the hw events of each thread
+	in the step (`pe->step_hw_deltas`, see step_hw_events_collect() in omp.c) are also recorded.
+	PT steps have no `ttimes[]`, idle percentage, and hw events.
+*/
+
+#define LL_TRACE_JSON   0U
+#define LL_TRACE_CSV    1U
+#define LL_TRACE_CHROME 2U
+
+#define __TRACE_MAX_STEPS 4096
+
+struct trace_sink
+{
+	FILE* file;
+	unsigned int format;
+	unsigned long start_time;
+	unsigned long events_count;
+	unsigned int named_threads;  // the threads that have a track in the chrome format
+
+	// The last values of pe->hw_events
+	unsigned long hw_events[32];
+
+	// Counting the events of each (algorithm, step)
+	unsigned int steps_count;
+	const char* steps_algorithms[__TRACE_MAX_STEPS];
+	char* steps_names[__TRACE_MAX_STEPS];
+	unsigned int steps_iterations[__TRACE_MAX_STEPS];
+};
+
+struct trace_sink* trace = NULL;
+unsigned int trace_disabled = 0;
+
+void trace_close()
+{
+	if(trace == NULL)
+		return;
+
+	if(trace->format == LL_TRACE_CHROME)
+		fprintf(trace->file, "\n]\n");
+	fclose(trace->file);
+	trace->file = NULL;
+
+	for(unsigned int s = 0; s < trace->steps_count; s++)
+	{
+		free(trace->steps_names[s]);
+		trace->steps_names[s] = NULL;
+	}
+
+	free(trace);
+	trace = NULL;
+
+	return;
+}
+
+// Writes `str` as a JSON string, or as a CSV field if `csv` is 1
+void __trace_write_string(FILE* file, const char* str, unsigned int csv)
+{
+	fputc('"', file);
+	for(const char* c = str; *c != 0; c++)
+	{
+		if(*c == '"')
+			fputs(csv ? "\"\"" : "\\\"", file);
+		else if(csv)
+			fputc(*c, file);
+		else if(*c == '\\')
+			fputs("\\\\", file);
+		else if((unsigned char)*c < 0x20)
+			fprintf(file, "\\u%04x", (unsigned char)*c);
+		else
+			fputc(*c, file);
+	}
+	fputc('"', file);
+
+	return;
+}
+
+/*
+	Opens the trace file on the first event, returns NULL if `LL_TRACE_PATH` is not set.
+*/
+struct trace_sink* __trace_open()
+{
+	if(trace != NULL || trace_disabled)
+		return trace;
+
+	if(LL_TRACE_PATH == NULL)
+	{
+		trace_disabled = 1;
+		return NULL;
+	}
+
+	unsigned int format = LL_TRACE_JSON;
+	if(LL_TRACE_FORMAT != NULL && !strcmp(LL_TRACE_FORMAT, "csv"))
+		format = LL_TRACE_CSV;
+	else if(LL_TRACE_FORMAT != NULL && !strcmp(LL_TRACE_FORMAT, "chrome"))
+		format = LL_TRACE_CHROME;
+
+	FILE* file = fopen(LL_TRACE_PATH, format == LL_TRACE_CHROME ? "w" : "a");
+	if(file == NULL)
+	{
+		printf("Cannot open the trace file %s, errno: %d, %s\n", LL_TRACE_PATH, errno, strerror(errno));
+		trace_disabled = 1;
+		return NULL;
+	}
+
+	trace = calloc(sizeof(struct trace_sink), 1);
+	assert(trace != NULL);
+	trace->file = file;
+	trace->format = format;
+
+	if(format == LL_TRACE_CSV && ftell(file) == 0)
+		fprintf(file, "graph,pid,algorithm,step,iteration,start_us,time_ns,idle_percentage,ttimes_ns,hw_events,threads_hw_events\n");
+	if(format == LL_TRACE_CHROME)
+	{
+		fprintf(file, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":", getpid());
+		__trace_write_string(file, LL_INPUT_GRAPH_BASE_NAME, 0);
+		fprintf(file, "}}");
+	}
+
+	atexit(trace_close);
+
+	return trace;
+}
+
+unsigned int __trace_get_iteration(const char* algorithm, char* step_name)
+{
+	for(unsigned int s = 0; s < trace->steps_count; s++)
+		if(trace->steps_algorithms[s] == algorithm && !strcmp(trace->steps_names[s], step_name))
+			return trace->steps_iterations[s]++;
+
+	if(trace->steps_count < __TRACE_MAX_STEPS)
+	{
+		trace->steps_algorithms[trace->steps_count] = algorithm;
+		trace->steps_names[trace->steps_count] = strdup(step_name);
+		assert(trace->steps_names[trace->steps_count] != NULL);
+		trace->steps_iterations[trace->steps_count] = 1;
+		trace->steps_count++;
+	}
+
+	return 0;
+}
+
+/*
+	Records a step, called by PTIP and PT (with `ttimes` and `pe` set to NULL) after `mt` is measured.
+	`algorithm` is the `__func__` of the caller.
+*/
+void trace_step(const char* algorithm, char* step_name, unsigned long mt, unsigned long* ttimes, struct par_env* pe)
+{
+	if(trace == NULL && __trace_open() == NULL)
+		return;
+
+	FILE* f = trace->file;
+	if(trace->events_count == 0)
+		trace->start_time = get_nano_time() - mt;
+	unsigned int iteration = __trace_get_iteration(algorithm, step_name);
+	double start = (get_nano_time() - mt - trace->start_time) / 1e3;
+	unsigned int threads_count = ttimes != NULL && pe != NULL ? pe->threads_count : 0;
+	double idle = threads_count ? get_idle_percentage(mt, ttimes, threads_count) : 0;
+	unsigned int hw_events_count = pe != NULL ? pe->hw_events_count : 0;
+	unsigned long* threads_hw = threads_count && pe->step_hw_deltas != NULL ? pe->step_hw_deltas : NULL;
+
+	// The changes of hw events, that are accumulated by thread_papi_read() and may be reset by copy_reset_hw_events()
+	unsigned long hw_deltas[32] = {0};
+	for(unsigned int e = 0; e < hw_events_count; e++)
+	{
+		hw_deltas[e] = pe->hw_events[e] >= trace->hw_events[e] ? pe->hw_events[e] - trace->hw_events[e] : pe->hw_events[e];
+		trace->hw_events[e] = pe->hw_events[e];
+	}
+
+	if(trace->format == LL_TRACE_JSON)
+	{
+		fprintf(f, "{\"graph\":");
+		__trace_write_string(f, LL_INPUT_GRAPH_BASE_NAME, 0);
+		fprintf(f, ",\"pid\":%d,\"algorithm\":\"%s\",\"step\":", getpid(), algorithm);
+		__trace_write_string(f, step_name, 0);
+		fprintf(f, ",\"iteration\":%u,\"start_us\":%.3f,\"time_ns\":%lu", iteration, start, mt);
+		if(threads_count)
+		{
+			fprintf(f, ",\"idle_percentage\":%.2f,\"ttimes_ns\":[", idle);
+			for(unsigned int t = 0; t < threads_count; t++)
+				fprintf(f, "%s%lu", t ? "," : "", ttimes[t]);
+			fprintf(f, "]");
+		}
+		fprintf(f, ",\"hw_events\":{");
+		for(unsigned int e = 0; e < hw_events_count; e++)
+			fprintf(f, "%s\"%s\":%lu", e ? "," : "", pe->hw_events_names[e], hw_deltas[e]);
+		fprintf(f, "}");
+		if(threads_hw != NULL)
+		{
+			fprintf(f, ",\"threads_hw_events\":{");
+			for(unsigned int e = 0; e < hw_events_count; e++)
+			{
+				fprintf(f, "%s\"%s\":[", e ? "," : "", pe->hw_events_names[e]);
+				for(unsigned int t = 0; t < threads_count; t++)
+					fprintf(f, "%s%lu", t ? "," : "", threads_hw[32 * t + e]);
+				fprintf(f, "]");
+			}
+			fprintf(f, "}");
+		}
+		fprintf(f, "}\n");
+	}
+
+	if(trace->format == LL_TRACE_CSV)
+	{
+		__trace_write_string(f, LL_INPUT_GRAPH_BASE_NAME, 1);
+		fprintf(f, ",%d,%s,", getpid(), algorithm);
+		__trace_write_string(f, step_name, 1);
+		fprintf(f, ",%u,%.3f,%lu,%.2f,\"", iteration, start, mt, idle);
+		for(unsigned int t = 0; t < threads_count; t++)
+			fprintf(f, "%s%lu", t ? " " : "", ttimes[t]);
+		fprintf(f, "\",\"");
+		for(unsigned int e = 0; e < hw_events_count; e++)
+			fprintf(f, "%s%s=%lu", e ? " " : "", pe->hw_events_names[e], hw_deltas[e]);
+		fprintf(f, "\",\"");
+		// The values of threads for each event, e.g., "L3_TCM=1:2:3 TOT_INS=4:5:6"
+		for(unsigned int e = 0; threads_hw != NULL && e < hw_events_count; e++)
+		{
+			fprintf(f, "%s%s=", e ? " " : "", pe->hw_events_names[e]);
+			for(unsigned int t = 0; t < threads_count; t++)
+				fprintf(f, "%s%lu", t ? ":" : "", threads_hw[32 * t + e]);
+		}
+		fprintf(f, "\"\n");
+	}
+
+	if(trace->format == LL_TRACE_CHROME)
+	{
+		// The "Steps" track has the ID 0 and thread `t` is on track `t + 1`
+		if(trace->events_count == 0)
+			fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"Steps\"}}", getpid());
+
+		fprintf(f, ",\n{\"name\":");
+		__trace_write_string(f, step_name, 0);
+		fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":0,\"args\":{\"iteration\":%u",
+			algorithm, start, mt / 1e3, getpid(), iteration);
+		if(threads_count)
+			fprintf(f, ",\"idle_percentage\":%.2f", idle);
+		for(unsigned int e = 0; e < hw_events_count; e++)
+			fprintf(f, ",\"%s\":%lu", pe->hw_events_names[e], hw_deltas[e]);
+		fprintf(f, "}}");
+
+		for(unsigned int t = 0; t < threads_count; t++)
+		{
+			if(t >= trace->named_threads)
+			{
+				fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", getpid(), t + 1, t);
+				trace->named_threads = t + 1;
+			}
+			fprintf(f, ",\n{\"name\":");
+			__trace_write_string(f, step_name, 0);
+			fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,\"args\":{", algorithm, start, ttimes[t] / 1e3, getpid(), t + 1);
+			for(unsigned int e = 0; threads_hw != NULL && e < hw_events_count; e++)
+				fprintf(f, "%s\"%s\":%lu", e ? "," : "", pe->hw_events_names[e], threads_hw[32 * t + e]);
+			fprintf(f, "}}");
+		}
+	}
+
+	trace->events_count++;
+
+	return;
+}
+
+#endif